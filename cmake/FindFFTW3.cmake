@@ -0,0 +1,40 @@
+# Finds upstream FFTW3 (double precision), and its OpenMP or pthreads
+# threading library when present.
+#
+# Defines:
+#   FFTW3_FOUND, FFTW3_THREADS_FOUND
+#   FFTW3::fftw3   - the serial library
+#   FFTW3::threads - the threading library (linking FFTW3::fftw3), if found
+#
+# Set FFTW3_ROOT to search a non-standard prefix.
+
+find_path(FFTW3_INCLUDE_DIR fftw3.h)
+find_library(FFTW3_LIBRARY NAMES fftw3)
+
+#The OpenMP build shares its thread pool with the kernels, so is preferred
+find_library(FFTW3_THREADS_LIBRARY NAMES fftw3_omp fftw3_threads)
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(FFTW3 REQUIRED_VARS FFTW3_LIBRARY FFTW3_INCLUDE_DIR)
+
+mark_as_advanced(FFTW3_INCLUDE_DIR FFTW3_LIBRARY FFTW3_THREADS_LIBRARY)
+
+if(FFTW3_FOUND AND NOT TARGET FFTW3::fftw3)
+    add_library(FFTW3::fftw3 UNKNOWN IMPORTED)
+    set_target_properties(FFTW3::fftw3 PROPERTIES
+        IMPORTED_LOCATION "${FFTW3_LIBRARY}"
+        INTERFACE_INCLUDE_DIRECTORIES "${FFTW3_INCLUDE_DIR}")
+endif()
+
+if(FFTW3_FOUND AND FFTW3_THREADS_LIBRARY)
+    set(FFTW3_THREADS_FOUND TRUE)
+
+    if(NOT TARGET FFTW3::threads)
+        add_library(FFTW3::threads UNKNOWN IMPORTED)
+        set_target_properties(FFTW3::threads PROPERTIES
+            IMPORTED_LOCATION "${FFTW3_THREADS_LIBRARY}"
+            INTERFACE_LINK_LIBRARIES FFTW3::fftw3)
+    endif()
+else()
+    set(FFTW3_THREADS_FOUND FALSE)
+endif()
@@ -1,30 +1,126 @@
 #ifndef LLPS_ALIGNED_ALLOCATOR_HPP_INCLUDED
 #define LLPS_ALIGNED_ALLOCATOR_HPP_INCLUDED
 
-#include <memory>
+#include <memory>  //Access to std::allocator_traits
+#include <new>     //Access to std::align_val_t
+#include <cstddef> //Access to size_t
+#include <bit>     //Access to std::has_single_bit
 
-#ifdef LLPS_USE_MKL
+#include "execution.hpp"
 
-#include "fftw/fftw3.h"
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif // __linux__
 
 namespace llps {
 
-    template<class Type>
-    struct fftw_allocator : public std::allocator<Type>
+#ifdef LLPS_USE_HUGE_PAGES
+    inline constexpr bool _huge_pages_default = true;
+#else
+    inline constexpr bool _huge_pages_default = false;
+#endif // LLPS_USE_HUGE_PAGES
+
+    //Transparent huge page size on x86-64 and most aarch64 kernels
+    inline constexpr size_t huge_page_size = size_t(2) << 20;
+
+    /*
+    * Allocator returning memory aligned to Align bytes (a cache line by
+    * default), enough for the widest SIMD loads and for the FFT backends'
+    * plans.
+    *
+    * With HugePages, allocations of at least huge_page_size are rounded up to
+    * and aligned on whole huge pages, and advised (madvise(MADV_HUGEPAGE)) to
+    * be backed by them. Large grids then need far fewer TLB entries. This only
+    * takes effect on Linux with transparent huge pages set to "madvise" or
+    * "always".
+    *
+    * With FirstTouch, large allocations are first touched by the OpenMP
+    * threads (see first_touch) before the container initialises them on its
+    * own thread, so their pages are spread over the NUMA nodes the way the
+    * kernels will read them. Opt-in, as it costs a parallel region per
+    * allocation: only worth it for long-lived grids, which the drivers get
+    * from a grid_arena instead.
+    */
+    template<class Type, size_t Align = 64, bool HugePages = _huge_pages_default, bool FirstTouch = false>
+    struct aligned_allocator
     {
+    public:
+        static_assert(std::has_single_bit(Align), "Align must be a power of two!");
+        static_assert(Align >= alignof(Type), "Align must not weaken the alignment of Type!");
+
+        using value_type = Type;
+
+        template<class Other>
+        struct rebind { using other = aligned_allocator<Other, Align, HugePages, FirstTouch>; };
+
+    public:
+        aligned_allocator() = default;
+
+        template<class Other>
+        aligned_allocator(const aligned_allocator<Other, Align, HugePages, FirstTouch>&) noexcept {}
+
     public:
         Type* allocate(size_t n)
         {
-            return static_cast<Type*>(fftw_malloc(sizeof(Type) * n));
+            const size_t bytes = sizeof(Type) * n;
+
+            if (_use_huge_pages(bytes)) {
+                const size_t padded_bytes = _round_to_huge_pages(bytes);
+                void* data = ::operator new(padded_bytes, std::align_val_t{ huge_page_size });
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+                //Only advice, the allocation stands whether or not it is taken
+                madvise(data, padded_bytes, MADV_HUGEPAGE);
+#endif // __linux__ && MADV_HUGEPAGE
+
+                if constexpr (FirstTouch)
+                    first_touch(data, padded_bytes, huge_page_size);
+
+                return static_cast<Type*>(data);
+            }
+
+            void* data = ::operator new(bytes, std::align_val_t{ Align });
+
+            if constexpr (FirstTouch)
+                first_touch(data, bytes);
+
+            return static_cast<Type*>(data);
+        }
+
+        void deallocate(Type* data, size_t n)
+        {
+            const size_t bytes = sizeof(Type) * n;
+
+            if (_use_huge_pages(bytes))
+                ::operator delete(static_cast<void*>(data), std::align_val_t{ huge_page_size });
+            else
+                ::operator delete(static_cast<void*>(data), std::align_val_t{ Align });
         }
-        void deallocate(Type* type, size_t n)
+
+        //Granularity at which an allocation of the given size is placed on NUMA nodes
+        static constexpr size_t placement_page_size(size_t bytes) noexcept
         {
-            fftw_free(type);
+            return _use_huge_pages(bytes) ? huge_page_size : page_size;
+        }
+
+    private:
+        static constexpr bool _use_huge_pages(size_t bytes) noexcept
+        {
+            return HugePages && bytes >= huge_page_size;
+        }
+
+        static constexpr size_t _round_to_huge_pages(size_t bytes) noexcept
+        {
+            return (bytes + huge_page_size - 1) / huge_page_size * huge_page_size;
         }
     };
 
-}
+    template<class Type1, class Type2, size_t Align, bool HugePages, bool FirstTouch>
+    constexpr bool operator==(const aligned_allocator<Type1, Align, HugePages, FirstTouch>&, const aligned_allocator<Type2, Align, HugePages, FirstTouch>&) noexcept
+    {
+        return true;
+    }
 
-#endif // LLPS_USE_MKL
+}
 
-#endif // !LLPS_ALIGNED_ALLOCATOR_HPP_INCLUDED
\ No newline at end of file
+#endif // !LLPS_ALIGNED_ALLOCATOR_HPP_INCLUDED
@@ -0,0 +1,230 @@
+#ifndef LLPS_BOUNDARY_HPP_INCLUDED
+#define LLPS_BOUNDARY_HPP_INCLUDED
+
+#include <vector>      //Access to std::vector
+#include <cstddef>     //Access to size_t and ptrdiff_t
+#include <type_traits> //Access to std::is_same_v, std::conditional_t and std::false_type
+
+#include "aligned_allocator.hpp"
+#include "grid.hpp"
+
+namespace llps {
+
+    /*
+    * Two dimensional grid of rows x cols points surrounded by halo ghost
+    * cells on every side, stored row major as one (rows + 2 halo) x
+    * (cols + 2 halo) block.
+    *
+    * (row, col) addresses the interior, so it is grid_like as any grid, with
+    * contiguous rows; at(row, col) also reaches the ghost cells, from -halo
+    * to rows + halo - 1 (cols + halo - 1). Stencils reading a padded grid
+    * need no wrapping, their boundary handled by a boundary_conditions
+    * filling the ghost cells beforehand.
+    */
+    template<
+        class Type,
+        size_t _rows,
+        size_t _cols,
+        size_t _halo,
+        class Container = std::vector<Type, _grid_default_alloc<Type>>>
+    class padded_grid
+    {
+    public:
+        using value_type      = typename Container::value_type;
+        using reference       = typename Container::reference;
+        using const_reference = typename Container::const_reference;
+        using size_type       = size_t;
+
+        static_assert(std::is_same_v<Type, value_type>, "Container type mismatch!");
+
+    public:
+        static consteval size_t size() noexcept { return _rows * _cols; }
+        static consteval size_t rows() noexcept { return _rows; }
+        static consteval size_t cols() noexcept { return _cols; }
+        static consteval size_t halo() noexcept { return _halo; }
+
+        //Distance between rows, in points
+        static consteval size_t stride() noexcept { return _cols + 2 * _halo; }
+
+    public:
+        padded_grid() :
+            _underlying((_rows + 2 * _halo) * stride()) {}
+
+    public:
+        LLPS_FORCE_INLINE const_reference operator()(size_type row, size_type col) const
+        {
+            return _underlying[(row + _halo) * stride() + col + _halo];
+        }
+
+        LLPS_FORCE_INLINE reference operator()(size_type row, size_type col)
+        {
+            return _underlying[(row + _halo) * stride() + col + _halo];
+        }
+
+        //Any point, ghost cells included
+        LLPS_FORCE_INLINE const_reference at(ptrdiff_t row, ptrdiff_t col) const
+        {
+            return _underlying[(row + static_cast<ptrdiff_t>(_halo)) * stride() + col + _halo];
+        }
+
+        LLPS_FORCE_INLINE reference at(ptrdiff_t row, ptrdiff_t col)
+        {
+            return _underlying[(row + static_cast<ptrdiff_t>(_halo)) * stride() + col + _halo];
+        }
+
+    public:
+        //Whole block, ghost cells included
+        value_type*       data()       { return _underlying.data(); }
+        const value_type* data() const { return _underlying.data(); }
+
+    private:
+        Container _underlying;
+    };
+
+    template<class Type>
+    struct is_padded_grid : std::false_type {};
+
+    template<class Type, size_t _rows, size_t _cols, size_t _halo, class Container>
+    struct is_padded_grid<padded_grid<Type, _rows, _cols, _halo, Container>> : std::true_type {};
+
+    template<class Type>
+    inline constexpr bool is_padded_grid_v = is_padded_grid<Type>::value;
+
+    /*
+    * Boundary condition policies of one side of a grid. Each gives the ghost
+    * cell a distance d beyond the wall from the interior points mirrored
+    * (d - 1 from the wall) and wrapped (d - 1 from the opposite wall) onto
+    * it. The wall lies half a spacing beyond the last interior point.
+    */
+
+    //Wraps around, as the unpadded stencils do; opposite sides must both be periodic
+    struct periodic
+    {
+        template<class Type>
+        LLPS_FORCE_INLINE constexpr Type ghost(Type, Type wrapped) const noexcept { return wrapped; }
+    };
+
+    /*
+    * Neumann, with zero normal derivative at the wall. Even reflection makes
+    * the sum of any central difference laplacian over the interior vanish,
+    * so a field whose flux is such a laplacian keeps its mass exactly.
+    */
+    struct no_flux
+    {
+        template<class Type>
+        LLPS_FORCE_INLINE constexpr Type ghost(Type mirrored, Type) const noexcept { return mirrored; }
+    };
+
+    //Dirichlet, to value at the wall (second order, being odd reflection about it)
+    struct dirichlet
+    {
+        double value = 0.;
+
+        template<class Type>
+        LLPS_FORCE_INLINE constexpr Type ghost(Type mirrored, Type) const noexcept { return static_cast<Type>(2. * value) - mirrored; }
+    };
+
+    //Same wall, letting nothing through: the condition for the chemical potential of a conserved field
+    template<class Policy>
+    struct _conserving { using type = Policy; };
+
+    template<>
+    struct _conserving<dirichlet> { using type = no_flux; };
+
+    template<class Policy>
+    using conserving_t = typename _conserving<Policy>::type;
+
+    /*
+    * Boundary conditions of a 2D grid, one policy per side, chosen at compile
+    * time so that filling the ghost cells has no branches: FirstCol and
+    * LastCol at the walls before column 0 and after column cols - 1,
+    * FirstRow and LastRow at those before row 0 and after row rows - 1.
+    *
+    * Columns are filled first and rows then copy whole padded rows, corners
+    * included, so corners see both conditions. The halo may be at most as
+    * wide as the grid, each ghost cell taking a single reflection.
+    */
+    template<class FirstCol, class LastCol, class FirstRow, class LastRow>
+    class boundary_conditions
+    {
+    public:
+        static_assert(std::is_same_v<FirstCol, periodic> == std::is_same_v<LastCol, periodic>,
+            "opposite sides must both be periodic, or neither");
+        static_assert(std::is_same_v<FirstRow, periodic> == std::is_same_v<LastRow, periodic>,
+            "opposite sides must both be periodic, or neither");
+
+        //Periodic everywhere, where the unpadded stencils already apply
+        static constexpr bool is_periodic = std::is_same_v<FirstCol, periodic> && std::is_same_v<FirstRow, periodic>;
+
+        using conserving_type = boundary_conditions<conserving_t<FirstCol>, conserving_t<LastCol>, conserving_t<FirstRow>, conserving_t<LastRow>>;
+
+    public:
+        constexpr boundary_conditions(FirstCol first_col = {}, LastCol last_col = {}, FirstRow first_row = {}, LastRow last_row = {}) :
+            _first_col(first_col), _last_col(last_col), _first_row(first_row), _last_row(last_row) {}
+
+    public:
+        template<class Type, size_t rows, size_t cols, size_t halo, class Container>
+        void fill_halo(padded_grid<Type, rows, cols, halo, Container>& grid) const
+        {
+            static_assert(halo <= rows && halo <= cols, "halo cannot be wider than the grid");
+
+            static constexpr ptrdiff_t n_rows = rows;
+            static constexpr ptrdiff_t n_cols = cols;
+            static constexpr ptrdiff_t width = halo;
+
+            for (ptrdiff_t row = 0; row < n_rows; ++row) {
+                Type* line = &grid(row, 0);
+
+                for (ptrdiff_t d = 1; d <= width; ++d) {
+                    line[-d] = _first_col.ghost(line[d - 1], line[n_cols - d]);
+                    line[n_cols - 1 + d] = _last_col.ghost(line[n_cols - d], line[d - 1]);
+                }
+            }
+
+            for (ptrdiff_t d = 1; d <= width; ++d) {
+                #pragma omp simd
+                for (ptrdiff_t col = -width; col < n_cols + width; ++col) {
+                    grid.at(-d, col) = _first_row.ghost(grid.at(d - 1, col), grid.at(n_rows - d, col));
+                    grid.at(n_rows - 1 + d, col) = _last_row.ghost(grid.at(n_rows - d, col), grid.at(d - 1, col));
+                }
+            }
+        }
+
+        //Copies phi into the interior of padded, then fills its ghost cells
+        template<grid2D_like InGrid, class Type, size_t rows, size_t cols, size_t halo, class Container>
+        void load(const InGrid& phi, padded_grid<Type, rows, cols, halo, Container>& padded) const
+        {
+            #pragma omp parallel for schedule(static)
+            for (ptrdiff_t row = 0; row < static_cast<ptrdiff_t>(rows); ++row) {
+                const auto* in = &phi(row, 0);
+                Type* out = &padded(row, 0);
+
+                #pragma omp simd
+                for (size_t col = 0; col < cols; ++col)
+                    out[col] = in[col];
+            }
+
+            fill_halo(padded);
+        }
+
+        //The same walls with every Dirichlet side made no flux
+        constexpr conserving_type conserving() const noexcept { return {}; }
+
+    private:
+        FirstCol _first_col;
+        LastCol  _last_col;
+        FirstRow _first_row;
+        LastRow  _last_row;
+    };
+
+    using periodic_boundary = boundary_conditions<periodic, periodic, periodic, periodic>;
+
+    //Walls along the rows, periodic along the columns: a channel
+    using no_flux_channel = boundary_conditions<periodic, periodic, no_flux, no_flux>;
+
+    //Walls all round: a closed box
+    using no_flux_box = boundary_conditions<no_flux, no_flux, no_flux, no_flux>;
+
+}
+
+#endif // !LLPS_BOUNDARY_HPP_INCLUDED
@@ -5,42 +5,195 @@
 #include <array>
 #include <type_traits>
 #include <numbers>
+#include <algorithm> // For access to std::min
+#include <cstddef>   // For access to ptrdiff_t
+#include <cstdlib>   // For access to std::abs
+#include <vector>    // For access to std::vector
+#include <optional>  // For access to std::optional
 
 #include "finite_difference.hpp"
 #include "fourier_spectral.hpp"
+#include "../fft/fft.hpp"
 #include "../grid.hpp"
 
 namespace llps::calculus {
 
-    template<size_t error_order, grid_like InGrid, grid_like OutGrid>
-    LLPS_FORCE_INLINE constexpr void laplacian_central_fd(
-        const InGrid& phi, OutGrid& dphi, 
-        typename OutGrid::value_type dx, 
-        typename OutGrid::value_type dy)
+    /*
+    * Number of columns swept together by the 2D stencil, chosen such that the
+    * error_order + 1 row segments it reaches fit in a typical (32KiB) L1
+    * cache, in whole cache lines.
+    */
+    template<size_t error_order, class Type>
+    consteval size_t _fd2D_block_cols()
     {
-        static constexpr auto stencil = central_fd_stencil<error_order, typename OutGrid::value_type>(2);
-        static constexpr size_t offset = error_order / 2;
+        constexpr size_t cache_size = 32 * 1024;
+        constexpr size_t line = 64 / sizeof(Type);
+        constexpr size_t cols = cache_size / ((error_order + 1) * sizeof(Type));
+
+        return std::max<size_t>(cols / line * line, line);
+    }
+
+    //Rows of a 2D stencil tile, over which its row segments are reused
+    inline constexpr size_t _fd2D_band_rows = 32;
 
-        for (size_t row = 0; row < phi.rows(); ++row)
+    /*
+    * Rows and columns of the tiles of the 2D stencils, as measured best by
+    * llps_autotune. 0 keeps the estimate, _fd2D_band_rows rows or
+    * _fd2D_block_cols columns.
+    */
+    struct fd2D_tile
+    {
+        size_t rows = 0;
+        size_t cols = 0;
+
+        template<size_t error_order, class Type>
+        constexpr fd2D_tile resolve() const noexcept
         {
-            size_t offset_row = (row + offset) % phi.rows();
+            return { rows == 0 ? _fd2D_band_rows : rows, cols == 0 ? _fd2D_block_cols<error_order, Type>() : cols };
+        }
+    };
 
-            for (size_t col = 0; col < phi.cols(); ++col)
+    //(index - offset) modulo n, for any n and offset
+    constexpr size_t _wrap_back(size_t index, size_t offset, size_t n)
+    {
+        return (index + n * (offset / n + 1) - offset) % n;
+    }
+
+    /*
+    * Invokes func(row, col_begin, col_end) for every row segment of a rows x
+    * cols grid, cut into tiles of tile.rows rows by tile.cols columns (both
+    * non zero) which are shared between threads. Within a tile, rows are visited in
+    * turn, so a stencil reading the rows above and below the current one
+    * finds them still in cache however wide the grid is, a 4096 column row
+    * of doubles being as large as L1 on its own.
+    */
+    template<class Func>
+    void _fd2D_for_each_segment(size_t rows, size_t cols, fd2D_tile tile, Func&& func)
+    {
+        const ptrdiff_t bands = static_cast<ptrdiff_t>((rows + tile.rows - 1) / tile.rows);
+        const ptrdiff_t blocks = static_cast<ptrdiff_t>((cols + tile.cols - 1) / tile.cols);
+
+        #pragma omp parallel for collapse(2) schedule(static)
+        for (ptrdiff_t band = 0; band < bands; ++band)
+        {
+            for (ptrdiff_t block = 0; block < blocks; ++block)
             {
-                size_t offset_col = (col + offset) % phi.cols();
-
-                dphi(offset_row, offset_col) = 0.;
-                for (size_t i = 0; i <= error_order; ++i) {
-                    //Using 2D index here to remain as general as possible
-                    dphi(offset_row, offset_col) += (
-                        phi(offset_row, (col + i) % phi.cols()) / (dx * dx) +
-                        phi((row + i) % phi.rows(), offset_col) / (dy * dy)
-                    ) * stencil[i];
-                }
+                const size_t row_begin = band * tile.rows;
+                const size_t row_end = std::min(row_begin + tile.rows, rows);
+                const size_t col_begin = block * tile.cols;
+                const size_t col_end = std::min(col_begin + tile.cols, cols);
+
+                for (size_t row = row_begin; row < row_end; ++row)
+                    func(row, col_begin, col_end);
             }
         }
     }
 
+    /*
+    * Periodic laplacian of columns [col_begin, col_end) of one row, given
+    * pointers to the rows error_order / 2 above to error_order / 2 below it
+    * and the central difference weights along x and y, spacings included.
+    * out points at column col_begin. Only the columns within error_order / 2
+    * of the edges wrap around, the others are vectorised.
+    *
+    * Central weights are symmetric, so the two points k either side of the
+    * centre share a multiply, and both centre weights are merged: order 6
+    * takes 7 multiplies per point rather than 14.
+    */
+    template<size_t error_order, class Type>
+    LLPS_FORCE_INLINE inline void _laplacian_fd_segment(
+        const std::array<const Type*, error_order + 1>& row_ptrs, Type* out,
+        size_t col_begin, size_t col_end, size_t cols,
+        const std::array<Type, error_order + 1>& x_weights,
+        const std::array<Type, error_order + 1>& y_weights)
+    {
+        static constexpr size_t offset = error_order / 2;
+
+        //Columns whose stencil stays within the row
+        const size_t interior_begin = std::min(offset, cols);
+        const size_t interior_end = cols > offset ? std::max(cols - offset, interior_begin) : interior_begin;
+
+        const Type* centre = row_ptrs[offset];
+        const Type centre_weight = x_weights[offset] + y_weights[offset];
+
+        //Local, so that the writes to out can not be taken to alias them
+        std::array<Type, offset> x_pair, y_pair;
+        std::array<const Type*, offset> above, below;
+        for (size_t k = 0; k < offset; ++k) {
+            x_pair[k] = x_weights[offset - k - 1];
+            y_pair[k] = y_weights[offset - k - 1];
+            above[k] = row_ptrs[offset - k - 1];
+            below[k] = row_ptrs[offset + k + 1];
+        }
+
+        const size_t first = std::clamp(interior_begin, col_begin, col_end);
+        const size_t last = std::clamp(interior_end, first, col_end);
+
+        auto edge = [&](size_t col) {
+            Type result = centre_weight * centre[col];
+            for (size_t k = 0; k < offset; ++k)
+                result += x_pair[k] * (centre[_wrap_back(col, k + 1, cols)] + centre[(col + k + 1) % cols]) + y_pair[k] * (above[k][col] + below[k][col]);
+
+            out[col - col_begin] = result;
+        };
+
+        for (size_t col = col_begin; col < first; ++col)
+            edge(col);
+
+        #pragma omp simd
+        for (size_t col = first; col < last; ++col)
+        {
+            Type result = centre_weight * centre[col];
+            for (size_t k = 0; k < offset; ++k)
+                result += x_pair[k] * (centre[col - k - 1] + centre[col + k + 1]) + y_pair[k] * (above[k][col] + below[k][col]);
+
+            out[col - col_begin] = result;
+        }
+
+        for (size_t col = last; col < col_end; ++col)
+            edge(col);
+    }
+
+    /*
+    * Periodic central difference laplacian of a 2D grid, of any size (odd,
+    * or with rows != cols) and spacing (dx != dy), tiled as by
+    * _fd2D_for_each_segment, each row segment taken by _laplacian_fd_segment.
+    *
+    * tile overrides the estimated tile size, as block_rows does in 3D.
+    *
+    * Rows are read through pointers, so must be contiguous, as they are in
+    * grids and their subgrid views.
+    */
+    template<size_t error_order, grid2D_like InGrid, grid2D_like OutGrid>
+    void laplacian_central_fd(
+        const InGrid& phi, OutGrid& dphi,
+        typename OutGrid::value_type dx,
+        typename OutGrid::value_type dy,
+        fd2D_tile tile = {})
+    {
+        using value_type = typename OutGrid::value_type;
+
+        static constexpr auto stencil = central_fd_stencil<error_order, value_type>(2);
+        static constexpr size_t offset = error_order / 2;
+
+        const size_t rows = dphi.rows();
+        const size_t cols = dphi.cols();
+
+        std::array<value_type, error_order + 1> x_weights, y_weights;
+        for (size_t i = 0; i <= error_order; ++i) {
+            x_weights[i] = stencil[i] / (dx * dx);
+            y_weights[i] = stencil[i] / (dy * dy);
+        }
+
+        _fd2D_for_each_segment(rows, cols, tile.resolve<error_order, value_type>(), [&](size_t row, size_t col_begin, size_t col_end) {
+            std::array<const value_type*, error_order + 1> row_ptrs;
+            for (size_t i = 0; i <= error_order; ++i)
+                row_ptrs[i] = &phi(_wrap_back(row + i, offset, rows), 0);
+
+            _laplacian_fd_segment<error_order>(row_ptrs, &dphi(row, col_begin), col_begin, col_end, cols, x_weights, y_weights);
+        });
+    }
+
     template<size_t error_order, class Meta>
     LLPS_FORCE_INLINE constexpr auto laplacian_central_fd(
         const llps::_basic_grid<Meta>& phi, 
@@ -52,27 +205,242 @@ namespace llps::calculus {
 
         return dphi;
     }
-}
 
-#ifdef LLPS_USE_MKL
+    /*
+    * Number of rows swept together by the 3D stencil, chosen such that the
+    * error_order + 1 planes it reaches fit in a typical (256KiB) L2 cache.
+    */
+    template<size_t error_order, size_t cols, class Type>
+    consteval size_t _fd3D_block_rows()
+    {
+        constexpr size_t cache_size = 256 * 1024;
+        constexpr size_t row_bytes = (error_order + 1) * cols * sizeof(Type);
 
-#include "fftw/fftw3.h"
+        return std::max<size_t>(cache_size / row_bytes, 1);
+    }
 
-namespace llps::calculus {
+    /*
+    * Periodic central difference laplacian of a 3D grid, of any size, even
+    * one narrower than the stencil along any axis.
+    *
+    * z-planes are split into slabs which are shared between threads. Within a
+    * slab, the planes are swept one block of rows at a time, so the planes
+    * above and below the current one are still in cache when they are next
+    * needed.
+    *
+    * block_rows overrides the number of rows per block, as measured best by
+    * llps_autotune; 0 keeps the estimate of _fd3D_block_rows.
+    */
+    template<size_t error_order, grid3D_like InGrid, grid3D_like OutGrid>
+    void laplacian_central_fd(
+        const InGrid& phi, OutGrid& dphi,
+        typename OutGrid::value_type dx,
+        typename OutGrid::value_type dy,
+        typename OutGrid::value_type dz,
+        size_t block_rows = 0)
+    {
+        using value_type = typename OutGrid::value_type;
 
-    template<typename Type>
-    struct as_ftw_complex;
+        static constexpr auto stencil = central_fd_stencil<error_order, value_type>(2);
+        static constexpr size_t offset = error_order / 2;
+
+        static constexpr size_t slices = OutGrid::slices();
+        static constexpr size_t rows   = OutGrid::rows();
+        static constexpr size_t cols   = OutGrid::cols();
+
+        static constexpr size_t slab_depth = std::min<size_t>(8, slices);
+        static constexpr size_t slab_count = (slices + slab_depth - 1) / slab_depth;
+
+        if (block_rows == 0)
+            block_rows = _fd3D_block_rows<error_order, cols, value_type>();
+
+        const value_type x_scale = 1. / (dx * dx);
+        const value_type y_scale = 1. / (dy * dy);
+        const value_type z_scale = 1. / (dz * dz);
+
+        const value_type* in = phi.data();
+        value_type* out = dphi.data();
 
-    template<> struct as_ftw_complex<float> { using value_type = fftwf_complex; };
-    template<> struct as_ftw_complex<double> { using value_type = fftw_complex; };
-    template<> struct as_ftw_complex<long double> { using value_type = fftwl_complex; };
+        //Columns whose stencil stays within the row, the others wrapping around
+        static constexpr size_t interior_begin = std::min(offset, cols);
+        static constexpr size_t interior_end = cols > offset ? std::max(cols - offset, interior_begin) : interior_begin;
+
+        #pragma omp parallel for schedule(static)
+        for (ptrdiff_t slab = 0; slab < static_cast<ptrdiff_t>(slab_count); ++slab)
+        {
+            const size_t slab_begin = slab * slab_depth;
+            const size_t slab_end = std::min(slab_begin + slab_depth, slices);
+
+            for (size_t block = 0; block < rows; block += block_rows)
+            {
+                const size_t block_end = std::min(block + block_rows, rows);
+
+                for (size_t slice = slab_begin; slice < slab_end; ++slice)
+                {
+                    std::array<const value_type*, error_order + 1> planes;
+                    for (size_t i = 0; i <= error_order; ++i)
+                        planes[i] = in + _wrap_back(slice + i, offset, slices) * rows * cols;
+
+                    value_type* out_plane = out + slice * rows * cols;
+
+                    for (size_t row = block; row < block_end; ++row)
+                    {
+                        const size_t row_start = row * cols;
+
+                        //Local, so that the writes to the row can not be taken to alias them
+                        std::array<const value_type*, error_order + 1> row_ptrs, plane_rows;
+                        for (size_t i = 0; i <= error_order; ++i) {
+                            row_ptrs[i] = planes[offset] + _wrap_back(row + i, offset, rows) * cols;
+                            plane_rows[i] = planes[i] + row_start;
+                        }
+
+                        const value_type* centre = row_ptrs[offset];
+                        value_type* out_row = out_plane + row_start;
+
+                        auto edge = [&](size_t col) {
+                            value_type result = 0.;
+                            for (size_t i = 0; i <= error_order; ++i)
+                                result += (centre[_wrap_back(col + i, offset, cols)] * x_scale + row_ptrs[i][col] * y_scale + plane_rows[i][col] * z_scale) * stencil[i];
+
+                            out_row[col] = result;
+                        };
+
+                        for (size_t col = 0; col < interior_begin; ++col)
+                            edge(col);
+
+                        #pragma omp simd
+                        for (size_t col = interior_begin; col < interior_end; ++col)
+                        {
+                            value_type result = 0.;
+                            for (size_t i = 0; i <= error_order; ++i)
+                                result += (centre[col + i - offset] * x_scale + row_ptrs[i][col] * y_scale + plane_rows[i][col] * z_scale) * stencil[i];
+
+                            out_row[col] = result;
+                        }
+
+                        for (size_t col = interior_end; col < cols; ++col)
+                            edge(col);
+                    }
+                }
+            }
+        }
+    }
+
+    template<size_t error_order, class Meta>
+    LLPS_FORCE_INLINE constexpr auto laplacian_central_fd(
+        const llps::_basic_grid3D<Meta>& phi,
+        const llps::grid_value_t<Meta> dx,
+        const llps::grid_value_t<Meta> dy,
+        const llps::grid_value_t<Meta> dz)
+    {
+        llps::_basic_grid3D<Meta> dphi;
+        laplacian_central_fd<error_order>(phi, dphi, dx, dy, dz);
+
+        return dphi;
+    }
+
+    /*
+    * Periodic divergence of columns [col_begin, col_end) of one row, given
+    * the row of fx and pointers to the rows of fy error_order / 2 above to
+    * error_order / 2 below it, and the central difference weights along x
+    * and y, spacings included. out points at column col_begin, and columns
+    * wrap around as in _laplacian_fd_segment.
+    *
+    * First derivative weights are antisymmetric about a zero centre, so the
+    * two points k either side of it share a multiply.
+    */
+    template<size_t error_order, class Type>
+    LLPS_FORCE_INLINE inline void _divergence_fd_segment(
+        const Type* fx, const std::array<const Type*, error_order + 1>& fy_rows, Type* out,
+        size_t col_begin, size_t col_end, size_t cols,
+        const std::array<Type, error_order + 1>& x_weights,
+        const std::array<Type, error_order + 1>& y_weights)
+    {
+        static constexpr size_t offset = error_order / 2;
+
+        const size_t interior_begin = std::min(offset, cols);
+        const size_t interior_end = cols > offset ? std::max(cols - offset, interior_begin) : interior_begin;
+
+        std::array<Type, offset> x_pair, y_pair;
+        std::array<const Type*, offset> above, below;
+        for (size_t k = 0; k < offset; ++k) {
+            x_pair[k] = x_weights[offset + k + 1];
+            y_pair[k] = y_weights[offset + k + 1];
+            above[k] = fy_rows[offset - k - 1];
+            below[k] = fy_rows[offset + k + 1];
+        }
+
+        const size_t first = std::clamp(interior_begin, col_begin, col_end);
+        const size_t last = std::clamp(interior_end, first, col_end);
+
+        auto edge = [&](size_t col) {
+            Type result = 0.;
+            for (size_t k = 0; k < offset; ++k)
+                result += x_pair[k] * (fx[(col + k + 1) % cols] - fx[_wrap_back(col, k + 1, cols)]) + y_pair[k] * (below[k][col] - above[k][col]);
+
+            out[col - col_begin] = result;
+        };
+
+        for (size_t col = col_begin; col < first; ++col)
+            edge(col);
+
+        #pragma omp simd
+        for (size_t col = first; col < last; ++col)
+        {
+            Type result = 0.;
+            for (size_t k = 0; k < offset; ++k)
+                result += x_pair[k] * (fx[col + k + 1] - fx[col - k - 1]) + y_pair[k] * (below[k][col] - above[k][col]);
+
+            out[col - col_begin] = result;
+        }
+
+        for (size_t col = last; col < col_end; ++col)
+            edge(col);
+    }
+
+    /*
+    * Periodic central difference divergence of the vector field (fx, fy),
+    * d(fx)/dx + d(fy)/dy, on a 2D grid, tiled as laplacian_central_fd is and
+    * each row segment taken by _divergence_fd_segment.
+    */
+    template<size_t error_order, grid2D_like InGrid, grid2D_like OutGrid>
+    void divergence_central_fd(
+        const InGrid& fx, const InGrid& fy, OutGrid& div,
+        typename OutGrid::value_type dx,
+        typename OutGrid::value_type dy,
+        fd2D_tile tile = {})
+    {
+        using value_type = typename OutGrid::value_type;
+
+        static constexpr auto stencil = central_fd_stencil<error_order, value_type>(1);
+        static constexpr size_t offset = error_order / 2;
+
+        const size_t rows = div.rows();
+        const size_t cols = div.cols();
+
+        std::array<value_type, error_order + 1> x_weights, y_weights;
+        for (size_t i = 0; i <= error_order; ++i) {
+            x_weights[i] = stencil[i] / dx;
+            y_weights[i] = stencil[i] / dy;
+        }
+
+        _fd2D_for_each_segment(rows, cols, tile.resolve<error_order, value_type>(), [&](size_t row, size_t col_begin, size_t col_end) {
+            std::array<const value_type*, error_order + 1> row_ptrs;
+            for (size_t i = 0; i <= error_order; ++i)
+                row_ptrs[i] = &fy(_wrap_back(row + i, offset, rows), 0);
+
+            _divergence_fd_segment<error_order>(&fx(row, 0), row_ptrs, &div(row, col_begin), col_begin, col_end, cols, x_weights, y_weights);
+        });
+    }
+
+    template<typename Type>
+    struct as_ftw_complex { using value_type = fft::complex<Type>; };
 
     template<typename Type>
     struct complex_base;
 
-    template<> struct complex_base<fftwf_complex> { using value_type = float; };
-    template<> struct complex_base<fftw_complex> { using value_type = double; };
-    template<> struct complex_base<fftwl_complex> { using value_type = long double; };
+    template<std::floating_point Type>
+    struct complex_base<Type[2]> { using value_type = Type; };
 
     template<typename Type>
     using as_ftw_complex_t = typename as_ftw_complex<Type>::value_type;
@@ -80,55 +448,371 @@ namespace llps::calculus {
     template<typename Type>
     using complex_base_t = typename complex_base<Type>::value_type;
 
-    template<size_t _rows, size_t _cols, std::input_iterator It>
-    void mult_herm_nfreq_squared(
-        It first, 
-        complex_base_t<std::iter_value_t<It>> dx,
-        complex_base_t<std::iter_value_t<It>> dy)
+    //Multiplies a _rows x _cols half spectrum by the (normalised) -|k|^2 of tables
+    template<std::input_iterator It, std::floating_point Type, size_t _rows, size_t _cols>
+    void mult_herm_nfreq_squared(It first, const spectral_tables<Type, _rows, _cols>& tables)
+    {
+        mult_symbol(reinterpret_cast<Type*>(&(*first)[0]), tables.laplacian().data(), tables.size);
+    }
+
+    //Multiplies a _slices x _rows x _cols half spectrum by the (normalised) -|k|^2 of tables
+    template<std::input_iterator It, std::floating_point Type, size_t _slices, size_t _rows, size_t _cols>
+    void mult_herm_nfreq_squared(It first, const spectral_tables3D<Type, _slices, _rows, _cols>& tables)
+    {
+        using tables_type = spectral_tables3D<Type, _slices, _rows, _cols>;
+
+        Type* spectrum = reinterpret_cast<Type*>(&(*first)[0]);
+        const Type* laplacian = tables.laplacian().data();
+
+        #pragma omp parallel for schedule(static)
+        for (ptrdiff_t slice = 0; slice < static_cast<ptrdiff_t>(_slices); ++slice) {
+            const size_t offset = slice * tables_type::slice_size;
+            mult_symbol(spectrum + 2 * offset, laplacian + offset, tables_type::slice_size);
+        }
+    }
+
+    /*
+    * Fourier spectral operators on a periodic _rows x _cols grid. Owns the FFT
+    * plans, the half spectrum buffers and the wavenumber tables, so that
+    * applying an operator costs one forward transform, one pass over the
+    * spectrum and one backward transform.
+    *
+    * Nonlinear terms are transformed through forward_nonlinear, dealiased
+    * according to the mode given on construction; degree is that of the
+    * terms, which truncation needs (see dealiasing). Padding is exact for
+    * degrees up to 3.
+    *
+    * Grids passed in must share the alignment of fft::allocate, as is the
+    * case for the default grid allocator.
+    */
+    template<std::floating_point Type, size_t _rows, size_t _cols>
+    struct spectral_operator
     {
-        using type = complex_base_t<std::iter_value_t<It>>;
+    public:
+        using tables_type  = spectral_tables<Type, _rows, _cols>;
+        using complex_type = as_ftw_complex_t<Type>;
+
+        //Refinement of the padded grid, 2 (rather than 3/2) keeps cubic terms alias free
+        static constexpr size_t padding_factor = 2;
+
+        static constexpr size_t padded_rows = padding_factor * _rows;
+        static constexpr size_t padded_cols = padding_factor * _cols;
+        static constexpr size_t padded_freq_cols = padded_cols / 2 + 1;
+
+    public:
+        spectral_operator(Type dx, Type dy, dealiasing mode = dealiasing::none, size_t degree = 2) :
+            _tables(dx, dy, degree),
+            _mode(mode),
+            _plan({ _rows, _cols }),
+            _real(fft::allocate<Type>(_rows * _cols)),
+            _phi_hat(fft::allocate<complex_type>(tables_type::size)),
+            _nonlinear_hat(fft::allocate<complex_type>(tables_type::size))
+        {
+            if (_mode == dealiasing::padding) {
+                _padded_plan.emplace(std::vector<size_t>{ padded_rows, padded_cols });
+
+                _padded_real = fft::allocate<Type>(padded_rows * padded_cols);
+                _padded_hat  = fft::allocate<complex_type>(padded_rows * padded_freq_cols);
+            }
+        }
+
+        spectral_operator(const spectral_operator&) = delete;
+        spectral_operator& operator=(const spectral_operator&) = delete;
+
+        ~spectral_operator()
+        {
+            if (_mode == dealiasing::padding) {
+                fft::deallocate(_padded_real);
+                fft::deallocate(_padded_hat);
+            }
+
+            fft::deallocate(_real);
+            fft::deallocate(_phi_hat);
+            fft::deallocate(_nonlinear_hat);
+        }
 
-        type x_freq_elem = 2. * std::numbers::pi / (_cols * dx);
-        type y_freq_elem = 2. * std::numbers::pi / (_rows * dy);
+    public:
+        const tables_type& tables() const noexcept { return _tables; }
+        dealiasing dealias_mode() const noexcept { return _mode; }
 
-        static constexpr auto row_indicies = row_freq_indicies<_rows>();
+        complex_type* spectrum() noexcept { return _phi_hat; }
+        complex_type* nonlinear_spectrum() noexcept { return _nonlinear_hat; }
 
-        for (int32_t row : row_indicies)
+        template<class Container>
+        void forward(const llps::grid<Type, _rows, _cols, Container>& phi)
         {
-            type kappa_y = y_freq_elem * row;
+            _plan.forward(phi.data(), _phi_hat);
+        }
+
+        template<class Container>
+        void backward(llps::grid<Type, _rows, _cols, Container>& phi)
+        {
+            _plan.backward(_phi_hat, phi.data());
+        }
+
+        void apply_symbol(const typename tables_type::table_type& symbol)
+        {
+            mult_symbol(reinterpret_cast<Type*>(_phi_hat), symbol.data(), tables_type::size);
+        }
 
-            for (size_t col = 0; col <= _cols / 2; ++col, ++first)
+        /*
+        * Transforms phi into spectrum(), and the pointwise product func(phi)
+        * into nonlinear_spectrum(). Both spectra are unnormalised, as left by
+        * forward. Costs one extra forward transform without dealiasing, plus a
+        * backward transform with truncation, or a backward and forward transform
+        * of the padded grid (four times the size) with padding.
+        */
+        template<class Container, class Func>
+        void forward_nonlinear(const llps::grid<Type, _rows, _cols, Container>& phi, Func&& func)
+        {
+            forward(phi);
+
+            switch (_mode)
             {
-                type kappa_x = x_freq_elem * col;
-                type kappa_xy = (-kappa_x * kappa_x - kappa_y * kappa_y) / (_rows * _cols);
+            case dealiasing::none:
+                _apply_pointwise(phi.data(), _real, _rows * _cols, func);
+                _plan.forward(_real, _nonlinear_hat);
+                break;
+            case dealiasing::truncation:
+                _truncate_nonlinear(func);
+                break;
+            case dealiasing::padding:
+                _pad_nonlinear(func);
+                break;
+            }
+        }
+
+    public:
+        template<class Container1, class Container2>
+        void laplacian(const llps::grid<Type, _rows, _cols, Container1>& phi, llps::grid<Type, _rows, _cols, Container2>& dphi)
+        {
+            forward(phi);
+            apply_symbol(_tables.laplacian());
+            backward(dphi);
+        }
+
+        template<class Container1, class Container2>
+        void biharmonic(const llps::grid<Type, _rows, _cols, Container1>& phi, llps::grid<Type, _rows, _cols, Container2>& dphi)
+        {
+            forward(phi);
+            apply_symbol(_tables.biharmonic());
+            backward(dphi);
+        }
+
+        /*
+        * One semi-implicit (IMEX) Euler step of Model B,
+        *     dphi/dt = laplacian(mu(phi) - k * laplacian(phi)),
+        * taken in place. The local chemical potential mu is explicit, and
+        * dealiased as in forward_nonlinear, while the stiff biharmonic term is
+        * implicit, through spectral_tables::imex_symbol. The symbol is kept
+        * between steps of equal dt and k.
+        */
+        template<class Container, class Func>
+        void imex_step(llps::grid<Type, _rows, _cols, Container>& phi, Type dt, Type k, Func&& mu)
+        {
+            if (_imex.empty() || _imex_dt != dt || _imex_k != k) {
+                _tables.imex_symbol(dt, k, _imex);
+                _imex_dt = dt;
+                _imex_k = k;
+            }
+
+            forward_nonlinear(phi, mu);
+
+            //The implicit symbol carries the normalisation, so the explicit -dt*|k|^2 must not
+            const Type explicit_scale = dt * (_rows * _cols);
+
+            //Local, so that writes can not be taken to alias them
+            Type* phi_hat = reinterpret_cast<Type*>(_phi_hat);
+            const Type* nonlinear_hat = reinterpret_cast<const Type*>(_nonlinear_hat);
+            const Type* laplacian = _tables.laplacian().data();
+            const Type* implicit = _imex.data();
+
+            #pragma omp simd
+            for (ptrdiff_t i = 0; i < static_cast<ptrdiff_t>(tables_type::size); ++i) {
+                const Type explicit_symbol = explicit_scale * laplacian[i];
+
+                phi_hat[2 * i]     = implicit[i] * (phi_hat[2 * i]     + explicit_symbol * nonlinear_hat[2 * i]);
+                phi_hat[2 * i + 1] = implicit[i] * (phi_hat[2 * i + 1] + explicit_symbol * nonlinear_hat[2 * i + 1]);
+            }
+
+            backward(phi);
+        }
+
+    private:
+        template<class Func>
+        static void _apply_pointwise(const Type* in, Type* out, size_t size, Func& func)
+        {
+            #pragma omp parallel for schedule(static)
+            for (ptrdiff_t i = 0; i < static_cast<ptrdiff_t>(size); ++i)
+                out[i] = func(in[i]);
+        }
+
+        template<class Func>
+        void _truncate_nonlinear(Func& func)
+        {
+            static constexpr Type normalisation = Type(1) / (_rows * _cols);
+
+            Type* phi_hat = reinterpret_cast<Type*>(_phi_hat);
+            Type* nonlinear_hat = reinterpret_cast<Type*>(_nonlinear_hat);
+            const Type* mask = _tables.dealias_mask().data();
+
+            //Resolved part of phi, the copy also spares _phi_hat from the destructive c2r
+            for (size_t i = 0; i < tables_type::size; ++i) {
+                nonlinear_hat[2 * i]     = phi_hat[2 * i]     * mask[i] * normalisation;
+                nonlinear_hat[2 * i + 1] = phi_hat[2 * i + 1] * mask[i] * normalisation;
+            }
+
+            _plan.backward(_nonlinear_hat, _real);
+            _apply_pointwise(_real, _real, _rows * _cols, func);
+            _plan.forward(_real, _nonlinear_hat);
+
+            mult_symbol(nonlinear_hat, mask, tables_type::size);
+        }
 
-                (*first)[0] *= kappa_xy;
-                (*first)[1] *= kappa_xy;
+        template<class Func>
+        void _pad_nonlinear(Func& func)
+        {
+            //Scales into physical values on the fine grid, and back to the coarse transform's scaling
+            static constexpr Type to_padded   = Type(1) / (_rows * _cols);
+            static constexpr Type from_padded = Type(1) / (padding_factor * padding_factor);
+
+            std::fill_n(reinterpret_cast<Type*>(_padded_hat), 2 * padded_rows * padded_freq_cols, Type(0));
+
+            //The Nyquist row and column (of even sizes) have no unambiguous place in the padded spectrum, and are dropped
+            static constexpr size_t kept_cols = _cols % 2 == 0 ? _cols / 2 : tables_type::freq_cols;
+
+            for (size_t row = 0; row < _rows; ++row) {
+                const int64_t freq = freq_index(row, _rows);
+                if (2 * std::abs(freq) == static_cast<int64_t>(_rows))
+                    continue;
+
+                const size_t padded_row = freq < 0 ? padded_rows + freq : freq;
+
+                const complex_type* src = _phi_hat + row * tables_type::freq_cols;
+                complex_type* dst = _padded_hat + padded_row * padded_freq_cols;
+
+                for (size_t col = 0; col < kept_cols; ++col) {
+                    dst[col][0] = src[col][0] * to_padded;
+                    dst[col][1] = src[col][1] * to_padded;
+                }
+            }
+
+            _padded_plan->backward(_padded_hat, _padded_real);
+            _apply_pointwise(_padded_real, _padded_real, padded_rows * padded_cols, func);
+            _padded_plan->forward(_padded_real, _padded_hat);
+
+            for (size_t row = 0; row < _rows; ++row) {
+                const int64_t freq = freq_index(row, _rows);
+                const size_t padded_row = freq < 0 ? padded_rows + freq : freq;
+
+                const complex_type* src = _padded_hat + padded_row * padded_freq_cols;
+                complex_type* dst = _nonlinear_hat + row * tables_type::freq_cols;
+
+                const bool nyquist_row = 2 * std::abs(freq) == static_cast<int64_t>(_rows);
+                for (size_t col = 0; col < tables_type::freq_cols; ++col) {
+                    const bool dropped = nyquist_row || 2 * col == _cols;
+
+                    dst[col][0] = dropped ? Type(0) : src[col][0] * from_padded;
+                    dst[col][1] = dropped ? Type(0) : src[col][1] * from_padded;
+                }
             }
         }
+
+    private:
+        tables_type _tables;
+        dealiasing _mode;
+
+        fft::real_plan<Type> _plan;
+
+        Type* _real;
+        complex_type* _phi_hat;
+        complex_type* _nonlinear_hat;
+
+        //Only set up with dealiasing::padding
+        std::optional<fft::real_plan<Type>> _padded_plan;
+
+        Type* _padded_real = nullptr;
+        complex_type* _padded_hat = nullptr;
+
+        //Set up by the first imex_step
+        typename tables_type::table_type _imex;
+        Type _imex_dt = 0, _imex_k = 0;
+    };
+
+    /*
+    * Fourier spectral operators on a periodic _slices x _rows x _cols grid,
+    * owning the FFT plan, the half spectrum buffer and the wavenumber tables
+    * as spectral_operator does.
+    */
+    template<std::floating_point Type, size_t _slices, size_t _rows, size_t _cols>
+    struct spectral_operator3D
+    {
+    public:
+        using tables_type  = spectral_tables3D<Type, _slices, _rows, _cols>;
+        using complex_type = as_ftw_complex_t<Type>;
+
+    public:
+        spectral_operator3D(Type dx, Type dy, Type dz) :
+            _tables(dx, dy, dz),
+            _plan({ _slices, _rows, _cols }),
+            _phi_hat(fft::allocate<complex_type>(tables_type::size))
+        {}
+
+        spectral_operator3D(const spectral_operator3D&) = delete;
+        spectral_operator3D& operator=(const spectral_operator3D&) = delete;
+
+        ~spectral_operator3D()
+        {
+            fft::deallocate(_phi_hat);
+        }
+
+    public:
+        const tables_type& tables() const noexcept { return _tables; }
+
+        template<class Container1, class Container2>
+        void laplacian(const llps::grid3D<Type, _slices, _rows, _cols, Container1>& phi, llps::grid3D<Type, _slices, _rows, _cols, Container2>& dphi)
+        {
+            _plan.forward(phi.data(), _phi_hat);
+            mult_herm_nfreq_squared(_phi_hat, _tables);
+            _plan.backward(_phi_hat, dphi.data());
+        }
+
+        template<class Container1, class Container2>
+        void biharmonic(const llps::grid3D<Type, _slices, _rows, _cols, Container1>& phi, llps::grid3D<Type, _slices, _rows, _cols, Container2>& dphi)
+        {
+            _plan.forward(phi.data(), _phi_hat);
+            mult_symbol(reinterpret_cast<Type*>(_phi_hat), _tables.biharmonic().data(), tables_type::size);
+            _plan.backward(_phi_hat, dphi.data());
+        }
+
+    private:
+        tables_type _tables;
+        fft::real_plan<Type> _plan;
+        complex_type* _phi_hat;
+    };
+
+    /*
+    * Operator of the spacings laplacian_spectral was last called with on this
+    * thread, for this shape, so that repeated calls reuse its plans and tables.
+    */
+    template<class Operator, class... Spacings>
+    Operator& _cached_spectral_operator(Spacings... spacings)
+    {
+        thread_local std::optional<Operator> cached;
+
+        if (!cached || cached->tables().spacings() != std::array{ spacings... })
+            cached.emplace(spacings...);
+
+        return *cached;
     }
 
     template<std::floating_point Type, size_t _rows, size_t _cols, class Container1, class Container2>
     void laplacian_spectral(
-        llps::grid<Type, _rows, _cols, Container1>& phi,
+        const llps::grid<Type, _rows, _cols, Container1>& phi,
         llps::grid<Type, _rows, _cols, Container2>& dphi,
         Type dx, Type dy)
     {
-        using complex_type = as_ftw_complex_t<Type>;
-
-        static constexpr size_t phi_hat_size = _rows * (_cols/2 + 1);
-        complex_type* phi_hat = static_cast<complex_type*>(fftw_malloc(sizeof(complex_type) * phi_hat_size));
-
-        fftw_plan forw_plan = fftw_plan_dft_r2c_2d(_rows, _cols, phi.data(), phi_hat, FFTW_ESTIMATE);
-        fftw_plan back_plan = fftw_plan_dft_c2r_2d(_rows, _cols, phi_hat, dphi.data(), FFTW_ESTIMATE);
-        
-        fftw_execute(forw_plan);
-        mult_herm_nfreq_squared<_rows, _cols>(phi_hat, dx, dy);
-        fftw_execute(back_plan);
-
-        fftw_destroy_plan(forw_plan);
-        fftw_destroy_plan(back_plan);
-        fftw_free(phi_hat);
+        _cached_spectral_operator<spectral_operator<Type, _rows, _cols>>(dx, dy).laplacian(phi, dphi);
     }
 
     template<std::floating_point Type, size_t _rows, size_t _cols, class Container>
@@ -137,8 +821,21 @@ namespace llps::calculus {
         laplacian_spectral(phi, phi, dx, dy);
     }
 
-}
+    template<std::floating_point Type, size_t _slices, size_t _rows, size_t _cols, class Container1, class Container2>
+    void laplacian_spectral(
+        const llps::grid3D<Type, _slices, _rows, _cols, Container1>& phi,
+        llps::grid3D<Type, _slices, _rows, _cols, Container2>& dphi,
+        Type dx, Type dy, Type dz)
+    {
+        _cached_spectral_operator<spectral_operator3D<Type, _slices, _rows, _cols>>(dx, dy, dz).laplacian(phi, dphi);
+    }
+
+    template<std::floating_point Type, size_t _slices, size_t _rows, size_t _cols, class Container>
+    void laplacian_spectral(llps::grid3D<Type, _slices, _rows, _cols, Container>& phi, Type dx, Type dy, Type dz)
+    {
+        laplacian_spectral(phi, phi, dx, dy, dz);
+    }
 
-#endif // LLPS_USE_MKL
+}
 
 #endif // !LLPS_CALCULUS_DIFFERENTIATE_HPP_INCLUDED
\ No newline at end of file
@@ -1,24 +1,220 @@
 #ifndef LLPS_CALCULUS_FOURIER_SPECTRAL_HPP_INCLUDED
 #define LLPS_CALCULUS_FOURIER_SPECTRAL_HPP_INCLUDED
 
-#include <array>
-#include <cstddef>
+#include <array>    //Access to std::array
+#include <vector>   //Access to std::vector
+#include <cstddef>  //Access to size_t and ptrdiff_t
+#include <cstdint>  //Access to fixed size types
+#include <concepts> //Access to std::floating_point
+#include <numbers>  //Access to std::numbers::pi
+#include <cstdlib>  //Access to std::abs
+
+#include "../grid.hpp"
 
 namespace llps::calculus {
+
+    /*
+    * Treatment of the aliasing error of nonlinear (pointwise) terms evaluated
+    * in real space by pseudo-spectral operators:
+    *  - none:       products are transformed as is;
+    *  - truncation: modes from 1/(degree + 1) of the grid size on are zeroed
+    *                before and after the product, for products of up to
+    *                degree factors (see spectral_tables): the 2/3 rule for
+    *                quadratic terms, the 1/2 rule for cubic ones. The 2/3
+    *                rule on a cubic term leaves part of its aliasing, kept
+    *                modes of up to N/3 giving products up to N which wrap
+    *                onto kept modes;
+    *  - padding:    the product is evaluated on a zero padded grid, twice as
+    *                fine in each direction, which is exact up to cubic terms.
+    */
+    enum class dealiasing { none, truncation, padding };
+
+    /*
+    * Signed frequency of the index-th output of a length n DFT: 0 to
+    * (n - 1) / 2, then the negative frequencies up to -1, with the Nyquist
+    * frequency of even n counted as negative.
+    */
+    constexpr int64_t freq_index(size_t index, size_t n)
+    {
+        return 2 * index < n ? static_cast<int64_t>(index) : static_cast<int64_t>(index) - static_cast<int64_t>(n);
+    }
+
+    //freq_index of every output of a length _rows DFT, of any (also odd) length
     template<size_t _rows>
     consteval std::array<int32_t, _rows> row_freq_indicies()
     {
-        static_assert(_rows % 2 == 0, "_rows must be even.");
-
         std::array<int32_t, _rows> result;
-        for (int32_t i = 0; i < _rows / 2; ++i) {
-            result[i] = i;
-            result[_rows - 1 - i] = -i-1;
-        }
+        for (size_t i = 0; i < _rows; ++i)
+            result[i] = static_cast<int32_t>(freq_index(i, _rows));
 
         return result;
     }
 
+    /*
+    * Multiplies each complex value of an interleaved (re, im) spectrum by the
+    * corresponding real entry of symbol, in a single vectorisable pass.
+    */
+    template<std::floating_point Type>
+    void mult_symbol(Type* spectrum, const Type* symbol, size_t size)
+    {
+        #pragma omp simd
+        for (ptrdiff_t i = 0; i < static_cast<ptrdiff_t>(size); ++i) {
+            spectrum[2 * i]     *= symbol[i];
+            spectrum[2 * i + 1] *= symbol[i];
+        }
+    }
+
+    /*
+    * Wavenumber tables of the half spectrum produced by a _rows x _cols r2c
+    * transform, in the same (row, col <= _cols/2) layout, for any sizes and
+    * spacings. Symbols already include the 1/(_rows * _cols) normalisation of
+    * the backward transform, so a forward transform, mult_symbol and a
+    * backward transform apply the operator in one pass over the spectrum.
+    *
+    * Tables only depend on the shape, spacings and degree, so are built once
+    * and kept by their owner (see spectral_operator). degree is that of the
+    * nonlinear terms dealias_mask is meant for: modes k with
+    * (degree + 1) |k| < N along each direction are kept, so a product of
+    * degree of them, of modes below degree N / (degree + 1), only wraps onto
+    * modes which are not.
+    */
+    template<std::floating_point Type, size_t _rows, size_t _cols>
+    struct spectral_tables
+    {
+    public:
+        using table_type = std::vector<Type, _grid_default_alloc<Type>>;
+
+        static constexpr size_t freq_cols = _cols / 2 + 1;
+        static constexpr size_t size = _rows * freq_cols;
+
+    public:
+        spectral_tables(Type dx, Type dy, size_t degree = 2) :
+            _spacings{ dx, dy }, _degree(degree), _laplacian(size), _biharmonic(size), _dealias(size)
+        {
+            const Type x_freq_elem = 2. * std::numbers::pi / (_cols * dx);
+            const Type y_freq_elem = 2. * std::numbers::pi / (_rows * dy);
+
+            static constexpr Type normalisation = Type(1) / (_rows * _cols);
+
+            for (size_t row = 0, i = 0; row < _rows; ++row)
+            {
+                const int64_t row_freq = freq_index(row, _rows);
+                const Type kappa_y = y_freq_elem * row_freq;
+
+                for (size_t col = 0; col < freq_cols; ++col, ++i)
+                {
+                    const Type kappa_x = x_freq_elem * col;
+                    const Type kappa_sq = kappa_x * kappa_x + kappa_y * kappa_y;
+
+                    _laplacian[i]  = -kappa_sq * normalisation;
+                    _biharmonic[i] = kappa_sq * kappa_sq * normalisation;
+
+                    //Only modes below 1/(degree + 1) of the grid size are kept, 2/3 rule for degree 2
+                    const bool resolved =
+                        static_cast<int64_t>(degree + 1) * std::abs(row_freq) < static_cast<int64_t>(_rows) &&
+                        (degree + 1) * col < _cols;
+                    _dealias[i] = resolved ? Type(1) : Type(0);
+                }
+            }
+        }
+
+    public:
+        //(dx, dy) the tables were built for
+        const std::array<Type, 2>& spacings() const noexcept { return _spacings; }
+        //Degree of the products dealias_mask() is built for
+        size_t degree() const noexcept { return _degree; }
+
+        //-|k|^2, normalised
+        const table_type& laplacian() const noexcept { return _laplacian; }
+        //|k|^4, normalised
+        const table_type& biharmonic() const noexcept { return _biharmonic; }
+        //1 for modes kept by truncation at degree() and 0 otherwise (not normalised)
+        const table_type& dealias_mask() const noexcept { return _dealias; }
+
+        /*
+        * Symbol of the linear implicit part of a semi-implicit (IMEX) Euler step of
+        * Model B, 1/(1 + dt*k*|k|^4), normalised. Written into out, which is
+        * resized as needed, so callers can keep it between steps of equal dt.
+        */
+        void imex_symbol(Type dt, Type k, table_type& out) const
+        {
+            static constexpr Type normalisation = Type(1) / (_rows * _cols);
+
+            out.resize(size);
+            for (size_t i = 0; i < size; ++i)
+                out[i] = normalisation / (1 + dt * k * _biharmonic[i] / normalisation);
+        }
+
+    private:
+        std::array<Type, 2> _spacings;
+        size_t _degree;
+
+        table_type _laplacian;
+        table_type _biharmonic;
+        table_type _dealias;
+    };
+
+    /*
+    * spectral_tables of the half spectrum of a _slices x _rows x _cols r2c
+    * transform, laid out slice by slice. Only the linear operators are
+    * tabulated, dealiasing is not offered in 3D.
+    */
+    template<std::floating_point Type, size_t _slices, size_t _rows, size_t _cols>
+    struct spectral_tables3D
+    {
+    public:
+        using table_type = std::vector<Type, _grid_default_alloc<Type>>;
+
+        static constexpr size_t freq_cols = _cols / 2 + 1;
+        static constexpr size_t slice_size = _rows * freq_cols;
+        static constexpr size_t size = _slices * slice_size;
+
+    public:
+        spectral_tables3D(Type dx, Type dy, Type dz) :
+            _spacings{ dx, dy, dz }, _laplacian(size), _biharmonic(size)
+        {
+            const Type x_freq_elem = 2. * std::numbers::pi / (_cols * dx);
+            const Type y_freq_elem = 2. * std::numbers::pi / (_rows * dy);
+            const Type z_freq_elem = 2. * std::numbers::pi / (_slices * dz);
+
+            static constexpr Type normalisation = Type(1) / (_slices * _rows * _cols);
+
+            for (size_t slice = 0, i = 0; slice < _slices; ++slice)
+            {
+                const Type kappa_z = z_freq_elem * freq_index(slice, _slices);
+
+                for (size_t row = 0; row < _rows; ++row)
+                {
+                    const Type kappa_y = y_freq_elem * freq_index(row, _rows);
+
+                    for (size_t col = 0; col < freq_cols; ++col, ++i)
+                    {
+                        const Type kappa_x = x_freq_elem * col;
+                        const Type kappa_sq = kappa_x * kappa_x + kappa_y * kappa_y + kappa_z * kappa_z;
+
+                        _laplacian[i]  = -kappa_sq * normalisation;
+                        _biharmonic[i] = kappa_sq * kappa_sq * normalisation;
+                    }
+                }
+            }
+        }
+
+    public:
+        //(dx, dy, dz) the tables were built for
+        const std::array<Type, 3>& spacings() const noexcept { return _spacings; }
+
+        //-|k|^2, normalised
+        const table_type& laplacian() const noexcept { return _laplacian; }
+        //|k|^4, normalised
+        const table_type& biharmonic() const noexcept { return _biharmonic; }
+
+    private:
+        std::array<Type, 3> _spacings;
+
+        table_type _laplacian;
+        table_type _biharmonic;
+    };
+
 }
 
-#endif // !LLPS_CALCULUS_FOURIER_SPECTRAL_HPP_INCLUDED
\ No newline at end of file
+#endif // !LLPS_CALCULUS_FOURIER_SPECTRAL_HPP_INCLUDED
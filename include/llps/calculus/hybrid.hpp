@@ -0,0 +1,226 @@
+#ifndef LLPS_CALCULUS_HYBRID_HPP_INCLUDED
+#define LLPS_CALCULUS_HYBRID_HPP_INCLUDED
+
+#include <vector>    //Access to std::vector
+#include <cstddef>   //Access to size_t and ptrdiff_t
+#include <cmath>     //Access to std::sqrt
+#include <chrono>    //Access to std::chrono::steady_clock
+#include <limits>    //Access to std::numeric_limits
+#include <utility>   //Access to std::swap
+#include <algorithm> //Access to std::max
+
+#include "../grid.hpp"
+
+namespace llps::calculus {
+
+    enum class hybrid_method { finite_difference, spectral };
+
+    /*
+    * Right hand side which runs either a finite difference or a spectral
+    * model of the same equation, whichever is cheaper while it is accurate
+    * enough, switching between them in the middle of an integration.
+    *
+    * The cost of a model is the time per unit of simulated time, the time of
+    * one evaluation times the spectral radius of its jacobian: an explicit
+    * stepper's steps are bounded by the stiffest mode, which is where the two
+    * differ most (the spectral biharmonic resolves the Nyquist modes the
+    * finite differences damp). Both are measured at construction, on the
+    * initial state: the evaluation time over repeats calls, and the radius by
+    * power iteration from the checkerboard, the highest mode of the grid.
+    *
+    * Accuracy is checked by check, at most once every check_interval of
+    * simulated time, as the relative difference of the two right hand sides.
+    * Call it from the observer, on accepted states: the right hand side is
+    * also evaluated at the trial stages of steps which may be rejected, and
+    * the model must not change within a step. The spectral model is taken
+    * as the reference, being exact to round off for resolved fields where
+    * finite differences converge only algebraically (see
+    * gen_spectral_error_data and gen_fd_error_data).
+    * Finite differences are used while they are both cheaper and within
+    * tolerance, and are only returned to once the difference falls below
+    * half of it, so a difference hovering about the tolerance does not
+    * switch the model at every check.
+    *
+    * Models are copied, so pass one owning plans, such as a spectral model,
+    * by std::ref.
+    */
+    template<grid_like State, class FiniteDifference, class Spectral>
+    class hybrid_rhs
+    {
+    public:
+        using state_type = State;
+        using value_type = typename State::value_type;
+
+        struct switch_event
+        {
+            double t;
+            hybrid_method method;
+            value_type difference;
+        };
+
+    public:
+        hybrid_rhs(FiniteDifference finite_difference, Spectral spectral, const state_type& phi0,
+            value_type tolerance = 1e-3, double check_interval = 10., size_t repeats = 10) :
+            _finite_difference(finite_difference), _spectral(spectral),
+            _tolerance(tolerance), _check_interval(check_interval)
+        {
+            _seconds_per_rhs[0] = _time(_finite_difference, phi0, repeats);
+            _seconds_per_rhs[1] = _time(_spectral, phi0, repeats);
+
+            _spectral_radius[0] = _power_iteration(_finite_difference, phi0);
+            _spectral_radius[1] = _power_iteration(_spectral, phi0);
+
+            _method = cost(hybrid_method::finite_difference) <= cost(hybrid_method::spectral)
+                ? hybrid_method::finite_difference
+                : hybrid_method::spectral;
+        }
+
+    public:
+        void operator()(const state_type& phi, state_type& dphi, double t)
+        {
+            if (_method == hybrid_method::finite_difference)
+                _finite_difference(phi, dphi, t);
+            else
+                _spectral(phi, dphi, t);
+        }
+
+        //Compares both models at phi, choosing the one used until the next check, if check_interval has passed since the last
+        void check(const state_type& phi, double t)
+        {
+            if (t < _next_check)
+                return;
+
+            _spectral(phi, _reference, t);
+            _finite_difference(phi, _other, t);
+
+            const value_type* reference = _reference.data();
+            const value_type* other = _other.data();
+
+            value_type difference_sq = 0;
+            value_type norm_sq = 0;
+
+            #pragma omp parallel for simd schedule(static) reduction(+:difference_sq, norm_sq)
+            for (ptrdiff_t i = 0; i < static_cast<ptrdiff_t>(state_type::size()); ++i) {
+                difference_sq += (other[i] - reference[i]) * (other[i] - reference[i]);
+                norm_sq += reference[i] * reference[i];
+            }
+
+            _difference = norm_sq > 0 ? std::sqrt(difference_sq / norm_sq) : 0;
+            _next_check = t + _check_interval;
+
+            const bool cheaper = cost(hybrid_method::finite_difference) <= cost(hybrid_method::spectral);
+            const value_type tolerance = _method == hybrid_method::finite_difference ? _tolerance : _tolerance / 2;
+
+            const hybrid_method method = cheaper && _difference <= tolerance ? hybrid_method::finite_difference : hybrid_method::spectral;
+            if (method != _method) {
+                _method = method;
+                _switches.push_back({ t, method, _difference });
+            }
+        }
+
+    public:
+        hybrid_method method() const noexcept { return _method; }
+
+        //Seconds per unit of simulated time
+        double cost(hybrid_method method) const noexcept { return _seconds_per_rhs[_index(method)] * _spectral_radius[_index(method)]; }
+        double seconds_per_rhs(hybrid_method method) const noexcept { return _seconds_per_rhs[_index(method)]; }
+        double spectral_radius(hybrid_method method) const noexcept { return _spectral_radius[_index(method)]; }
+
+        //Relative difference of the models at the last check
+        value_type difference() const noexcept { return _difference; }
+        //Every change of model, in order
+        const std::vector<switch_event>& switches() const noexcept { return _switches; }
+
+    private:
+        static constexpr size_t _index(hybrid_method method) noexcept { return method == hybrid_method::finite_difference ? 0 : 1; }
+
+        template<class Model>
+        static double _time(Model& model, const state_type& phi0, size_t repeats)
+        {
+            using clock = std::chrono::steady_clock;
+
+            state_type dphi;
+
+            //The first call sets up plans and pages, which later calls never pay for
+            model(phi0, dphi, 0.);
+
+            const auto start = clock::now();
+            for (size_t i = 0; i < repeats; ++i)
+                model(phi0, dphi, 0.);
+
+            return std::chrono::duration<double>(clock::now() - start).count() / repeats;
+        }
+
+        //Largest |eigenvalue| of the jacobian at phi0, from directional differences of the model
+        template<class Model>
+        static double _power_iteration(Model& model, const state_type& phi0, size_t iterations = 10)
+        {
+            static constexpr size_t rows = state_type::rows();
+            static constexpr size_t cols = state_type::cols();
+
+            state_type direction, perturbed, base, image;
+
+            for (size_t row = 0; row < rows; ++row)
+                for (size_t col = 0; col < cols; ++col)
+                    direction(row, col) = (row + col) % 2 == 0 ? 1 : -1;
+
+            model(phi0, base, 0.);
+
+            value_type phi_norm_sq = 0;
+            for (value_type value : phi0)
+                phi_norm_sq += value * value;
+
+            //Of the order of the square root of machine epsilon, relative to phi0
+            const value_type epsilon = std::sqrt(std::numeric_limits<value_type>::epsilon())
+                * std::max<value_type>(1, std::sqrt(phi_norm_sq / state_type::size()));
+
+            double radius = 0.;
+            for (size_t iteration = 0; iteration < iterations; ++iteration) {
+                value_type direction_norm_sq = 0;
+                for (value_type value : direction)
+                    direction_norm_sq += value * value;
+
+                const value_type scale = epsilon / std::sqrt(direction_norm_sq / state_type::size());
+
+                for (size_t i = 0; i < state_type::size(); ++i)
+                    perturbed.data()[i] = phi0.data()[i] + scale * direction.data()[i];
+
+                model(perturbed, image, 0.);
+
+                value_type image_norm_sq = 0;
+                for (size_t i = 0; i < state_type::size(); ++i) {
+                    image.data()[i] = (image.data()[i] - base.data()[i]) / scale;
+                    image_norm_sq += image.data()[i] * image.data()[i];
+                }
+
+                radius = std::sqrt(image_norm_sq / direction_norm_sq);
+                if (!(radius > 0))
+                    break;
+
+                std::swap(direction, image);
+            }
+
+            return radius;
+        }
+
+    private:
+        FiniteDifference _finite_difference;
+        Spectral _spectral;
+
+        value_type _tolerance;
+        double _check_interval;
+
+        double _seconds_per_rhs[2];
+        double _spectral_radius[2];
+
+        hybrid_method _method;
+        double _next_check = -std::numeric_limits<double>::infinity();
+        value_type _difference = 0;
+
+        state_type _reference, _other;
+        std::vector<switch_event> _switches;
+    };
+
+}
+
+#endif // !LLPS_CALCULUS_HYBRID_HPP_INCLUDED
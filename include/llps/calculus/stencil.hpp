@@ -0,0 +1,486 @@
+#ifndef LLPS_CALCULUS_STENCIL_HPP_INCLUDED
+#define LLPS_CALCULUS_STENCIL_HPP_INCLUDED
+
+#include <array>       //Access to std::array
+#include <cstddef>     //Access to size_t and ptrdiff_t
+#include <utility>     //Access to std::index_sequence
+#include <algorithm>   //Access to std::max, std::min and std::clamp
+#include <type_traits> //Access to std::is_arithmetic_v
+#include <optional>    //Access to std::optional
+
+#include "finite_difference.hpp"
+#include "differentiate.hpp"
+#include "../boundary.hpp"
+#include "../grid.hpp"
+
+namespace llps::calculus {
+
+    /*
+    * Partial derivative d^(x_order + y_order) / dx^x_order dy^y_order, the
+    * term of a stencil expression. The usual ones are predefined below, and
+    * combine with scalar weights, + and - into any linear operator with
+    * constant coefficients:
+    *   auto expression = a * D_xx + b * D_yy - k * (D_xxxx + 2 * D_xxyy + D_yyyy);
+    */
+    template<size_t _x_order, size_t _y_order>
+    struct partial
+    {
+        static constexpr size_t x_order = _x_order;
+        static constexpr size_t y_order = _y_order;
+    };
+
+    inline constexpr partial<1, 0> D_x;
+    inline constexpr partial<0, 1> D_y;
+    inline constexpr partial<2, 0> D_xx;
+    inline constexpr partial<0, 2> D_yy;
+    inline constexpr partial<1, 1> D_xy;
+    inline constexpr partial<4, 0> D_xxxx;
+    inline constexpr partial<0, 4> D_yyyy;
+    inline constexpr partial<2, 2> D_xxyy;
+
+    //Weighted sum of partial derivatives, one weight per term (repeats allowed)
+    template<class... Partials>
+    struct stencil_expression
+    {
+        std::array<double, sizeof...(Partials)> weights;
+    };
+
+    template<class Type>
+    struct _is_stencil_term : std::false_type {};
+
+    template<size_t x_order, size_t y_order>
+    struct _is_stencil_term<partial<x_order, y_order>> : std::true_type {};
+
+    template<class... Partials>
+    struct _is_stencil_term<stencil_expression<Partials...>> : std::true_type {};
+
+    template<class Type>
+    concept stencil_term = _is_stencil_term<Type>::value;
+
+    template<size_t x_order, size_t y_order>
+    constexpr auto as_expression(partial<x_order, y_order>)
+    {
+        return stencil_expression<partial<x_order, y_order>>{ { 1. } };
+    }
+
+    template<class... Partials>
+    constexpr auto as_expression(const stencil_expression<Partials...>& expression)
+    {
+        return expression;
+    }
+
+    template<class Weight, stencil_term Term> requires std::is_arithmetic_v<Weight>
+    constexpr auto operator*(Weight weight, const Term& term)
+    {
+        auto result = as_expression(term);
+        for (double& term_weight : result.weights)
+            term_weight *= static_cast<double>(weight);
+
+        return result;
+    }
+
+    template<stencil_term Term, class Weight> requires std::is_arithmetic_v<Weight>
+    constexpr auto operator*(const Term& term, Weight weight)
+    {
+        return weight * term;
+    }
+
+    template<stencil_term Term>
+    constexpr auto operator-(const Term& term)
+    {
+        return -1. * term;
+    }
+
+    template<stencil_term Lhs, stencil_term Rhs>
+    constexpr auto operator+(const Lhs& lhs, const Rhs& rhs)
+    {
+        return []<class... L, class... R>(const stencil_expression<L...>& lhs, const stencil_expression<R...>& rhs) {
+            stencil_expression<L..., R...> result;
+
+            for (size_t i = 0; i < sizeof...(L); ++i)
+                result.weights[i] = lhs.weights[i];
+            for (size_t i = 0; i < sizeof...(R); ++i)
+                result.weights[sizeof...(L) + i] = rhs.weights[i];
+
+            return result;
+        }(as_expression(lhs), as_expression(rhs));
+    }
+
+    template<stencil_term Lhs, stencil_term Rhs>
+    constexpr auto operator-(const Lhs& lhs, const Rhs& rhs)
+    {
+        return lhs + -rhs;
+    }
+
+    //Points of the central difference of a derivative_order-th derivative accurate to error_order
+    consteval size_t central_points(size_t derivative_order, size_t error_order)
+    {
+        return derivative_order == 0 ? 1 : 2 * ((derivative_order + 1) / 2) - 1 + error_order;
+    }
+
+    //Central difference weights of a derivative_order-th derivative, from -points/2 to points/2
+    template<size_t derivative_order, size_t error_order>
+    consteval auto central_stencil()
+    {
+        static_assert((error_order & 1) == 0, "error order must be even for central finite difference!");
+
+        constexpr size_t points = central_points(derivative_order, error_order);
+
+        if constexpr (derivative_order == 0) {
+            return std::array<double, 1>{ 1. };
+        }
+        else {
+            std::array<ptrdiff_t, points> samples{};
+            for (size_t i = 0; i < points; ++i)
+                samples[i] = static_cast<ptrdiff_t>(i) - static_cast<ptrdiff_t>(points / 2);
+
+            return fd_stencil<double>(derivative_order, samples);
+        }
+    }
+
+    /*
+    * Periodic finite difference operator of a 2D stencil_expression, every
+    * term accurate to error_order, as one stencil.
+    *
+    * The terms are tensor products of central differences along x and y. At
+    * compile time, they are laid over each other to find the points of the
+    * merged stencil, those where any term has a nonzero weight; on
+    * construction, the weights, spacings and term coefficients are summed
+    * into a single coefficient per point. Applying it is then one pass over
+    * the grid, tiled and vectorised as laplacian_central_fd, with the sum
+    * over points unrolled. D_xx + D_yy reads the same 2 error_order + 1
+    * points as laplacian_central_fd. A direct biharmonic is one pass rather
+    * than two, but over the whole square its terms cover (53 points at
+    * order 6), so it only beats two laplacians at low orders.
+    *
+    * Rows are read through pointers, so must be contiguous, as they are in
+    * grids and their subgrid views. A padded_grid input is read through its
+    * ghost cells instead of wrapping, so whatever boundary_conditions filled
+    * them apply, and every column takes the vectorised loop.
+    *
+    * tile overrides the estimated tile size, see fd2D_tile.
+    */
+    template<size_t error_order, class... Partials>
+    class stencil_operator
+    {
+    public:
+        using expression_type = stencil_expression<Partials...>;
+
+        //Largest reach of any term, in either direction
+        static constexpr size_t radius = std::max({ size_t(0),
+            central_points(Partials::x_order, error_order) / 2 ...,
+            central_points(Partials::y_order, error_order) / 2 ... });
+
+        static constexpr size_t width = 2 * radius + 1;
+
+    private:
+        //Unweighted coefficients of Partial, on the width x width square around the point
+        template<class Partial>
+        static consteval std::array<double, width * width> _unit_table()
+        {
+            constexpr auto x_stencil = central_stencil<Partial::x_order, error_order>();
+            constexpr auto y_stencil = central_stencil<Partial::y_order, error_order>();
+
+            constexpr size_t x_offset = radius - x_stencil.size() / 2;
+            constexpr size_t y_offset = radius - y_stencil.size() / 2;
+
+            std::array<double, width * width> table{};
+            for (size_t j = 0; j < y_stencil.size(); ++j)
+                for (size_t i = 0; i < x_stencil.size(); ++i)
+                    table[(y_offset + j) * width + x_offset + i] = y_stencil[j] * x_stencil[i];
+
+            return table;
+        }
+
+        static constexpr std::array<std::array<double, width * width>, sizeof...(Partials)> _units{ _unit_table<Partials>()... };
+
+        static constexpr bool _used(size_t index)
+        {
+            for (const auto& table : _units)
+                if (table[index] != 0.)
+                    return true;
+
+            return false;
+        }
+
+        static consteval size_t _count()
+        {
+            size_t count = 0;
+            for (size_t index = 0; index < width * width; ++index)
+                count += _used(index) ? 1 : 0;
+
+            return count;
+        }
+
+    public:
+        //Points read per output, after merging
+        static constexpr size_t points = _count();
+
+    private:
+        //Position of each point in the width x width square
+        static constexpr std::array<size_t, points> _index = [] {
+            std::array<size_t, points> result{};
+            for (size_t index = 0, point = 0; index < width * width; ++index)
+                if (_used(index))
+                    result[point++] = index;
+
+            return result;
+        }();
+
+    public:
+        stencil_operator(const expression_type& expression, double dx, double dy, fd2D_tile tile = {}) :
+            _coefficients{}, _tile(tile)
+        {
+            const std::array<size_t, sizeof...(Partials)> x_orders{ Partials::x_order... };
+            const std::array<size_t, sizeof...(Partials)> y_orders{ Partials::y_order... };
+
+            for (size_t term = 0; term < sizeof...(Partials); ++term) {
+                double scale = expression.weights[term];
+                for (size_t i = 0; i < x_orders[term]; ++i)
+                    scale /= dx;
+                for (size_t i = 0; i < y_orders[term]; ++i)
+                    scale /= dy;
+
+                for (size_t point = 0; point < points; ++point)
+                    _coefficients[point] += scale * _units[term][_index[point]];
+            }
+        }
+
+    public:
+        //Row and column offset of a point of the merged stencil, and its coefficient
+        static constexpr ptrdiff_t row_offset(size_t point) { return static_cast<ptrdiff_t>(_index[point] / width) - static_cast<ptrdiff_t>(radius); }
+        static constexpr ptrdiff_t col_offset(size_t point) { return static_cast<ptrdiff_t>(_index[point] % width) - static_cast<ptrdiff_t>(radius); }
+        double coefficient(size_t point) const noexcept { return _coefficients[point]; }
+
+        template<grid2D_like InGrid, grid2D_like OutGrid>
+        void operator()(const InGrid& phi, OutGrid& dphi) const
+        {
+            (*this)(phi, dphi, [](size_t, size_t, size_t) {});
+        }
+
+        /*
+        * As above, invoking epilogue(row, col_begin, col_end) on every row
+        * segment of dphi once it is written, while it is still in cache, so
+        * pointwise work on the result needs no pass over the grid of its own.
+        */
+        template<grid2D_like InGrid, grid2D_like OutGrid, class Epilogue>
+        void operator()(const InGrid& phi, OutGrid& dphi, Epilogue&& epilogue) const
+        {
+            _apply(phi, dphi, epilogue, std::make_index_sequence<points>{});
+        }
+
+    private:
+        template<grid2D_like InGrid, grid2D_like OutGrid, class Epilogue, size_t... Points>
+        void _apply(const InGrid& phi, OutGrid& dphi, Epilogue& epilogue, std::index_sequence<Points...>) const
+        {
+            using value_type = typename OutGrid::value_type;
+
+            const fd2D_tile tile = _tile.resolve<2 * radius, value_type>();
+
+            const size_t rows = dphi.rows();
+            const size_t cols = dphi.cols();
+
+            const ptrdiff_t bands = static_cast<ptrdiff_t>((rows + tile.rows - 1) / tile.rows);
+            const ptrdiff_t blocks = static_cast<ptrdiff_t>((cols + tile.cols - 1) / tile.cols);
+
+            //Local, so that writes to dphi can not be taken to alias them
+            const std::array<value_type, points> coefficients{ static_cast<value_type>(_coefficients[Points])... };
+
+            //Columns whose stencil stays within the row
+            const size_t interior_begin = std::min(radius, cols);
+            const size_t interior_end = cols > radius ? std::max(cols - radius, interior_begin) : interior_begin;
+
+            #pragma omp parallel for collapse(2) schedule(static)
+            for (ptrdiff_t band = 0; band < bands; ++band)
+            {
+                for (ptrdiff_t block = 0; block < blocks; ++block)
+                {
+                    const size_t row_begin = band * tile.rows;
+                    const size_t row_end = std::min(row_begin + tile.rows, rows);
+                    const size_t col_begin = block * tile.cols;
+                    const size_t col_end = std::min(col_begin + tile.cols, cols);
+
+                    if constexpr (is_padded_grid_v<InGrid>) {
+                        static_assert(InGrid::halo() >= radius, "halo of the padded grid is narrower than the stencil");
+
+                        for (size_t row = row_begin; row < row_end; ++row)
+                        {
+                            //Each pointing radius columns before the first, into the ghost cells
+                            std::array<const value_type*, width> row_ptrs;
+                            for (size_t i = 0; i < width; ++i)
+                                row_ptrs[i] = &phi.at(static_cast<ptrdiff_t>(row + i) - static_cast<ptrdiff_t>(radius), -static_cast<ptrdiff_t>(radius));
+
+                            value_type* out = &dphi(row, 0);
+
+                            #pragma omp simd
+                            for (size_t col = col_begin; col < col_end; ++col)
+                                out[col] = ((coefficients[Points] * row_ptrs[_index[Points] / width][col + _index[Points] % width]) + ...);
+
+                            epilogue(row, col_begin, col_end);
+                        }
+
+                        continue;
+                    }
+
+                    for (size_t row = row_begin; row < row_end; ++row)
+                    {
+                        std::array<const value_type*, width> row_ptrs;
+                        for (size_t i = 0; i < width; ++i)
+                            row_ptrs[i] = &phi(_wrap_back(row + i, radius, rows), 0);
+
+                        value_type* out = &dphi(row, 0);
+
+                        const size_t first = std::clamp(interior_begin, col_begin, col_end);
+                        const size_t last = std::clamp(interior_end, first, col_end);
+
+                        auto edge = [&](size_t col) {
+                            out[col] = ((coefficients[Points] * row_ptrs[_index[Points] / width][_wrap_back(col + _index[Points] % width, radius, cols)]) + ...);
+                        };
+
+                        for (size_t col = col_begin; col < first; ++col)
+                            edge(col);
+
+                        #pragma omp simd
+                        for (size_t col = first; col < last; ++col)
+                            out[col] = ((coefficients[Points] * row_ptrs[_index[Points] / width][col + _index[Points] % width - radius]) + ...);
+
+                        for (size_t col = last; col < col_end; ++col)
+                            edge(col);
+
+                        epilogue(row, col_begin, col_end);
+                    }
+                }
+            }
+        }
+
+    private:
+        std::array<double, points> _coefficients;
+        fd2D_tile _tile;
+    };
+
+    template<size_t error_order, class... Partials>
+    auto make_stencil_operator(const stencil_expression<Partials...>& expression, double dx, double dy, fd2D_tile tile = {})
+    {
+        return stencil_operator<error_order, Partials...>(expression, dx, dy, tile);
+    }
+
+    template<size_t error_order, size_t x_order, size_t y_order>
+    auto make_stencil_operator(partial<x_order, y_order> term, double dx, double dy, fd2D_tile tile = {})
+    {
+        return make_stencil_operator<error_order>(as_expression(term), dx, dy, tile);
+    }
+
+    //The 3x3 stencils of the compact laplacians
+    using compact_laplacian_operator = stencil_operator<2, partial<2, 0>, partial<0, 2>, partial<2, 2>>;
+
+    /*
+    * Isotropic 9 point laplacian, second order like the 5 point one but with
+    * an error of (dx^2 d_xx + dy^2 d_yy) nabla^2 / 12, which for dx = dy is
+    * h^2 nabla^4 / 12 and so does not depend on direction. The corners are
+    * the D_xxyy term, (dx^2 + dy^2) / 12 of it, weights 1/6, 4/6 and -20/6
+    * over h^2 for a square grid.
+    */
+    inline compact_laplacian_operator make_isotropic_laplacian(double dx, double dy, fd2D_tile tile = {})
+    {
+        return make_stencil_operator<2>(D_xx + D_yy + (dx * dx + dy * dy) / 12. * D_xxyy, dx, dy, tile);
+    }
+
+    /*
+    * Fourth order compact (Mehrstellen) laplacian. The error of the
+    * isotropic laplacian L is itself a laplacian of L to leading order, so
+    *   nabla^2 phi = (1 - (dx^2 D_xx + dy^2 D_yy) / 12) L phi + O(h^4),
+    * the correction being 5 points. Both passes only reach the nearest
+    * neighbours, reading 14 points per output, and L phi is kept between
+    * them in a Scratch owned by the operator. Merged into one stencil, the
+    * correction of L would reach 21 points, which costs more than the extra
+    * pass saves.
+    *
+    * Like stencil_operator, it takes an epilogue, run on the rows of the
+    * correction as they are written. Periodic only: L phi has no ghost cells
+    * for a padded_grid's boundary conditions to fill.
+    */
+    template<grid2D_like Scratch>
+    class mehrstellen_laplacian
+    {
+    public:
+        //Reach of the two passes together
+        static constexpr size_t radius = 2;
+
+    public:
+        mehrstellen_laplacian(double dx, double dy, fd2D_tile tile = {}) :
+            _isotropic(make_isotropic_laplacian(dx, dy, tile)),
+            _correction(make_stencil_operator<2>(partial<0, 0>{} - dx * dx / 12. * D_xx - dy * dy / 12. * D_yy, dx, dy, tile)),
+            _spacings{ dx, dy } {}
+
+    public:
+        template<grid2D_like InGrid, grid2D_like OutGrid>
+        void operator()(const InGrid& phi, OutGrid& dphi)
+        {
+            (*this)(phi, dphi, [](size_t, size_t, size_t) {});
+        }
+
+        template<grid2D_like InGrid, grid2D_like OutGrid, class Epilogue>
+        void operator()(const InGrid& phi, OutGrid& dphi, Epilogue&& epilogue)
+        {
+            static_assert(!is_padded_grid_v<InGrid>, "the Mehrstellen laplacian is periodic only!");
+
+            _isotropic(phi, _scratch);
+            _correction(_scratch, dphi, epilogue);
+        }
+
+        const std::array<double, 2>& spacings() const noexcept { return _spacings; }
+
+    private:
+        using _correction_type = stencil_operator<2, partial<0, 0>, partial<2, 0>, partial<0, 2>>;
+
+        compact_laplacian_operator _isotropic;
+        _correction_type _correction;
+        std::array<double, 2> _spacings;
+
+        Scratch _scratch;
+    };
+
+    template<grid2D_like InGrid, grid2D_like OutGrid>
+    void laplacian_isotropic(const InGrid& phi, OutGrid& dphi, double dx, double dy)
+    {
+        make_isotropic_laplacian(dx, dy)(phi, dphi);
+    }
+
+    template<class Meta>
+    auto laplacian_isotropic(const llps::_basic_grid<Meta>& phi, double dx, double dy)
+    {
+        llps::_basic_grid<Meta> dphi;
+        laplacian_isotropic(phi, dphi, dx, dy);
+
+        return dphi;
+    }
+
+    /*
+    * Through the operator of the spacings it was last called with on this
+    * thread, for this shape, so that repeated calls reuse its scratch.
+    */
+    template<grid2D_like InGrid, grid2D_like OutGrid>
+    void laplacian_mehrstellen(const InGrid& phi, OutGrid& dphi, double dx, double dy)
+    {
+        using scratch_type = llps::grid<typename OutGrid::value_type, OutGrid::rows(), OutGrid::cols()>;
+
+        thread_local std::optional<mehrstellen_laplacian<scratch_type>> cached;
+
+        if (!cached || cached->spacings() != std::array{ dx, dy })
+            cached.emplace(dx, dy);
+
+        (*cached)(phi, dphi);
+    }
+
+    template<class Meta>
+    auto laplacian_mehrstellen(const llps::_basic_grid<Meta>& phi, double dx, double dy)
+    {
+        llps::_basic_grid<Meta> dphi;
+        laplacian_mehrstellen(phi, dphi, dx, dy);
+
+        return dphi;
+    }
+
+}
+
+#endif // !LLPS_CALCULUS_STENCIL_HPP_INCLUDED
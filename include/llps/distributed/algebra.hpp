@@ -0,0 +1,73 @@
+#ifndef LLPS_DISTRIBUTED_ALGEBRA_HPP_INCLUDED
+#define LLPS_DISTRIBUTED_ALGEBRA_HPP_INCLUDED
+
+#include <boost/numeric/odeint/algebra/range_algebra.hpp>
+#include <boost/numeric/odeint/algebra/norm_result_type.hpp>
+#include <boost/numeric/odeint/util/is_resizeable.hpp>
+#include <boost/numeric/odeint/util/same_size.hpp>
+#include <boost/numeric/odeint/util/resize.hpp>
+
+#include <mpi.h>
+
+#include "slab_grid.hpp"
+
+namespace llps::distributed {
+
+    /*
+    * odeint algebra for slab_grid states. Element-wise operations only touch
+    * the rows owned by each rank, as in range_algebra. norm_inf is reduced over
+    * the grid's communicator, so that every rank sees the same error estimate
+    * and the adaptive steppers stay in lock-step.
+    */
+    struct slab_algebra : public boost::numeric::odeint::range_algebra
+    {
+        template<class SlabGrid>
+        static typename boost::numeric::odeint::norm_result_type<typename SlabGrid::value_type>::type norm_inf(const SlabGrid& s)
+        {
+            using result_type = typename boost::numeric::odeint::norm_result_type<typename SlabGrid::value_type>::type;
+
+            result_type local = static_cast<result_type>(boost::numeric::odeint::range_algebra::norm_inf(s));
+            result_type global;
+
+            MPI_Allreduce(&local, &global, 1, mpi_type<result_type>::get(), MPI_MAX, s.communicator());
+
+            return global;
+        }
+    };
+
+}
+
+namespace boost::numeric::odeint {
+
+    /*
+    * odeint default constructs the temporaries of its steppers, binding them
+    * to MPI_COMM_WORLD, then resizes them from the state if it is resizeable.
+    * Resizing rebinds them to the state's communicator, so stage states and
+    * norm_inf reductions of a run on any communicator stay on it.
+    */
+    template<class Type, size_t _rows, size_t _cols, size_t _halo, class Container>
+    struct is_resizeable<llps::distributed::slab_grid<Type, _rows, _cols, _halo, Container>>
+    {
+        using type = boost::true_type;
+        static const bool value = type::value;
+    };
+
+    template<class Type, size_t _rows, size_t _cols, size_t _halo, class Container>
+    struct same_size_impl<llps::distributed::slab_grid<Type, _rows, _cols, _halo, Container>, llps::distributed::slab_grid<Type, _rows, _cols, _halo, Container>>
+    {
+        using slab_type = llps::distributed::slab_grid<Type, _rows, _cols, _halo, Container>;
+
+        static bool same_size(const slab_type& x, const slab_type& y) { return x.same_layout(y); }
+    };
+
+    template<class Type, size_t _rows, size_t _cols, size_t _halo, class Container>
+    struct resize_impl<llps::distributed::slab_grid<Type, _rows, _cols, _halo, Container>, llps::distributed::slab_grid<Type, _rows, _cols, _halo, Container>>
+    {
+        using slab_type = llps::distributed::slab_grid<Type, _rows, _cols, _halo, Container>;
+
+        static void resize(slab_type& x, const slab_type& y) { x.resize(y); }
+    };
+
+}
+
+#endif // !LLPS_DISTRIBUTED_ALGEBRA_HPP_INCLUDED
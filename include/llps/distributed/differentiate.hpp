@@ -0,0 +1,84 @@
+#ifndef LLPS_DISTRIBUTED_DIFFERENTIATE_HPP_INCLUDED
+#define LLPS_DISTRIBUTED_DIFFERENTIATE_HPP_INCLUDED
+
+#include <array>   //Access to std::array
+#include <cstddef> //Access to ptrdiff_t
+
+#include "../calculus/finite_difference.hpp"
+#include "../calculus/differentiate.hpp"
+#include "slab_grid.hpp"
+
+namespace llps::distributed {
+
+    /*
+    * Laplacian of the owned rows [first_row, last_row) of phi, halos
+    * included, tiled and computed segment by segment as in the serial
+    * laplacian_central_fd.
+    */
+    template<size_t error_order, class InGrid, class OutGrid>
+    void _laplacian_central_fd_rows(
+        const InGrid& phi, OutGrid& dphi,
+        ptrdiff_t first_row, ptrdiff_t last_row,
+        typename OutGrid::value_type dx,
+        typename OutGrid::value_type dy)
+    {
+        using value_type = typename OutGrid::value_type;
+
+        static constexpr auto stencil = llps::calculus::central_fd_stencil<error_order, value_type>(2);
+        static constexpr ptrdiff_t offset = error_order / 2;
+        static constexpr size_t cols = OutGrid::cols();
+
+        if (last_row <= first_row)
+            return;
+
+        std::array<value_type, error_order + 1> x_weights, y_weights;
+        for (size_t i = 0; i <= error_order; ++i) {
+            x_weights[i] = stencil[i] / (dx * dx);
+            y_weights[i] = stencil[i] / (dy * dy);
+        }
+
+        const size_t rows = static_cast<size_t>(last_row - first_row);
+        const auto tile = llps::calculus::fd2D_tile{}.resolve<error_order, value_type>();
+
+        llps::calculus::_fd2D_for_each_segment(rows, cols, tile, [&](size_t segment_row, size_t col_begin, size_t col_end) {
+            const ptrdiff_t row = first_row + static_cast<ptrdiff_t>(segment_row);
+
+            std::array<const value_type*, error_order + 1> row_ptrs;
+            for (ptrdiff_t i = 0; i <= static_cast<ptrdiff_t>(error_order); ++i)
+                row_ptrs[i] = phi.row_data(row + i - offset);
+
+            llps::calculus::_laplacian_fd_segment<error_order>(row_ptrs, dphi.data() + row * cols + col_begin, col_begin, col_end, cols, x_weights, y_weights);
+        });
+    }
+
+    /*
+    * Periodic central difference laplacian of a row decomposed grid. The halo
+    * exchange is posted first and the rows which do not depend on it are
+    * computed while it is in flight; the error_order/2 rows at either edge of
+    * the slab are computed once it has completed.
+    */
+    template<size_t error_order, class Type, size_t _rows, size_t _cols, size_t _halo, class Container1, class Container2>
+    void laplacian_central_fd(
+        const slab_grid<Type, _rows, _cols, _halo, Container1>& phi,
+              slab_grid<Type, _rows, _cols, _halo, Container2>& dphi,
+        Type dx, Type dy)
+    {
+        static_assert(_halo >= error_order / 2, "Halo is too narrow for the requested error order!");
+
+        static constexpr ptrdiff_t offset = error_order / 2;
+        const ptrdiff_t rows = static_cast<ptrdiff_t>(phi.rows());
+
+        halo_exchange exchange;
+        phi.start_halo_exchange(exchange);
+
+        _laplacian_central_fd_rows<error_order>(phi, dphi, offset, rows - offset, dx, dy);
+
+        exchange.wait();
+
+        _laplacian_central_fd_rows<error_order>(phi, dphi, 0, offset, dx, dy);
+        _laplacian_central_fd_rows<error_order>(phi, dphi, rows - offset, rows, dx, dy);
+    }
+
+}
+
+#endif // !LLPS_DISTRIBUTED_DIFFERENTIATE_HPP_INCLUDED
@@ -0,0 +1,337 @@
+#ifndef LLPS_DISTRIBUTED_FOURIER_SPECTRAL_HPP_INCLUDED
+#define LLPS_DISTRIBUTED_FOURIER_SPECTRAL_HPP_INCLUDED
+
+#include <vector>    //Access to std::vector
+#include <array>     //Access to std::array
+#include <algorithm> //Access to std::min
+#include <numbers>   //Access to std::numbers::pi
+#include <cstddef>   //Access to ptrdiff_t
+#include <utility>   //Access to std::pair
+#include <optional>  //Access to std::optional
+
+#include <mpi.h>
+
+#include "../calculus/fourier_spectral.hpp"
+#include "../fft/fft.hpp"
+#include "slab_grid.hpp"
+
+namespace llps::distributed {
+
+    /*
+    * Slab decomposed 2D real-to-complex FFT, following the row decomposition
+    * of slab_grid.
+    *
+    * The forward transform runs 1D r2c transforms along each owned row, then
+    * transposes so that every rank owns a contiguous block of x-wavenumbers
+    * (kx) with all of their rows, and finishes with 1D c2c transforms down the
+    * columns. Spectral coefficients are therefore stored kx-major: element
+    * (kx, row) of the local block is at spectrum()[kx * _rows + row]. The
+    * backward transform reverses these steps.
+    *
+    * The transposes are split into pipeline_depth chunks of rows, each sent with
+    * a non-blocking all-to-all. Forwards, chunk c is in flight while the row
+    * transforms of chunk c + 1 are computed; backwards, the row transforms of
+    * chunk c run while chunk c + 1 is still arriving.
+    *
+    * Plans and buffers are created once, on construction.
+    */
+    template<size_t _rows, size_t _cols, size_t pipeline_depth = 4>
+    struct slab_fft
+    {
+    public:
+        using value_type = double;
+        using complex_type = fft::complex<double>;
+
+        static constexpr size_t freq_cols = _cols / 2 + 1;
+
+    public:
+        explicit slab_fft(MPI_Comm comm = MPI_COMM_WORLD):
+            _comm(comm),
+            //Single row plan, executed on each row in turn
+            _row_plan({ _cols }, 1, { .unaligned = true })
+        {
+            MPI_Comm_rank(_comm, &_rank);
+            MPI_Comm_size(_comm, &_ranks);
+
+            _row_counts.resize(_ranks);
+            _row_offsets.resize(_ranks);
+            _freq_counts.resize(_ranks);
+            _freq_offsets.resize(_ranks);
+
+            for (int rank = 0; rank < _ranks; ++rank) {
+                _split(_rows, rank, _row_counts[rank], _row_offsets[rank]);
+                _split(freq_cols, rank, _freq_counts[rank], _freq_offsets[rank]);
+            }
+
+            _transpose_layout.resize(4 * pipeline_depth * _ranks);
+
+            const size_t local_rows = _row_counts[_rank];
+            const size_t local_freqs = _freq_counts[_rank];
+
+            //Transpose buffers are used in both directions, so must fit either layout
+            const size_t transpose_size = std::max<size_t>({ local_rows * freq_cols, local_freqs * _rows, 1 });
+
+            _rows_hat = fft::allocate<complex_type>(std::max<size_t>(local_rows * freq_cols, 1));
+            _spectrum = fft::allocate<complex_type>(std::max<size_t>(local_freqs * _rows, 1));
+            _send     = fft::allocate<complex_type>(transpose_size);
+            _recv     = fft::allocate<complex_type>(transpose_size);
+
+            _col_plan.emplace(std::vector<size_t>{ _rows }, local_freqs, fft::plan_options{ .in_place = true });
+        }
+
+        slab_fft(const slab_fft&) = delete;
+        slab_fft& operator=(const slab_fft&) = delete;
+
+        ~slab_fft()
+        {
+            fft::deallocate(_rows_hat);
+            fft::deallocate(_spectrum);
+            fft::deallocate(_send);
+            fft::deallocate(_recv);
+        }
+
+    public:
+        size_t local_freqs() const noexcept { return _freq_counts[_rank]; }
+        size_t freq_offset() const noexcept { return _freq_offsets[_rank]; }
+
+              complex_type* spectrum()       noexcept { return _spectrum; }
+        const complex_type* spectrum() const noexcept { return _spectrum; }
+
+    public:
+        template<size_t _halo, class Container>
+        void forward(const slab_grid<value_type, _rows, _cols, _halo, Container>& phi)
+        {
+            std::array<MPI_Request, pipeline_depth> requests;
+
+            size_t send_offset = 0, recv_offset = 0;
+            for (size_t chunk = 0; chunk < pipeline_depth; ++chunk)
+            {
+                const auto [first, last] = _chunk(_rank, chunk);
+                auto [send_counts, send_displs, recv_counts, recv_displs] = _layout(chunk);
+
+                for (size_t row = first; row < last; ++row)
+                    _row_plan.forward(phi.data() + row * _cols, _rows_hat + row * freq_cols);
+
+                //Pack the chunk, destination by destination, as (chunk rows) x (destination's kx block)
+                complex_type* send = _send + send_offset;
+                for (int rank = 0; rank < _ranks; ++rank) {
+                    send_displs[rank] = static_cast<int>(2 * (send - _send - send_offset));
+                    send_counts[rank] = static_cast<int>(2 * (last - first) * _freq_counts[rank]);
+
+                    for (size_t row = first; row < last; ++row)
+                        for (size_t freq = 0; freq < _freq_counts[rank]; ++freq, ++send)
+                            _copy(_rows_hat[row * freq_cols + _freq_offsets[rank] + freq], *send);
+                }
+
+                complex_type* recv = _recv + recv_offset;
+                size_t recv_size = 0;
+                for (int rank = 0; rank < _ranks; ++rank) {
+                    const auto [rank_first, rank_last] = _chunk(rank, chunk);
+
+                    recv_displs[rank] = static_cast<int>(2 * recv_size);
+                    recv_counts[rank] = static_cast<int>(2 * (rank_last - rank_first) * local_freqs());
+                    recv_size += (rank_last - rank_first) * local_freqs();
+                }
+
+                MPI_Ialltoallv(
+                    _send + send_offset, send_counts, send_displs, MPI_DOUBLE,
+                    recv, recv_counts, recv_displs, MPI_DOUBLE,
+                    _comm, &requests[chunk]);
+
+                send_offset += (last - first) * freq_cols;
+                recv_offset += recv_size;
+            }
+
+            MPI_Waitall(static_cast<int>(pipeline_depth), requests.data(), MPI_STATUSES_IGNORE);
+
+            //Unpack into kx-major columns
+            const complex_type* recv = _recv;
+            for (size_t chunk = 0; chunk < pipeline_depth; ++chunk) {
+                for (int rank = 0; rank < _ranks; ++rank) {
+                    const auto [first, last] = _chunk(rank, chunk);
+
+                    for (size_t row = first; row < last; ++row)
+                        for (size_t freq = 0; freq < local_freqs(); ++freq, ++recv)
+                            _copy(*recv, _spectrum[freq * _rows + _row_offsets[rank] + row]);
+                }
+            }
+
+            if (local_freqs() > 0)
+                _col_plan->forward(_spectrum, _spectrum);
+        }
+
+        template<size_t _halo, class Container>
+        void backward(slab_grid<value_type, _rows, _cols, _halo, Container>& phi)
+        {
+            if (local_freqs() > 0)
+                _col_plan->backward(_spectrum, _spectrum);
+
+            std::array<MPI_Request, pipeline_depth> requests;
+
+            //Post every chunk first, so that they travel while the earlier ones are transformed
+            complex_type* send = _send;
+            size_t recv_offset = 0;
+            for (size_t chunk = 0; chunk < pipeline_depth; ++chunk)
+            {
+                auto [send_counts, send_displs, recv_counts, recv_displs] = _layout(chunk);
+
+                const complex_type* chunk_send = send;
+                for (int rank = 0; rank < _ranks; ++rank) {
+                    const auto [first, last] = _chunk(rank, chunk);
+
+                    send_displs[rank] = static_cast<int>(2 * (send - chunk_send));
+                    send_counts[rank] = static_cast<int>(2 * (last - first) * local_freqs());
+
+                    for (size_t row = first; row < last; ++row)
+                        for (size_t freq = 0; freq < local_freqs(); ++freq, ++send)
+                            _copy(_spectrum[freq * _rows + _row_offsets[rank] + row], *send);
+                }
+
+                const auto [first, last] = _chunk(_rank, chunk);
+
+                size_t recv_size = 0;
+                for (int rank = 0; rank < _ranks; ++rank) {
+                    recv_displs[rank] = static_cast<int>(2 * recv_size);
+                    recv_counts[rank] = static_cast<int>(2 * (last - first) * _freq_counts[rank]);
+                    recv_size += (last - first) * _freq_counts[rank];
+                }
+
+                MPI_Ialltoallv(
+                    chunk_send, send_counts, send_displs, MPI_DOUBLE,
+                    _recv + recv_offset, recv_counts, recv_displs, MPI_DOUBLE,
+                    _comm, &requests[chunk]);
+
+                recv_offset += recv_size;
+            }
+
+            const complex_type* recv = _recv;
+            for (size_t chunk = 0; chunk < pipeline_depth; ++chunk)
+            {
+                MPI_Wait(&requests[chunk], MPI_STATUS_IGNORE);
+
+                const auto [first, last] = _chunk(_rank, chunk);
+
+                for (int rank = 0; rank < _ranks; ++rank)
+                    for (size_t row = first; row < last; ++row)
+                        for (size_t freq = 0; freq < _freq_counts[rank]; ++freq, ++recv)
+                            _copy(*recv, _rows_hat[row * freq_cols + _freq_offsets[rank] + freq]);
+
+                for (size_t row = first; row < last; ++row)
+                    _row_plan.backward(_rows_hat + row * freq_cols, phi.data() + row * _cols);
+            }
+        }
+
+    private:
+        //Same split as slab_grid: contiguous blocks, with the remainder spread over the first ranks
+        void _split(size_t size, int rank, size_t& count, size_t& offset) const
+        {
+            const size_t base = size / _ranks;
+            const size_t remainder = size % _ranks;
+
+            count = base + (static_cast<size_t>(rank) < remainder);
+            offset = rank * base + std::min<size_t>(rank, remainder);
+        }
+
+        /*
+        * Counts and displacements (in doubles) of the all-to-all of chunk. These
+        * must outlive the non-blocking collective, so each chunk has its own.
+        */
+        std::array<int*, 4> _layout(size_t chunk)
+        {
+            int* first = _transpose_layout.data() + 4 * chunk * _ranks;
+            return { first, first + _ranks, first + 2 * _ranks, first + 3 * _ranks };
+        }
+
+        //Local row range of chunk, on the given rank
+        std::pair<size_t, size_t> _chunk(int rank, size_t chunk) const
+        {
+            const size_t count = _row_counts[rank];
+            return { count * chunk / pipeline_depth, count * (chunk + 1) / pipeline_depth };
+        }
+
+        static void _copy(const complex_type& from, complex_type& to)
+        {
+            to[0] = from[0];
+            to[1] = from[1];
+        }
+
+    private:
+        MPI_Comm _comm;
+        int _rank = 0;
+        int _ranks = 1;
+
+        std::vector<size_t> _row_counts, _row_offsets;
+        std::vector<size_t> _freq_counts, _freq_offsets;
+        std::vector<int> _transpose_layout;
+
+        complex_type* _rows_hat;
+        complex_type* _spectrum;
+        complex_type* _send;
+        complex_type* _recv;
+
+        fft::real_plan<value_type> _row_plan;
+        //Its batch count is only known once the communicator has been split
+        std::optional<fft::complex_plan<value_type>> _col_plan;
+    };
+
+    /*
+    * Wavenumber table of the local block of a slab_fft spectrum, in its
+    * kx-major layout: -|k|^2, normalised such that a forward and backward
+    * transform give the laplacian. Built once per transform and spacings.
+    */
+    template<size_t _rows, size_t _cols>
+    struct slab_spectral_tables
+    {
+    public:
+        using table_type = std::vector<double, llps::_grid_default_alloc<double>>;
+
+    public:
+        template<size_t pipeline_depth>
+        slab_spectral_tables(const slab_fft<_rows, _cols, pipeline_depth>& fft, double dx, double dy) :
+            _laplacian(fft.local_freqs() * _rows)
+        {
+            const double x_freq_elem = 2. * std::numbers::pi / (_cols * dx);
+            const double y_freq_elem = 2. * std::numbers::pi / (_rows * dy);
+
+            static constexpr double normalisation = 1. / (_rows * _cols);
+
+            for (size_t freq = 0, i = 0; freq < fft.local_freqs(); ++freq)
+            {
+                const double kappa_x = x_freq_elem * (fft.freq_offset() + freq);
+
+                for (size_t row = 0; row < _rows; ++row, ++i) {
+                    const double kappa_y = y_freq_elem * llps::calculus::freq_index(row, _rows);
+                    _laplacian[i] = -(kappa_x * kappa_x + kappa_y * kappa_y) * normalisation;
+                }
+            }
+        }
+
+    public:
+        const table_type& laplacian() const noexcept { return _laplacian; }
+
+    private:
+        table_type _laplacian;
+    };
+
+    //Multiplies the local block of a slab_fft spectrum by the -|k|^2 of tables
+    template<size_t _rows, size_t _cols, size_t pipeline_depth>
+    void mult_herm_nfreq_squared(slab_fft<_rows, _cols, pipeline_depth>& fft, const slab_spectral_tables<_rows, _cols>& tables)
+    {
+        llps::calculus::mult_symbol(reinterpret_cast<double*>(fft.spectrum()), tables.laplacian().data(), tables.laplacian().size());
+    }
+
+    template<size_t _rows, size_t _cols, size_t pipeline_depth, size_t _halo, class Container1, class Container2>
+    void laplacian_spectral(
+        slab_fft<_rows, _cols, pipeline_depth>& fft,
+        const slab_spectral_tables<_rows, _cols>& tables,
+        const slab_grid<double, _rows, _cols, _halo, Container1>& phi,
+              slab_grid<double, _rows, _cols, _halo, Container2>& dphi)
+    {
+        fft.forward(phi);
+        mult_herm_nfreq_squared(fft, tables);
+        fft.backward(dphi);
+    }
+
+}
+
+#endif // !LLPS_DISTRIBUTED_FOURIER_SPECTRAL_HPP_INCLUDED
@@ -0,0 +1,281 @@
+#ifndef LLPS_DISTRIBUTED_SLAB_GRID_HPP_INCLUDED
+#define LLPS_DISTRIBUTED_SLAB_GRID_HPP_INCLUDED
+
+#include <vector>      //Access to std::vector
+#include <array>       //Access to std::array
+#include <cstddef>     //Access to ptrdiff_t
+#include <algorithm>   //Access to std::copy_n
+#include <string>      //Access to std::to_string
+#include <stdexcept>   //Access to std::invalid_argument
+#include <type_traits> //Access to std::is_same_v
+
+#include <mpi.h>
+
+#include "../grid.hpp"
+
+namespace llps::distributed {
+
+    template<typename Type>
+    struct mpi_type;
+
+    template<> struct mpi_type<float>       { static MPI_Datatype get() { return MPI_FLOAT; } };
+    template<> struct mpi_type<double>      { static MPI_Datatype get() { return MPI_DOUBLE; } };
+    template<> struct mpi_type<long double> { static MPI_Datatype get() { return MPI_LONG_DOUBLE; } };
+
+    /*
+    * Pending halo exchange of a slab_grid, completed by wait() (or on destruction).
+    */
+    struct halo_exchange
+    {
+    public:
+        halo_exchange() = default;
+
+        halo_exchange(const halo_exchange&) = delete;
+        halo_exchange& operator=(const halo_exchange&) = delete;
+
+        ~halo_exchange() { wait(); }
+
+    public:
+        void wait()
+        {
+            if (_pending) {
+                MPI_Waitall(static_cast<int>(_requests.size()), _requests.data(), MPI_STATUSES_IGNORE);
+                _pending = false;
+            }
+        }
+
+    private:
+        template<class, size_t, size_t, size_t, class>
+        friend struct slab_grid;
+
+        std::array<MPI_Request, 4> _requests{};
+        bool _pending = false;
+    };
+
+    /*
+    * Row (slab) decomposition of a periodic _rows x _cols grid over the ranks
+    * of an MPI communicator. Every rank owns a contiguous block of whole rows,
+    * plus _halo ghost rows above and below it which mirror the neighbouring
+    * ranks' boundary rows after a halo exchange.
+    *
+    * begin()/end() span only the owned rows, so the type can be used directly
+    * as an odeint state with slab_algebra. Halo rows live in separate (mutable)
+    * buffers, as they are a cache of other ranks' data rather than part of the
+    * state, and may be refreshed through a const grid.
+    */
+    template<
+        class Type,
+        size_t _rows,
+        size_t _cols,
+        size_t _halo,
+        class Container = std::vector<Type, _grid_default_alloc<Type>>>
+    struct slab_grid
+    {
+    public:
+        using underlying_type = Container;
+
+        using value_type      = typename underlying_type::value_type;
+        using reference       = typename underlying_type::reference;
+        using const_reference = typename underlying_type::const_reference;
+        using size_type       = size_t;
+
+        using iterator        = typename underlying_type::iterator;
+        using const_iterator  = typename underlying_type::const_iterator;
+
+        static_assert(std::is_same_v<Type, value_type>, "Container type mismatch!");
+
+    public:
+        /*
+        * Default constructed grids are bound to MPI_COMM_WORLD. Temporaries
+        * which odeint default constructs are rebound to the communicator of
+        * the state through resize (see algebra.hpp), as are copies.
+        *
+        * Throws std::invalid_argument if some rank of comm would own fewer
+        * than _halo rows, which the halo exchange sends.
+        */
+        explicit slab_grid(MPI_Comm comm = MPI_COMM_WORLD)
+        {
+            _bind(comm);
+        }
+
+    public:
+        bool same_layout(const slab_grid& other) const noexcept { return _comm == other._comm; }
+
+        //Rebinds to the communicator of other, and so takes its share of the rows
+        void resize(const slab_grid& other)
+        {
+            if (!same_layout(other))
+                _bind(other._comm);
+        }
+
+    public:
+        static consteval size_t global_rows() noexcept { return _rows; }
+        static consteval size_t cols() noexcept { return _cols; }
+        static consteval size_t halo() noexcept { return _halo; }
+
+        size_t rows() const noexcept { return _local_rows; }
+        size_t size() const noexcept { return _local_rows * _cols; }
+        size_t row_offset() const noexcept { return _row_offset; }
+
+        MPI_Comm communicator() const noexcept { return _comm; }
+        int rank() const noexcept { return _rank; }
+        int ranks() const noexcept { return _ranks; }
+
+    public:
+        LLPS_FORCE_INLINE const_reference operator()(size_type row, size_type column) const
+        {
+            return _underlying[column + row * _cols];
+        }
+
+        LLPS_FORCE_INLINE reference operator()(size_type row, size_type column)
+        {
+            return _underlying[column + row * _cols];
+        }
+
+        /*
+        * Pointer to a local row, where row may lie in [-_halo, rows() + _halo).
+        */
+        LLPS_FORCE_INLINE const value_type* row_data(ptrdiff_t row) const
+        {
+            if (row < 0)
+                return _halo_above.data() + (row + static_cast<ptrdiff_t>(_halo)) * _cols;
+            if (row >= static_cast<ptrdiff_t>(_local_rows))
+                return _halo_below.data() + (row - static_cast<ptrdiff_t>(_local_rows)) * _cols;
+
+            return _underlying.data() + row * _cols;
+        }
+
+    public:
+        iterator begin()              { return _underlying.begin(); };
+        const_iterator begin()  const { return _underlying.cbegin(); };
+        const_iterator cbegin() const { return _underlying.begin(); };
+
+        iterator end()              { return _underlying.end(); };
+        const_iterator end()  const { return _underlying.cend(); };
+        const_iterator cend() const { return _underlying.end(); };
+
+    public:
+              value_type* data()       { return _underlying.data(); }
+        const value_type* data() const { return _underlying.data(); }
+
+    public:
+        /*
+        * Posts non-blocking sends of the first and last _halo owned rows to the
+        * neighbouring ranks, and receives of theirs into the halo buffers.
+        * The halos may only be read after the returned exchange is waited on.
+        */
+        void start_halo_exchange(halo_exchange& exchange) const
+        {
+            const int above = (_rank + _ranks - 1) % _ranks;
+            const int below = (_rank + 1) % _ranks;
+
+            const int count = static_cast<int>(_halo * _cols);
+            const MPI_Datatype type = mpi_type<value_type>::get();
+
+            //Tag by direction of travel, so that two-rank rings do not mix up the messages
+            enum : int { travelling_up = 0, travelling_down = 1 };
+
+            MPI_Irecv(_halo_above.data(), count, type, above, travelling_down, _comm, &exchange._requests[0]);
+            MPI_Irecv(_halo_below.data(), count, type, below, travelling_up, _comm, &exchange._requests[1]);
+
+            MPI_Isend(row_data(0), count, type, above, travelling_up, _comm, &exchange._requests[2]);
+            MPI_Isend(row_data(_local_rows - _halo), count, type, below, travelling_down, _comm, &exchange._requests[3]);
+
+            exchange._pending = true;
+        }
+
+        void exchange_halos() const
+        {
+            halo_exchange exchange;
+            start_halo_exchange(exchange);
+            exchange.wait();
+        }
+
+    public:
+        /*
+        * Collects the owned rows of every rank into global on rank root.
+        */
+        template<class GlobalContainer>
+        void gather(llps::grid<Type, _rows, _cols, GlobalContainer>& global, int root = 0) const
+        {
+            std::vector<int> counts, displacements;
+            _layout(counts, displacements);
+
+            MPI_Gatherv(
+                data(), static_cast<int>(size()), mpi_type<value_type>::get(),
+                global.data(), counts.data(), displacements.data(), mpi_type<value_type>::get(),
+                root, _comm);
+        }
+
+        /*
+        * Distributes global, held on rank root, over the owned rows of every rank.
+        */
+        template<class GlobalContainer>
+        void scatter(const llps::grid<Type, _rows, _cols, GlobalContainer>& global, int root = 0)
+        {
+            std::vector<int> counts, displacements;
+            _layout(counts, displacements);
+
+            MPI_Scatterv(
+                global.data(), counts.data(), displacements.data(), mpi_type<value_type>::get(),
+                data(), static_cast<int>(size()), mpi_type<value_type>::get(),
+                root, _comm);
+        }
+
+    private:
+        void _bind(MPI_Comm comm)
+        {
+            _comm = comm;
+
+            MPI_Comm_rank(_comm, &_rank);
+            MPI_Comm_size(_comm, &_ranks);
+
+            //Spread the remainder over the first ranks
+            const size_t base = _rows / _ranks;
+            const size_t remainder = _rows % _ranks;
+
+            //The last ranks own the fewest rows, so all ranks agree on whether to throw
+            if (base < _halo)
+                throw std::invalid_argument(
+                    std::to_string(_rows) + " rows over " + std::to_string(_ranks) + " ranks leaves fewer than the " +
+                    std::to_string(_halo) + " halo rows on some rank");
+
+            _local_rows = base + (static_cast<size_t>(_rank) < remainder);
+            _row_offset = _rank * base + std::min<size_t>(_rank, remainder);
+
+            _underlying = underlying_type(_local_rows * _cols);
+            _halo_above = underlying_type(_halo * _cols);
+            _halo_below = underlying_type(_halo * _cols);
+        }
+
+        void _layout(std::vector<int>& counts, std::vector<int>& displacements) const
+        {
+            counts.resize(_ranks);
+            displacements.resize(_ranks);
+
+            const size_t base = _rows / _ranks;
+            const size_t remainder = _rows % _ranks;
+
+            for (int rank = 0; rank < _ranks; ++rank) {
+                counts[rank] = static_cast<int>((base + (static_cast<size_t>(rank) < remainder)) * _cols);
+                displacements[rank] = static_cast<int>((rank * base + std::min<size_t>(rank, remainder)) * _cols);
+            }
+        }
+
+    private:
+        MPI_Comm _comm = MPI_COMM_NULL;
+        int _rank = 0;
+        int _ranks = 1;
+
+        size_t _local_rows = 0;
+        size_t _row_offset = 0;
+
+        underlying_type _underlying;
+
+        mutable underlying_type _halo_above;
+        mutable underlying_type _halo_below;
+    };
+
+}
+
+#endif // !LLPS_DISTRIBUTED_SLAB_GRID_HPP_INCLUDED
@@ -0,0 +1,237 @@
+#ifndef LLPS_EXECUTION_HPP_INCLUDED
+#define LLPS_EXECUTION_HPP_INCLUDED
+
+#include <vector>      //Access to std::vector
+#include <string>      //Access to std::string and std::to_string
+#include <fstream>     //Access to std::ifstream
+#include <algorithm>   //Access to std::fill_n, std::ranges::sort and std::max
+#include <cstddef>     //Access to size_t, ptrdiff_t and std::byte
+#include <cstdlib>     //Access to std::getenv
+#include <string_view> //Access to std::string_view
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif // _OPENMP
+
+#if defined(__linux__)
+#include <sched.h>
+#endif // __linux__
+
+namespace llps {
+
+#ifdef LLPS_NO_FIRST_TOUCH
+    inline constexpr bool _first_touch_default = false;
+#else
+    inline constexpr bool _first_touch_default = true;
+#endif // LLPS_NO_FIRST_TOUCH
+
+    //Below this, spawning the team costs more than remote accesses ever would
+    inline constexpr size_t first_touch_threshold = size_t(1) << 18;
+
+    //Base page size, the granularity at which placement happens without huge pages
+    inline constexpr size_t page_size = 4096;
+
+    /*
+    * Faults in every page of [data, data + bytes) from the OpenMP thread which
+    * owns that part of the range under a static schedule. Linux places a page
+    * on the NUMA node of the thread touching it first, so each worker's block
+    * of rows ends up local to it, as long as the kernels split their loops the
+    * same way (they all use schedule(static) over rows or points).
+    *
+    * Pages are page_bytes long, huge_page_size for memory backed by huge
+    * pages. Placement only needs one write per page, so a single zero byte is
+    * written to each; it must still run before the memory is initialised.
+    * Does nothing inside a parallel region, or for ranges below
+    * first_touch_threshold.
+    */
+    inline void first_touch(void* data, size_t bytes, size_t page_bytes = page_size)
+    {
+#ifdef _OPENMP
+        if (bytes < first_touch_threshold || omp_in_parallel())
+            return;
+
+        std::byte* first = static_cast<std::byte*>(data);
+        const ptrdiff_t pages = static_cast<ptrdiff_t>((bytes + page_bytes - 1) / page_bytes);
+
+        #pragma omp parallel for schedule(static)
+        for (ptrdiff_t i = 0; i < pages; ++i)
+            first[i * static_cast<ptrdiff_t>(page_bytes)] = std::byte{ 0 };
+#else
+        (void)data;
+        (void)bytes;
+        (void)page_bytes;
+#endif // _OPENMP
+    }
+
+    /*
+    * Placement of the OpenMP threads on the cores they may run on:
+    *  - none leaves it to the OpenMP runtime (and OMP_PROC_BIND/OMP_PLACES),
+    *  - close fills the cores of one socket before moving to the next,
+    *  - spread deals threads out over the sockets in turn.
+    */
+    enum class thread_binding { none, close, spread };
+
+#if defined(LLPS_THREAD_BINDING_CLOSE)
+    inline constexpr thread_binding _thread_binding_default = thread_binding::close;
+#elif defined(LLPS_THREAD_BINDING_SPREAD)
+    inline constexpr thread_binding _thread_binding_default = thread_binding::spread;
+#else
+    inline constexpr thread_binding _thread_binding_default = thread_binding::none;
+#endif // LLPS_THREAD_BINDING_CLOSE
+
+    inline constexpr const char* to_string(thread_binding binding) noexcept
+    {
+        switch (binding) {
+        case thread_binding::close:  return "close";
+        case thread_binding::spread: return "spread";
+        default:                     return "none";
+        }
+    }
+
+    struct execution_config
+    {
+    public:
+        thread_binding binding = _thread_binding_default;
+
+        //0 keeps the OpenMP runtime's default
+        int threads = 0;
+
+    public:
+        /*
+        * Configuration chosen at configure time (LLPS_THREAD_BINDING), which
+        * the LLPS_THREAD_BINDING ("none", "close" or "spread") and
+        * LLPS_THREADS environment variables override.
+        */
+        static execution_config from_environment()
+        {
+            execution_config config;
+
+            if (const char* binding = std::getenv("LLPS_THREAD_BINDING")) {
+                const std::string_view name = binding;
+
+                if (name == "close")
+                    config.binding = thread_binding::close;
+                else if (name == "spread")
+                    config.binding = thread_binding::spread;
+                else if (name == "none")
+                    config.binding = thread_binding::none;
+            }
+
+            if (const char* threads = std::getenv("LLPS_THREADS"))
+                config.threads = std::max(0, std::atoi(threads));
+
+            return config;
+        }
+    };
+
+    struct cpu_info
+    {
+        int cpu;
+        int socket;
+    };
+
+    /*
+    * The cores this process may run on, with the socket each belongs to,
+    * ordered by socket and then by core. Empty where the affinity mask or
+    * the topology can not be read.
+    */
+    inline std::vector<cpu_info> available_cpus()
+    {
+        std::vector<cpu_info> cpus;
+
+#if defined(__linux__)
+        cpu_set_t mask;
+        CPU_ZERO(&mask);
+        if (sched_getaffinity(0, sizeof(mask), &mask) != 0)
+            return cpus;
+
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (!CPU_ISSET(cpu, &mask))
+                continue;
+
+            std::ifstream package("/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/physical_package_id");
+
+            int socket = 0;
+            if (!(package >> socket))
+                socket = 0;
+
+            cpus.push_back({ cpu, socket });
+        }
+
+        std::ranges::sort(cpus, [](const cpu_info& lhs, const cpu_info& rhs) {
+            return lhs.socket != rhs.socket ? lhs.socket < rhs.socket : lhs.cpu < rhs.cpu;
+        });
+#endif // __linux__
+
+        return cpus;
+    }
+
+    //Order in which threads are given cores: thread i runs on order[i % order.size()]
+    inline std::vector<cpu_info> binding_order(const std::vector<cpu_info>& cpus, thread_binding binding)
+    {
+        if (binding != thread_binding::spread || cpus.empty())
+            return cpus;
+
+        //Round robin over the sockets, cpus being sorted by socket
+        std::vector<std::vector<cpu_info>> sockets;
+        for (const cpu_info& info : cpus) {
+            if (sockets.empty() || sockets.back().front().socket != info.socket)
+                sockets.emplace_back();
+            sockets.back().push_back(info);
+        }
+
+        std::vector<cpu_info> order;
+        order.reserve(cpus.size());
+
+        for (size_t i = 0; order.size() < cpus.size(); ++i)
+            for (const std::vector<cpu_info>& socket : sockets)
+                if (i < socket.size())
+                    order.push_back(socket[i]);
+
+        return order;
+    }
+
+    /*
+    * Applies config to the OpenMP thread team and returns the core each
+    * thread ended up on (-1 where unknown). Threads are pinned from inside a
+    * parallel region; OpenMP runtimes keep their threads between regions, so
+    * the binding holds for every region with as many threads.
+    *
+    * Call it first thing in main, before grids are allocated, so that first
+    * touch already happens on the final cores.
+    */
+    inline std::vector<int> bind_threads(const execution_config& config)
+    {
+#ifdef _OPENMP
+        if (config.threads > 0)
+            omp_set_num_threads(config.threads);
+
+        std::vector<int> placement(static_cast<size_t>(omp_get_max_threads()), -1);
+        const std::vector<cpu_info> order = binding_order(available_cpus(), config.binding);
+
+        #pragma omp parallel
+        {
+            const int thread = omp_get_thread_num();
+
+#if defined(__linux__)
+            if (config.binding != thread_binding::none && !order.empty()) {
+                cpu_set_t mask;
+                CPU_ZERO(&mask);
+                CPU_SET(order[static_cast<size_t>(thread) % order.size()].cpu, &mask);
+                sched_setaffinity(0, sizeof(mask), &mask);
+            }
+
+            placement[static_cast<size_t>(thread)] = sched_getcpu();
+#endif // __linux__
+        }
+
+        return placement;
+#else
+        (void)config;
+        return { -1 };
+#endif // _OPENMP
+    }
+
+}
+
+#endif // !LLPS_EXECUTION_HPP_INCLUDED
@@ -0,0 +1,373 @@
+#ifndef LLPS_FFT_BUNDLED_BACKEND_HPP_INCLUDED
+#define LLPS_FFT_BUNDLED_BACKEND_HPP_INCLUDED
+
+#include <vector>    //Access to std::vector
+#include <complex>   //Access to std::complex
+#include <cstddef>   //Access to size_t and ptrdiff_t
+#include <cstdint>   //Access to fixed size types
+#include <cassert>   //Access to assert macro
+#include <bit>       //Access to std::has_single_bit and std::bit_ceil
+#include <numbers>   //Access to std::numbers::pi
+#include <numeric>   //Access to std::accumulate
+#include <algorithm> //Access to std::copy_n
+#include <utility>   //Access to std::swap
+#include <functional> //Access to std::multiplies
+
+#include "config.hpp"
+
+/*
+* Header-only FFT backend, used when neither intelMKL nor FFTW3 is available.
+* Power of two lengths use an iterative radix-2 transform, every other length
+* goes through Bluestein's algorithm on top of it. Multi-dimensional transforms
+* are done one axis at a time, parallelised over lines with OpenMP.
+*
+* Transforms are unnormalised and use the same half spectrum layout as FFTW,
+* so the backends are interchangeable.
+*/
+namespace llps::fft::bundled {
+
+    //Plain product, sparing the NaN/inf recovery of std::complex's operator*
+    template<std::floating_point Type>
+    std::complex<Type> _mul(std::complex<Type> lhs, std::complex<Type> rhs)
+    {
+        return {
+            lhs.real() * rhs.real() - lhs.imag() * rhs.imag(),
+            lhs.real() * rhs.imag() + lhs.imag() * rhs.real() };
+    }
+
+    /*
+    * Unnormalised complex transform of a power of two length, sign -1 being
+    * the forward and +1 the backward transform.
+    */
+    template<std::floating_point Type>
+    class radix2
+    {
+    public:
+        using complex_type = std::complex<Type>;
+
+    public:
+        explicit radix2(size_t n) :
+            _n(n), _bitrev(n), _twiddles(n / 2)
+        {
+            assert(std::has_single_bit(n) && "Length must be a power of two!");
+
+            const int bits = std::countr_zero(n);
+            for (size_t i = 0; i < n; ++i) {
+                size_t reversed = 0;
+                for (int bit = 0; bit < bits; ++bit)
+                    reversed |= ((i >> bit) & 1) << (bits - 1 - bit);
+
+                _bitrev[i] = static_cast<uint32_t>(reversed);
+            }
+
+            for (size_t k = 0; k < n / 2; ++k)
+                _twiddles[k] = std::polar(Type(1), -2 * std::numbers::pi_v<Type> * k / n);
+        }
+
+    public:
+        size_t size() const noexcept { return _n; }
+
+        void execute(complex_type* data, int sign) const
+        {
+            for (size_t i = 0; i < _n; ++i) {
+                const size_t j = _bitrev[i];
+                if (i < j)
+                    std::swap(data[i], data[j]);
+            }
+
+            for (size_t len = 2; len <= _n; len <<= 1)
+            {
+                const size_t half = len / 2;
+                const size_t step = _n / len;
+
+                for (size_t start = 0; start < _n; start += len)
+                {
+                    for (size_t j = 0; j < half; ++j)
+                    {
+                        const complex_type twiddle = sign < 0 ? _twiddles[j * step] : std::conj(_twiddles[j * step]);
+
+                        const complex_type even = data[start + j];
+                        const complex_type odd = _mul(data[start + j + half], twiddle);
+
+                        data[start + j]        = even + odd;
+                        data[start + j + half] = even - odd;
+                    }
+                }
+            }
+        }
+
+    private:
+        size_t _n;
+        std::vector<uint32_t> _bitrev;
+        std::vector<complex_type> _twiddles;
+    };
+
+    /*
+    * Unnormalised complex transform of any length. Lengths which are not a
+    * power of two are handled through Bluestein's algorithm, as a circular
+    * convolution of length bit_ceil(2n - 1), which needs scratch_size()
+    * complex values of scratch space.
+    */
+    template<std::floating_point Type>
+    class transform_1d
+    {
+    public:
+        using complex_type = std::complex<Type>;
+
+    public:
+        explicit transform_1d(size_t n) :
+            _n(n), _inner(std::has_single_bit(n) ? n : std::bit_ceil(2 * n - 1))
+        {
+            if (_is_radix2())
+                return;
+
+            const size_t m = _inner.size();
+
+            _chirp.resize(n);
+            _kernel.assign(m, complex_type(0));
+
+            for (size_t k = 0; k < n; ++k) {
+                //The chirp is periodic in k^2 with period 2n, reducing keeps the phase accurate
+                const size_t k_sq = (k * k) % (2 * n);
+                _chirp[k] = std::polar(Type(1), -std::numbers::pi_v<Type> * k_sq / n);
+            }
+
+            _kernel[0] = std::conj(_chirp[0]);
+            for (size_t k = 1; k < n; ++k)
+                _kernel[k] = _kernel[m - k] = std::conj(_chirp[k]);
+
+            _inner.execute(_kernel.data(), -1);
+
+            //Folds in the normalisation of the inner backward transform
+            for (complex_type& value : _kernel)
+                value /= static_cast<Type>(m);
+        }
+
+    public:
+        size_t size() const noexcept { return _n; }
+        size_t scratch_size() const noexcept { return _is_radix2() ? 0 : _inner.size(); }
+
+        void execute(complex_type* data, int sign, complex_type* scratch) const
+        {
+            if (_is_radix2()) {
+                _inner.execute(data, sign);
+                return;
+            }
+
+            const size_t m = _inner.size();
+
+            //The backward transform is the conjugate of the forward transform of the conjugate
+            for (size_t k = 0; k < _n; ++k)
+                scratch[k] = _mul(sign < 0 ? data[k] : std::conj(data[k]), _chirp[k]);
+            std::fill(scratch + _n, scratch + m, complex_type(0));
+
+            _inner.execute(scratch, -1);
+            for (size_t k = 0; k < m; ++k)
+                scratch[k] = _mul(scratch[k], _kernel[k]);
+            _inner.execute(scratch, 1);
+
+            for (size_t k = 0; k < _n; ++k) {
+                const complex_type value = _mul(scratch[k], _chirp[k]);
+                data[k] = sign < 0 ? value : std::conj(value);
+            }
+        }
+
+    private:
+        bool _is_radix2() const noexcept { return _inner.size() == _n; }
+
+    private:
+        size_t _n;
+        radix2<Type> _inner;
+
+        std::vector<complex_type> _chirp;
+        std::vector<complex_type> _kernel;
+    };
+
+    /*
+    * Transforms every line along one axis of a contiguous row-major complex
+    * array of total values, where stride is the distance between consecutive
+    * values of a line.
+    */
+    template<std::floating_point Type>
+    void _transform_axis(std::complex<Type>* data, size_t total, size_t stride, const transform_1d<Type>& transform, int sign)
+    {
+        const size_t n = transform.size();
+        const ptrdiff_t lines = static_cast<ptrdiff_t>(total / n);
+
+        #pragma omp parallel
+        {
+            std::vector<std::complex<Type>> line(n + transform.scratch_size());
+
+            #pragma omp for schedule(static)
+            for (ptrdiff_t l = 0; l < lines; ++l)
+            {
+                std::complex<Type>* first = data + (l / stride) * n * stride + l % stride;
+
+                if (stride == 1) {
+                    transform.execute(first, sign, line.data() + n);
+                    continue;
+                }
+
+                for (size_t i = 0; i < n; ++i)
+                    line[i] = first[i * stride];
+
+                transform.execute(line.data(), sign, line.data() + n);
+
+                for (size_t i = 0; i < n; ++i)
+                    first[i * stride] = line[i];
+            }
+        }
+    }
+
+    /*
+    * howmany contiguous real <-> half spectrum transforms of a row-major array
+    * of shape dims, the last axis being halved to dims.back()/2 + 1.
+    * backward may overwrite its input, as FFTW's c2r transforms do.
+    */
+    template<std::floating_point Type>
+    class real_plan
+    {
+    public:
+        using complex_type = complex<Type>;
+
+    public:
+        real_plan(std::vector<size_t> dims, size_t howmany = 1, plan_options = {}) :
+            _dims(std::move(dims)), _howmany(howmany)
+        {
+            _freq_cols = _dims.back() / 2 + 1;
+            _real_size = std::accumulate(_dims.begin(), _dims.end(), size_t(1), std::multiplies<>());
+            _complex_size = _real_size / _dims.back() * _freq_cols;
+
+            for (size_t n : _dims)
+                _transforms.emplace_back(n);
+        }
+
+    public:
+        void forward(const Type* in, complex_type* out) const
+        {
+            std::complex<Type>* spectrum = reinterpret_cast<std::complex<Type>*>(out);
+
+            const size_t n = _dims.back();
+            const ptrdiff_t rows = static_cast<ptrdiff_t>(_howmany * _real_size / n);
+            const transform_1d<Type>& row_transform = _transforms.back();
+
+            #pragma omp parallel
+            {
+                std::vector<std::complex<Type>> line(n + row_transform.scratch_size());
+
+                #pragma omp for schedule(static)
+                for (ptrdiff_t row = 0; row < rows; ++row)
+                {
+                    const Type* src = in + row * n;
+                    for (size_t i = 0; i < n; ++i)
+                        line[i] = std::complex<Type>(src[i], 0);
+
+                    row_transform.execute(line.data(), -1, line.data() + n);
+                    std::copy_n(line.data(), _freq_cols, spectrum + row * _freq_cols);
+                }
+            }
+
+            _outer_axes(spectrum, -1);
+        }
+
+        void backward(complex_type* in, Type* out) const
+        {
+            std::complex<Type>* spectrum = reinterpret_cast<std::complex<Type>*>(in);
+            _outer_axes(spectrum, 1);
+
+            const size_t n = _dims.back();
+            const ptrdiff_t rows = static_cast<ptrdiff_t>(_howmany * _real_size / n);
+            const transform_1d<Type>& row_transform = _transforms.back();
+
+            #pragma omp parallel
+            {
+                std::vector<std::complex<Type>> line(n + row_transform.scratch_size());
+
+                #pragma omp for schedule(static)
+                for (ptrdiff_t row = 0; row < rows; ++row)
+                {
+                    //Rebuilds the full row from its Hermitian half
+                    const std::complex<Type>* src = spectrum + row * _freq_cols;
+                    std::copy_n(src, _freq_cols, line.data());
+                    for (size_t k = _freq_cols; k < n; ++k)
+                        line[k] = std::conj(src[n - k]);
+
+                    row_transform.execute(line.data(), 1, line.data() + n);
+
+                    Type* dst = out + row * n;
+                    for (size_t i = 0; i < n; ++i)
+                        dst[i] = line[i].real();
+                }
+            }
+        }
+
+    private:
+        void _outer_axes(std::complex<Type>* spectrum, int sign) const
+        {
+            size_t stride = _freq_cols;
+            for (size_t axis = _dims.size() - 1; axis-- > 0;) {
+                _transform_axis(spectrum, _howmany * _complex_size, stride, _transforms[axis], sign);
+                stride *= _dims[axis];
+            }
+        }
+
+    private:
+        std::vector<size_t> _dims;
+        size_t _howmany;
+
+        size_t _freq_cols;
+        size_t _real_size;
+        size_t _complex_size;
+
+        std::vector<transform_1d<Type>> _transforms;
+    };
+
+    /*
+    * howmany contiguous complex transforms of a row-major array of shape dims.
+    */
+    template<std::floating_point Type>
+    class complex_plan
+    {
+    public:
+        using complex_type = complex<Type>;
+
+    public:
+        complex_plan(std::vector<size_t> dims, size_t howmany = 1, plan_options = {}) :
+            _dims(std::move(dims)), _howmany(howmany)
+        {
+            _size = std::accumulate(_dims.begin(), _dims.end(), size_t(1), std::multiplies<>());
+
+            for (size_t n : _dims)
+                _transforms.emplace_back(n);
+        }
+
+    public:
+        void forward(const complex_type* in, complex_type* out) const { _execute(in, out, -1); }
+        void backward(const complex_type* in, complex_type* out) const { _execute(in, out, 1); }
+
+    private:
+        void _execute(const complex_type* in, complex_type* out, int sign) const
+        {
+            if (in != out)
+                std::copy_n(&in[0][0], 2 * _howmany * _size, &out[0][0]);
+
+            std::complex<Type>* data = reinterpret_cast<std::complex<Type>*>(out);
+
+            size_t stride = 1;
+            for (size_t axis = _dims.size(); axis-- > 0;) {
+                _transform_axis(data, _howmany * _size, stride, _transforms[axis], sign);
+                stride *= _dims[axis];
+            }
+        }
+
+    private:
+        std::vector<size_t> _dims;
+        size_t _howmany;
+        size_t _size;
+
+        std::vector<transform_1d<Type>> _transforms;
+    };
+
+}
+
+#endif // !LLPS_FFT_BUNDLED_BACKEND_HPP_INCLUDED
@@ -0,0 +1,65 @@
+#ifndef LLPS_FFT_CONFIG_HPP_INCLUDED
+#define LLPS_FFT_CONFIG_HPP_INCLUDED
+
+#include <cstddef>  //Access to size_t
+#include <new>      //Access to std::align_val_t
+#include <concepts> //Access to std::floating_point
+
+/*
+* Selects the FFT backend from the LLPS_FFT_BACKEND_* definition set up by the
+* LLPS_FFT CMake target. Targets which do not link to it get the bundled,
+* header-only backend, so spectral code always compiles.
+*
+* LLPS_FFT_FFTW_API is defined when the backend exposes the FFTW3 C interface
+* (intelMKL's FFTW wrappers or upstream FFTW3).
+*/
+#if defined(LLPS_FFT_BACKEND_MKL)
+    #include "fftw/fftw3.h"
+    #define LLPS_FFT_FFTW_API
+#elif defined(LLPS_FFT_BACKEND_FFTW3)
+    #include <fftw3.h>
+    #define LLPS_FFT_FFTW_API
+#elif !defined(LLPS_FFT_BACKEND_BUNDLED)
+    #define LLPS_FFT_BACKEND_BUNDLED
+#endif
+
+namespace llps::fft {
+
+    //Interleaved (re, im) pair, layout compatible with fftw_complex and std::complex
+    template<std::floating_point Type>
+    using complex = Type[2];
+
+    struct plan_options
+    {
+        //The transform reads and writes the same array
+        bool in_place = false;
+        //Arrays passed to the plan need not share the alignment of allocate
+        bool unaligned = false;
+    };
+
+    //Alignment of allocate, suiting the widest SIMD loads of every backend
+    inline constexpr size_t alignment = 64;
+
+    template<typename Type>
+    Type* allocate(size_t n)
+    {
+#ifdef LLPS_FFT_FFTW_API
+        return static_cast<Type*>(fftw_malloc(sizeof(Type) * n));
+#else
+        return static_cast<Type*>(::operator new(sizeof(Type) * n, std::align_val_t{ alignment }));
+#endif // LLPS_FFT_FFTW_API
+    }
+
+    template<typename Type>
+    void deallocate(Type* data)
+    {
+#ifdef LLPS_FFT_FFTW_API
+        fftw_free(data);
+#else
+        ::operator delete(static_cast<void*>(data), std::align_val_t{ alignment });
+#endif // LLPS_FFT_FFTW_API
+    }
+
+}
+
+#endif // !LLPS_FFT_CONFIG_HPP_INCLUDED
@@ -0,0 +1,49 @@
+#ifndef LLPS_FFT_FFT_HPP_INCLUDED
+#define LLPS_FFT_FFT_HPP_INCLUDED
+
+#include <concepts> //Access to std::floating_point
+
+#include "config.hpp"
+
+#ifdef LLPS_FFT_FFTW_API
+    #include "fftw_backend.hpp"
+#else
+    #include "bundled_backend.hpp"
+#endif // LLPS_FFT_FFTW_API
+
+/*
+* FFT plans of the backend selected at configure time (see config.hpp). Every
+* backend offers:
+*  - real_plan<Type>(dims, howmany, options):    forward(in, out) r2c and backward(in, out) c2r,
+*  - complex_plan<Type>(dims, howmany, options): forward(in, out) and backward(in, out) c2c,
+* over howmany contiguous row-major arrays of shape dims. Transforms are
+* unnormalised, and spectra use FFTW's half spectrum layout.
+*/
+namespace llps::fft {
+
+#ifdef LLPS_FFT_FFTW_API
+    namespace backend = fftw;
+#else
+    namespace backend = bundled;
+#endif // LLPS_FFT_FFTW_API
+
+    template<std::floating_point Type>
+    using real_plan = backend::real_plan<Type>;
+
+    template<std::floating_point Type>
+    using complex_plan = backend::complex_plan<Type>;
+
+    constexpr const char* backend_name()
+    {
+#if defined(LLPS_FFT_BACKEND_MKL)
+        return "MKL";
+#elif defined(LLPS_FFT_BACKEND_FFTW3)
+        return "FFTW3";
+#else
+        return "BUNDLED";
+#endif
+    }
+
+}
+
+#endif // !LLPS_FFT_FFT_HPP_INCLUDED
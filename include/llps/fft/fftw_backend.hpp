@@ -0,0 +1,206 @@
+#ifndef LLPS_FFT_FFTW_BACKEND_HPP_INCLUDED
+#define LLPS_FFT_FFTW_BACKEND_HPP_INCLUDED
+
+#include <vector>      //Access to std::vector
+#include <cstddef>     //Access to size_t
+#include <numeric>     //Access to std::accumulate
+#include <functional>  //Access to std::multiplies
+#include <type_traits> //Access to std::is_same_v
+#include <utility>     //Access to std::exchange and std::pair
+#include <algorithm>   //Access to std::max
+
+#include "config.hpp"
+
+#ifndef LLPS_FFT_FFTW_API
+    #error "fftw_backend.hpp needs intelMKL or FFTW3, select one through LLPS_FFT_BACKEND."
+#endif // !LLPS_FFT_FFTW_API
+
+#ifdef LLPS_FFT_FFTW3_THREADS
+    #ifdef _OPENMP
+        #include <omp.h>
+    #else
+        #include <thread>
+    #endif // _OPENMP
+#endif // LLPS_FFT_FFTW3_THREADS
+
+/*
+* FFT backend on the FFTW3 interface, shared by intelMKL's wrappers and
+* upstream FFTW3. Only double precision is wired up, as is all the spectral
+* code uses.
+*/
+namespace llps::fft::fftw {
+
+    /*
+    * With upstream FFTW3's threading library linked in, plans made afterwards
+    * split their transforms over as many threads as OpenMP would use.
+    * intelMKL threads its transforms without being asked.
+    */
+    inline void _init_threads()
+    {
+#ifdef LLPS_FFT_FFTW3_THREADS
+        static const bool initialised = [] {
+            fftw_init_threads();
+#ifdef _OPENMP
+            fftw_plan_with_nthreads(omp_get_max_threads());
+#else
+            fftw_plan_with_nthreads(static_cast<int>(std::thread::hardware_concurrency()));
+#endif // _OPENMP
+            return true;
+        }();
+        (void)initialised;
+#endif // LLPS_FFT_FFTW3_THREADS
+    }
+
+    inline unsigned _plan_flags(plan_options options)
+    {
+        return FFTW_ESTIMATE | (options.unaligned ? FFTW_UNALIGNED : 0u);
+    }
+
+    /*
+    * howmany contiguous real <-> half spectrum transforms of a row-major array
+    * of shape dims, the last axis being halved to dims.back()/2 + 1.
+    * Always out of place, backward may overwrite its input.
+    */
+    template<std::floating_point Type>
+    class real_plan
+    {
+        static_assert(std::is_same_v<Type, double>, "The FFTW backends only support double precision!");
+
+    public:
+        using complex_type = complex<Type>;
+
+    public:
+        real_plan(std::vector<size_t> dims, size_t howmany = 1, plan_options options = {})
+        {
+            _init_threads();
+
+            const std::vector<int> n(dims.begin(), dims.end());
+            const int rank = static_cast<int>(n.size());
+
+            const size_t real_size = std::accumulate(dims.begin(), dims.end(), size_t(1), std::multiplies<>());
+            const size_t complex_size = real_size / dims.back() * (dims.back() / 2 + 1);
+
+            //FFTW_ESTIMATE leaves the arrays untouched, so scratch arrays stand in for the callers'
+            Type* real = allocate<Type>(std::max<size_t>(howmany * real_size, 1));
+            complex_type* spectrum = allocate<complex_type>(std::max<size_t>(howmany * complex_size, 1));
+
+            _forward = fftw_plan_many_dft_r2c(
+                rank, n.data(), static_cast<int>(howmany),
+                real, nullptr, 1, static_cast<int>(real_size),
+                spectrum, nullptr, 1, static_cast<int>(complex_size),
+                _plan_flags(options));
+
+            _backward = fftw_plan_many_dft_c2r(
+                rank, n.data(), static_cast<int>(howmany),
+                spectrum, nullptr, 1, static_cast<int>(complex_size),
+                real, nullptr, 1, static_cast<int>(real_size),
+                _plan_flags(options));
+
+            deallocate(real);
+            deallocate(spectrum);
+        }
+
+        real_plan(real_plan&& other) noexcept :
+            _forward(std::exchange(other._forward, nullptr)),
+            _backward(std::exchange(other._backward, nullptr)) {}
+
+        real_plan(const real_plan&) = delete;
+        real_plan& operator=(const real_plan&) = delete;
+
+        ~real_plan()
+        {
+            if (_forward)
+                fftw_destroy_plan(_forward);
+            if (_backward)
+                fftw_destroy_plan(_backward);
+        }
+
+    public:
+        void forward(const Type* in, complex_type* out) const
+        {
+            //r2c transforms leave their input untouched
+            fftw_execute_dft_r2c(_forward, const_cast<Type*>(in), out);
+        }
+
+        void backward(complex_type* in, Type* out) const
+        {
+            fftw_execute_dft_c2r(_backward, in, out);
+        }
+
+    private:
+        fftw_plan _forward;
+        fftw_plan _backward;
+    };
+
+    /*
+    * howmany contiguous complex transforms of a row-major array of shape dims.
+    */
+    template<std::floating_point Type>
+    class complex_plan
+    {
+        static_assert(std::is_same_v<Type, double>, "The FFTW backends only support double precision!");
+
+    public:
+        using complex_type = complex<Type>;
+
+    public:
+        complex_plan(std::vector<size_t> dims, size_t howmany = 1, plan_options options = {})
+        {
+            _init_threads();
+
+            const std::vector<int> n(dims.begin(), dims.end());
+            const int rank = static_cast<int>(n.size());
+
+            const size_t size = std::accumulate(dims.begin(), dims.end(), size_t(1), std::multiplies<>());
+
+            //In and out of place plans are not interchangeable, so the scratch arrays must match the callers'
+            complex_type* in = allocate<complex_type>(std::max<size_t>(howmany * size, 1));
+            complex_type* out = options.in_place ? in : allocate<complex_type>(std::max<size_t>(howmany * size, 1));
+
+            for (auto [plan, sign] : { std::pair{ &_forward, FFTW_FORWARD }, std::pair{ &_backward, FFTW_BACKWARD } }) {
+                *plan = fftw_plan_many_dft(
+                    rank, n.data(), static_cast<int>(howmany),
+                    in, nullptr, 1, static_cast<int>(size),
+                    out, nullptr, 1, static_cast<int>(size),
+                    sign, _plan_flags(options));
+            }
+
+            if (out != in)
+                deallocate(out);
+            deallocate(in);
+        }
+
+        complex_plan(complex_plan&& other) noexcept :
+            _forward(std::exchange(other._forward, nullptr)),
+            _backward(std::exchange(other._backward, nullptr)) {}
+
+        complex_plan(const complex_plan&) = delete;
+        complex_plan& operator=(const complex_plan&) = delete;
+
+        ~complex_plan()
+        {
+            if (_forward)
+                fftw_destroy_plan(_forward);
+            if (_backward)
+                fftw_destroy_plan(_backward);
+        }
+
+    public:
+        void forward(const complex_type* in, complex_type* out) const
+        {
+            fftw_execute_dft(_forward, const_cast<complex_type*>(in), out);
+        }
+
+        void backward(const complex_type* in, complex_type* out) const
+        {
+            fftw_execute_dft(_backward, const_cast<complex_type*>(in), out);
+        }
+
+    private:
+        fftw_plan _forward;
+        fftw_plan _backward;
+    };
+
+}
+
+#endif // !LLPS_FFT_FFTW_BACKEND_HPP_INCLUDED
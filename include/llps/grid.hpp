@@ -3,6 +3,7 @@
 
 #include <vector>      //Access to std::vector
 #include <type_traits> //Access to std::is_same_v
+#include <functional>  //Access to std::invoke
 
 #include "aligned_allocator.hpp"
 
@@ -14,13 +15,9 @@
 
 namespace llps {
 
-#ifdef LLPS_USE_MKL
+    //Cache line aligned, so grids may be handed to SIMD kernels and FFT plans as they are
     template<class Type>
-    using _grid_default_alloc = fftw_allocator<Type>;
-#else
-    template<class Type>
-    using _grid_default_alloc = std::allocator<Type>;
-#endif // LLPS_USE_MKL
+    using _grid_default_alloc = aligned_allocator<Type>;
 
     template<typename Type>
     concept grid_like = requires(Type& grid, const Type& const_grid, typename Type::size_type index) {
@@ -36,6 +33,18 @@ namespace llps {
         {grid(index, index)}       -> std::same_as<typename Type::reference>;
     };
 
+    template<typename Type>
+    concept grid3D_like = grid_like<Type> && requires(Type& grid, const Type& const_grid, typename Type::size_type index) {
+        {const_grid.slices()} -> std::same_as<typename Type::size_type>;
+
+        {const_grid(index, index, index)} -> std::same_as<typename Type::const_reference>;
+        {grid(index, index, index)}       -> std::same_as<typename Type::reference>;
+    };
+
+    //What 2D kernels take, grids which are not 3D grids addressed through their first slice
+    template<typename Type>
+    concept grid2D_like = grid_like<Type> && !grid3D_like<Type>;
+
     template<class Type>
     struct grid_value;
 
@@ -268,7 +277,126 @@ namespace llps {
     subgrid_view(grid<Type, _rows, _cols, Container>&)->subgrid_view<grid<Type, _rows, _cols, Container>, _rows, _cols>;
 
 
-    template<grid_like Grid, typename Type, typename Callable>
+    /*
+    * Defines compile-time attributes of _basic_grid3D class.
+    */
+    template<typename Type, size_t _slices, size_t _rows, size_t _cols, typename Container>
+    struct _grid3D_meta_data : public _grid_meta_data<Type, _rows, _cols, Container>
+    {
+    public:
+        constexpr static size_t slices = _slices;
+    };
+
+    template<typename Type, size_t _slices, size_t _rows, size_t _cols, typename Container>
+    struct _grid_base<_grid3D_meta_data<Type, _slices, _rows, _cols, Container>> :
+        public _grid_base<_grid_meta_data<Type, _rows, _cols, Container>>
+    {
+    public:
+        static consteval size_t size()       noexcept { return _slices * _rows * _cols; }
+        static consteval size_t slices()     noexcept { return _slices; }
+        static consteval size_t slice_size() noexcept { return _rows * _cols; }
+    };
+
+    /*
+    * Three dimensional grid container with static size. Points are addressed by
+    * (slice, row, column), where a slice is one z-plane stored as a contiguous
+    * row major rows x cols block. Container requirements are as for _basic_grid.
+    *
+    * grid3D also satisfies grid_like, in which case (row, col) addresses the
+    * first slice only, but not grid2D_like, so is rejected by 2D kernels.
+    */
+    template<class Meta>
+    struct _basic_grid3D : public _grid_base<Meta>
+    {
+    private:
+        using _base_t = _grid_base<Meta>;
+
+    public:
+        constexpr _basic_grid3D() :
+            _underlying(_base_t::size()) {}
+
+    public:
+        LLPS_FORCE_INLINE constexpr _base_t::const_reference operator()(_base_t::size_type slice, _base_t::size_type row, _base_t::size_type column) const
+        {
+            return _underlying[column + (row + slice * _base_t::rows()) * _base_t::cols()];
+        }
+
+        LLPS_FORCE_INLINE constexpr _base_t::reference operator()(_base_t::size_type slice, _base_t::size_type row, _base_t::size_type column)
+        {
+            return const_cast<_base_t::reference>(static_cast<const _basic_grid3D&>(*this)(slice, row, column));
+        }
+
+        LLPS_FORCE_INLINE constexpr _base_t::const_reference operator()(_base_t::size_type row, _base_t::size_type column) const
+        {
+            return (*this)(0, row, column);
+        }
+
+        LLPS_FORCE_INLINE constexpr _base_t::reference operator()(_base_t::size_type row, _base_t::size_type column)
+        {
+            return (*this)(0, row, column);
+        }
+
+    public:
+        constexpr _base_t::iterator begin()              { return _underlying.begin(); };
+        constexpr _base_t::const_iterator begin()  const { return _underlying.cbegin(); };
+        constexpr _base_t::const_iterator cbegin() const { return _underlying.begin(); };
+
+        constexpr _base_t::iterator end()              { return _underlying.end(); };
+        constexpr _base_t::const_iterator end()  const { return _underlying.cend(); };
+        constexpr _base_t::const_iterator cend() const { return _underlying.end(); };
+
+    public:
+        constexpr       _base_t::value_type* data()       { return _underlying.data(); }
+        constexpr const _base_t::value_type* data() const { return _underlying.data(); }
+
+        constexpr       _base_t::value_type* slice_data(_base_t::size_type slice)       { return data() + slice * _base_t::slice_size(); }
+        constexpr const _base_t::value_type* slice_data(_base_t::size_type slice) const { return data() + slice * _base_t::slice_size(); }
+
+    private:
+        typename Meta::underlying_type _underlying;
+    };
+
+    template<
+        class Type,
+        size_t _slices,
+        size_t _rows,
+        size_t _cols,
+        class Container = std::vector<Type, _grid_default_alloc<Type>>>
+    using grid3D = _basic_grid3D<_grid3D_meta_data<Type, _slices, _rows, _cols, Container>>;
+
+    template<typename Type, size_t _slices, size_t _rows, size_t _cols, typename Container>
+    struct grid_value<_grid3D_meta_data<Type, _slices, _rows, _cols, Container>>
+    { using type = Type; };
+
+    template<class Meta>
+    struct grid_value<_basic_grid3D<Meta>>
+    { using type = grid_value_t<Meta>; };
+
+    template<grid3D_like Grid, typename Type, typename Callable>
+    constexpr void apply_equi3D(
+        Grid& grid,
+        const Type x_min, const Type x_max,
+        const Type y_min, const Type y_max,
+        const Type z_min, const Type z_max,
+        Callable func)
+    {
+        const Type dx = (x_max - x_min) / grid.cols();
+        const Type dy = (y_max - y_min) / grid.rows();
+        const Type dz = (z_max - z_min) / grid.slices();
+
+        for (size_t slice = 0; slice < grid.slices(); ++slice)
+            for (size_t row = 0; row < grid.rows(); ++row)
+                for (size_t col = 0; col < grid.cols(); ++col)
+                    grid(slice, row, col) = std::invoke(func, x_min + col * dx, y_min + row * dy, z_min + slice * dz);
+    }
+
+    template<grid3D_like Grid, typename Type, typename Callable>
+    constexpr void apply_equi3D(Grid& grid, const Type x_min, const Type x_max, Callable func)
+    {
+        return apply_equi3D(grid, x_min, x_max, x_min, x_max, x_min, x_max, func);
+    }
+
+    template<grid2D_like Grid, typename Type, typename Callable>
     constexpr void apply_equi2D(
         Grid& grid,
         const Type x_min, const Type x_max,
@@ -280,10 +408,10 @@ namespace llps {
 
         for (size_t row = 0; row < grid.rows(); ++row)
             for (size_t col = 0; col < grid.cols(); ++col)
-                grid(row, col) = std::invoke(func, col * dx, row * dy);
+                grid(row, col) = std::invoke(func, x_min + col * dx, y_min + row * dy);
     }
 
-    template<grid_like Grid, typename Type, typename Callable>
+    template<grid2D_like Grid, typename Type, typename Callable>
     constexpr void apply_equi2D(Grid& grid, const Type x_min, const Type x_max, Callable func)
     {
         return apply_equi2D(grid, x_min, x_max, x_min, x_max, func);
@@ -0,0 +1,164 @@
+#ifndef LLPS_GRID_ARENA_HPP_INCLUDED
+#define LLPS_GRID_ARENA_HPP_INCLUDED
+
+#include <memory_resource> //Access to std::pmr::memory_resource
+#include <vector>          //Access to std::vector
+#include <cstddef>         //Access to size_t, ptrdiff_t and std::byte
+#include <algorithm>       //Access to std::max
+#include <new>             //Access to std::bad_alloc
+
+#include "aligned_allocator.hpp"
+#include "grid.hpp"
+
+namespace llps {
+
+    /*
+    * Fixed slot pool resource for grids of equal size. All slots are carved out
+    * of one block, allocated (and first touched) on construction, so that
+    * steppers, models and their temporaries draw from the same pages for the
+    * whole run and never return to the heap:
+    *  - Requests of at most slot_size() bytes take a free slot, in O(1).
+    *  - Larger requests, or requests once every slot is taken, go to upstream
+    *    and are counted by overflows(). Drivers size the pool by hand, and
+    *    assert there were none after the run.
+    *
+    * Unless LLPS_FIRST_TOUCH is off, first touch is spread over the OpenMP
+    * threads with the same static schedule the kernels use, placing each page
+    * on the NUMA node of the thread which will work on it.
+    *
+    * Like std::pmr::unsynchronized_pool_resource, it is not thread safe;
+    * grids are allocated outside of parallel regions.
+    */
+    class grid_arena : public std::pmr::memory_resource
+    {
+    public:
+        //Every slot starts on a cache line, matching the default grid allocator
+        static constexpr size_t alignment = 64;
+
+    public:
+        grid_arena(size_t slot_bytes, size_t slots, std::pmr::memory_resource* upstream = std::pmr::new_delete_resource()) :
+            _slot_size((slot_bytes + alignment - 1) / alignment * alignment),
+            _slots(slots),
+            _upstream(upstream)
+        {
+            _block = _allocator.allocate(_slot_size * _slots);
+
+            _free.reserve(_slots);
+            for (size_t slot = _slots; slot-- > 0;)
+                _free.push_back(slot);
+
+            if constexpr (_first_touch_default)
+                _first_touch();
+        }
+
+        grid_arena(const grid_arena&) = delete;
+        grid_arena& operator=(const grid_arena&) = delete;
+
+        ~grid_arena()
+        {
+            _allocator.deallocate(_block, _slot_size * _slots);
+        }
+
+    public:
+        size_t slot_size() const noexcept { return _slot_size; }
+        size_t slots() const noexcept { return _slots; }
+
+        size_t slots_in_use() const noexcept { return _slots - _free.size(); }
+        size_t peak_slots_in_use() const noexcept { return _peak; }
+        size_t overflows() const noexcept { return _overflows; }
+
+    private:
+        void* do_allocate(size_t bytes, size_t align) override
+        {
+            if (bytes <= _slot_size && align <= alignment && !_free.empty()) {
+                const size_t slot = _free.back();
+                _free.pop_back();
+
+                _peak = std::max(_peak, slots_in_use());
+                return _block + slot * _slot_size;
+            }
+
+            ++_overflows;
+            return _upstream->allocate(bytes, std::max(align, alignment));
+        }
+
+        void do_deallocate(void* data, size_t bytes, size_t align) override
+        {
+            std::byte* first = static_cast<std::byte*>(data);
+
+            if (first >= _block && first < _block + _slot_size * _slots) {
+                _free.push_back(static_cast<size_t>(first - _block) / _slot_size);
+                return;
+            }
+
+            _upstream->deallocate(data, bytes, std::max(align, alignment));
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+
+    private:
+        void _first_touch()
+        {
+            const size_t page_bytes = _allocator.placement_page_size(_slot_size * _slots);
+
+            //Slot by slot, as the kernels sweep a grid, unless slots are too small to be split over the threads by page
+            if (_slot_size < page_bytes) {
+                first_touch(_block, _slot_size * _slots, page_bytes);
+                return;
+            }
+
+            for (size_t slot = 0; slot < _slots; ++slot)
+                first_touch(_block + slot * _slot_size, _slot_size, page_bytes);
+        }
+
+    private:
+        size_t _slot_size;
+        size_t _slots;
+
+        std::pmr::memory_resource* _upstream;
+
+        aligned_allocator<std::byte, alignment, _huge_pages_default, false> _allocator;
+        std::byte* _block;
+
+        //Stack of free slot indicies, reserved up front
+        std::vector<size_t> _free;
+
+        size_t _peak = 0;
+        size_t _overflows = 0;
+    };
+
+    /*
+    * Makes resource the default memory resource until the end of the scope,
+    * so that every default constructed pmr grid (including those odeint makes
+    * for its temporaries) draws from it.
+    */
+    class scoped_default_resource
+    {
+    public:
+        explicit scoped_default_resource(std::pmr::memory_resource* resource) :
+            _previous(std::pmr::set_default_resource(resource)) {}
+
+        scoped_default_resource(const scoped_default_resource&) = delete;
+        scoped_default_resource& operator=(const scoped_default_resource&) = delete;
+
+        ~scoped_default_resource()
+        {
+            std::pmr::set_default_resource(_previous);
+        }
+
+    private:
+        std::pmr::memory_resource* _previous;
+    };
+
+    template<class Type, size_t _rows, size_t _cols>
+    using pmr_grid = grid<Type, _rows, _cols, std::pmr::vector<Type>>;
+
+    template<class Type, size_t _slices, size_t _rows, size_t _cols>
+    using pmr_grid3D = grid3D<Type, _slices, _rows, _cols, std::pmr::vector<Type>>;
+
+}
+
+#endif // !LLPS_GRID_ARENA_HPP_INCLUDED
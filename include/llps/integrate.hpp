@@ -0,0 +1,61 @@
+#ifndef LLPS_INTEGRATE_HPP_INCLUDED
+#define LLPS_INTEGRATE_HPP_INCLUDED
+
+#include <cstddef> //Access to size_t
+
+#include <boost/numeric/odeint/stepper/controlled_step_result.hpp>
+#include <boost/numeric/odeint/integrate/max_step_checker.hpp>
+
+namespace llps {
+
+    /*
+    * odeint's integrate_adaptive for a controlled stepper, which also stops
+    * early, once stop(x, t) holds after an accepted step, e.g. when a
+    * steady_state_detector finds the run stationary. x is left at the last
+    * accepted step, and the number of steps taken is returned; check t in
+    * the observer or the predicate for where the run ended.
+    *
+    * Unlike odeint the stepper is taken by reference, so its temporaries are
+    * not copied, and steps are not shortened to land on observation times:
+    * the observer sees every accepted step, as with integrate_adaptive.
+    */
+    template<class Stepper, class System, class State, class Time, class Observer, class Predicate>
+    size_t integrate_adaptive_until(
+        Stepper& stepper, System system, State& x,
+        Time t_start, Time t_end, Time dt,
+        Observer observer, Predicate stop)
+    {
+        using namespace boost::numeric;
+
+        //Same limit on rejected steps in a row as odeint's own integrate functions
+        odeint::failed_step_checker fail_checker;
+
+        Time t = t_start;
+        size_t steps = 0;
+
+        observer(x, t);
+        if (stop(x, t))
+            return steps;
+
+        while (t < t_end) {
+            //Land exactly on t_end
+            if (t + dt > t_end)
+                dt = t_end - t;
+
+            while (stepper.try_step(system, x, t, dt) == odeint::fail)
+                fail_checker();
+
+            fail_checker.reset();
+            ++steps;
+
+            observer(x, t);
+            if (stop(x, t))
+                break;
+        }
+
+        return steps;
+    }
+
+}
+
+#endif // !LLPS_INTEGRATE_HPP_INCLUDED
@@ -0,0 +1,218 @@
+#ifndef LLPS_STOCHASTIC_ENSEMBLE_HPP_INCLUDED
+#define LLPS_STOCHASTIC_ENSEMBLE_HPP_INCLUDED
+
+#include <vector>      //Access to std::vector
+#include <span>        //Access to std::span
+#include <ranges>      //Access to std::ranges::size and random_access_range
+#include <cstddef>     //Access to size_t and ptrdiff_t
+#include <algorithm>   //Access to std::ranges::fill
+#include <stdexcept>   //Access to std::invalid_argument
+#include <type_traits> //Access to std::is_same_v
+
+#include <boost/numeric/odeint/stepper/stepper_categories.hpp>
+
+#include "../calculus/differentiate.hpp"
+#include "../grid.hpp"
+
+namespace llps::stochastic {
+
+    /*
+    * M realisations of one model, advanced together in lockstep. Each step
+    * takes every member through the same stepper and the same model in turn,
+    * so plans, wavenumber tables and temporaries are set up once for the
+    * whole ensemble and stay in cache between members, while each member's
+    * kernels keep the whole OpenMP team.
+    *
+    * Members only differ by their initial conditions and their noise: system
+    * is called with the member index and returns what do_step expects for
+    * it, e.g. a (model, noise) pair for stochastic_heun with one
+    * conserved_noise per member, on substreams 0, ..., M - 1.
+    *
+    * The stepper is shared, so it must not carry anything from one step to
+    * the next, as is the case of odeint's plain (stepper_tag) steppers.
+    */
+    template<class Stepper, grid_like State>
+    class ensemble
+    {
+    public:
+        using stepper_type = Stepper;
+        using state_type   = State;
+        using time_type    = typename stepper_type::time_type;
+
+        static_assert(std::is_same_v<typename stepper_type::stepper_category, boost::numeric::odeint::stepper_tag>,
+            "Ensemble members share one stepper, which must not keep state between steps.");
+
+    public:
+        explicit ensemble(size_t members, stepper_type stepper = {}) :
+            _stepper(std::move(stepper)), _members(members) {}
+
+    public:
+        size_t size() const noexcept { return _members.size(); }
+
+        state_type& operator[](size_t member) noexcept { return _members[member]; }
+        const state_type& operator[](size_t member) const noexcept { return _members[member]; }
+
+        std::span<state_type> members() noexcept { return _members; }
+        std::span<const state_type> members() const noexcept { return _members; }
+
+        /*
+        * Advances every member from t_min to t_max in steps of dt, as
+        * odeint::integrate_const would advance one of them, calling
+        * observer(members(), t) at t_min and after every step. Returns the
+        * number of steps taken.
+        */
+        template<class System, class Observer>
+        size_t integrate_const(System&& system, time_type t_min, time_type t_max, time_type dt, Observer&& observer)
+        {
+            std::span<const state_type> members = _members;
+            observer(members, t_min);
+
+            size_t steps = 0;
+
+            //Times from the step count rather than accumulated, as odeint does, so the last step lands on t_max
+            for (time_type t = t_min; t_min + (steps + 1) * dt <= t_max + dt * 1e-10; t = t_min + steps * dt) {
+                for (size_t member = 0; member < _members.size(); ++member)
+                    _stepper.do_step(system(member), _members[member], t, dt);
+
+                ++steps;
+                observer(members, t_min + steps * dt);
+            }
+
+            return steps;
+        }
+
+    private:
+        stepper_type _stepper;
+        std::vector<state_type> _members;
+    };
+
+    /*
+    * Ensemble statistics gathered in situ, sample by sample, in place of
+    * every member's frames: the mean and (unbiased) variance of the field
+    * at each point, and the ensemble averaged structure factor
+    *   S(k, t) = <|phi_k(t)|^2> / (rows * cols)
+    * in the half spectrum layout of the r2c transforms (row frequencies
+    * wrapped as by freq_index, cols / 2 + 1 columns).
+    *
+    * Only the latest sample is kept, each sample overwriting the last, so
+    * storage is three frames whatever the number of members and samples.
+    * Each sample is meant to be taken away as it is made, e.g. written
+    * through a video_stream per quantity.
+    *
+    * One spectral_operator, and so one plan, serves every member.
+    */
+    template<class Type, size_t _rows, size_t _cols>
+    class ensemble_statistics
+    {
+    public:
+        using value_type    = Type;
+        using frame_type    = llps::grid<value_type, _rows, _cols>;
+        using spectrum_type = llps::grid<value_type, _rows, _cols / 2 + 1>;
+
+    public:
+        ensemble_statistics(value_type dx = 1., value_type dy = 1.) :
+            _operator(dx, dy) {}
+
+    public:
+        //Takes a sample of members, all at time t, in place of the last. Throws std::invalid_argument if members is empty
+        template<std::ranges::random_access_range Members>
+        void sample(const Members& members, double t)
+        {
+            const size_t count = std::ranges::size(members);
+
+            if (count == 0)
+                throw std::invalid_argument("ensemble_statistics needs at least one member to sample");
+
+            _times.push_back(t);
+            _moments(members, count, _mean, _variance);
+            _power_spectrum(members, count, _structure_factor);
+        }
+
+    public:
+        size_t samples() const noexcept { return _times.size(); }
+
+        //Of every sample taken
+        const std::vector<double>& times() const noexcept { return _times; }
+
+        //Of the latest sample
+        const frame_type& mean() const noexcept { return _mean; }
+        const frame_type& variance() const noexcept { return _variance; }
+        const spectrum_type& structure_factor() const noexcept { return _structure_factor; }
+
+    private:
+        //Two passes over the members, row by row, so the mean of a row is still in cache for its variance
+        template<class Members>
+        static void _moments(const Members& members, size_t count, frame_type& mean, frame_type& variance)
+        {
+            const value_type mean_norm = value_type(1) / count;
+            const value_type variance_norm = count > 1 ? value_type(1) / (count - 1) : value_type(0);
+
+            #pragma omp parallel for schedule(static)
+            for (ptrdiff_t row = 0; row < static_cast<ptrdiff_t>(_rows); ++row)
+            {
+                value_type* mean_row = mean.data() + row * _cols;
+                value_type* variance_row = variance.data() + row * _cols;
+
+                #pragma omp simd
+                for (ptrdiff_t col = 0; col < static_cast<ptrdiff_t>(_cols); ++col) {
+                    mean_row[col] = 0;
+                    variance_row[col] = 0;
+                }
+
+                for (const auto& member : members) {
+                    const value_type* member_row = member.data() + row * _cols;
+
+                    #pragma omp simd
+                    for (ptrdiff_t col = 0; col < static_cast<ptrdiff_t>(_cols); ++col)
+                        mean_row[col] += member_row[col];
+                }
+
+                #pragma omp simd
+                for (ptrdiff_t col = 0; col < static_cast<ptrdiff_t>(_cols); ++col)
+                    mean_row[col] *= mean_norm;
+
+                for (const auto& member : members) {
+                    const value_type* member_row = member.data() + row * _cols;
+
+                    #pragma omp simd
+                    for (ptrdiff_t col = 0; col < static_cast<ptrdiff_t>(_cols); ++col) {
+                        const value_type deviation = member_row[col] - mean_row[col];
+                        variance_row[col] += deviation * deviation;
+                    }
+                }
+
+                #pragma omp simd
+                for (ptrdiff_t col = 0; col < static_cast<ptrdiff_t>(_cols); ++col)
+                    variance_row[col] *= variance_norm;
+            }
+        }
+
+        template<class Members>
+        void _power_spectrum(const Members& members, size_t count, spectrum_type& structure_factor)
+        {
+            const value_type norm = value_type(1) / (static_cast<value_type>(_rows * _cols) * count);
+
+            value_type* result = structure_factor.data();
+            std::ranges::fill(structure_factor, value_type(0));
+
+            for (const auto& member : members) {
+                _operator.forward(member);
+                const value_type* spectrum = reinterpret_cast<const value_type*>(_operator.spectrum());
+
+                #pragma omp parallel for simd schedule(static)
+                for (ptrdiff_t i = 0; i < static_cast<ptrdiff_t>(spectrum_type::size()); ++i)
+                    result[i] += norm * (spectrum[2 * i] * spectrum[2 * i] + spectrum[2 * i + 1] * spectrum[2 * i + 1]);
+            }
+        }
+
+    private:
+        calculus::spectral_operator<value_type, _rows, _cols> _operator;
+
+        std::vector<double> _times;
+        frame_type _mean, _variance;
+        spectrum_type _structure_factor;
+    };
+
+}
+
+#endif // !LLPS_STOCHASTIC_ENSEMBLE_HPP_INCLUDED
@@ -0,0 +1,75 @@
+#ifndef LLPS_STOCHASTIC_STOCHASTIC_HEUN_HPP_INCLUDED
+#define LLPS_STOCHASTIC_STOCHASTIC_HEUN_HPP_INCLUDED
+
+#include <cstddef> //Access to ptrdiff_t
+#include <ranges>  //Access to std::ranges::data and size
+
+#include <boost/numeric/odeint/stepper/stepper_categories.hpp>
+
+namespace llps::stochastic {
+
+    /*
+    * Stochastic Heun stepper for SDEs with additive noise,
+    *   dx = f(x, t) dt + dW,
+    * where the system is a pair (f, noise): f(x, dxdt, t) as for odeint and
+    * noise(dW, t, dt) filling in the increment over one step. The noise is
+    * drawn once per step and shared by predictor and corrector:
+    *   x~      = x + f(x, t) dt + dW
+    *   x(t+dt) = x + (f(x, t) + f(x~, t + dt)) dt / 2 + dW
+    * This is strong order 1 for additive noise, and takes the deterministic
+    * part to second order.
+    *
+    * Models odeint's Stepper concept, so it runs under integrate_const and
+    * integrate_n_steps. odeint copies the system it is given, so pass the
+    * noise by reference, std::make_pair(std::ref(model), std::ref(noise)),
+    * or a later integration would replay the same noise.
+    */
+    template<class State>
+    class stochastic_heun
+    {
+    public:
+        using state_type       = State;
+        using deriv_type       = State;
+        using value_type       = typename State::value_type;
+        using time_type        = double;
+        using order_type       = unsigned short;
+        using stepper_category = boost::numeric::odeint::stepper_tag;
+
+        static constexpr order_type order() noexcept { return 1; }
+
+    public:
+        template<class System>
+        void do_step(System&& system, state_type& x, time_type t, time_type dt)
+        {
+            auto& deterministic = system.first;
+            auto& noise = system.second;
+
+            deterministic(x, _drift, t);
+            noise(_increment, t, dt);
+
+            value_type* x_data = std::ranges::data(x);
+            value_type* drift = std::ranges::data(_drift);
+            value_type* increment = std::ranges::data(_increment);
+            value_type* predictor = std::ranges::data(_predictor);
+
+            const ptrdiff_t size = static_cast<ptrdiff_t>(std::ranges::size(x));
+
+            #pragma omp parallel for schedule(static)
+            for (ptrdiff_t i = 0; i < size; ++i)
+                predictor[i] = x_data[i] + dt * drift[i] + increment[i];
+
+            deterministic(_predictor, _predicted_drift, t + dt);
+            const value_type* predicted_drift = std::ranges::data(_predicted_drift);
+
+            #pragma omp parallel for schedule(static)
+            for (ptrdiff_t i = 0; i < size; ++i)
+                x_data[i] += 0.5 * dt * (drift[i] + predicted_drift[i]) + increment[i];
+        }
+
+    private:
+        state_type _drift, _predicted_drift, _predictor, _increment;
+    };
+
+}
+
+#endif // !LLPS_STOCHASTIC_STOCHASTIC_HEUN_HPP_INCLUDED
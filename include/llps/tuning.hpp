@@ -0,0 +1,227 @@
+#ifndef LLPS_TUNING_HPP_INCLUDED
+#define LLPS_TUNING_HPP_INCLUDED
+
+#include <vector>      //Access to std::vector
+#include <string>      //Access to std::string and std::to_string
+#include <fstream>     //Access to std::ifstream and std::ofstream
+#include <sstream>     //Access to std::istringstream
+#include <cstddef>     //Access to size_t and ptrdiff_t
+#include <cstdlib>     //Access to std::getenv
+#include <cmath>       //Access to std::abs, std::cos and std::log
+#include <limits>      //Access to std::numeric_limits
+#include <numbers>     //Access to std::numbers::pi
+#include <functional>  //Access to std::invoke
+#include <stdexcept>   //Access to std::invalid_argument
+
+#include "calculus/finite_difference.hpp"
+#include "utilities/meta.hpp"
+#include "execution.hpp"
+
+namespace llps {
+
+    //Orders the drivers may run at, those of gen_fd_error_data
+    inline constexpr size_t min_fd_order = 2;
+    inline constexpr size_t max_fd_order = 14;
+
+    //Order of the drivers where no profile says otherwise
+    inline constexpr size_t default_fd_order = 6;
+
+    /*
+    * Calls callable with size_t_constant<order>, turning an order read at
+    * runtime into the compile time one of the stencils. Every even order
+    * from min_fd_order to max_fd_order is instantiated, others throw.
+    */
+    template<class Callable>
+    void dispatch_fd_order(size_t order, Callable&& callable)
+    {
+        bool dispatched = false;
+
+        utilities::constexpr_for<min_fd_order, max_fd_order + 1, 2>([&]<size_t I>(utilities::size_t_constant<I> constant) {
+            if (order == I) {
+                std::invoke(callable, constant);
+                dispatched = true;
+            }
+        });
+
+        if (!dispatched)
+            throw std::invalid_argument("no finite difference kernel of order " + std::to_string(order));
+    }
+
+    /*
+    * Relative error of the central difference second derivative of the
+    * given order on a Fourier mode sampled points_per_wavelength times per
+    * wavelength, |sum_i w_i cos(i theta) + theta^2| / theta^2 with theta =
+    * 2 pi / points_per_wavelength. This is the truncation error
+    * gen_fd_error_data measures on its test function, C dx^order, for a
+    * single mode: the laplacian's worst case is a mode along an axis, and
+    * the resolution of a run the wavelength of its finest feature, e.g.
+    * 2 pi sqrt(-2k/a) for the fastest growing mode of Model B.
+    */
+    inline double fd_laplacian_error(size_t order, double points_per_wavelength)
+    {
+        const double theta = 2. * std::numbers::pi / points_per_wavelength;
+
+        double error = 0.;
+        dispatch_fd_order(order, [&]<size_t error_order>(utilities::size_t_constant<error_order>) {
+            static constexpr auto stencil = calculus::central_fd_stencil<error_order>(2);
+            static constexpr ptrdiff_t offset = error_order / 2;
+
+            double symbol = 0.;
+            for (size_t i = 0; i <= error_order; ++i)
+                symbol += stencil[i] * std::cos((static_cast<ptrdiff_t>(i) - offset) * theta);
+
+            error = std::abs(symbol + theta * theta) / (theta * theta);
+        });
+
+        return error;
+    }
+
+    /*
+    * Kernel configuration for one grid size: the finite difference order,
+    * the rows per block of the 3D stencil or the rows and columns per tile
+    * of the 2D one, and the thread count. 0 leaves the kernel's estimate,
+    * or the OpenMP runtime's default, in place.
+    */
+    struct tuning_entry
+    {
+    public:
+        size_t slices = 1;
+        size_t rows = 0;
+        size_t cols = 0;
+
+        size_t fd_order = default_fd_order;
+        size_t block_rows = 0;
+        size_t block_cols = 0;
+        int threads = 0;
+
+        //Measured time of one right hand side, per point
+        double seconds_per_point = 0.;
+
+    public:
+        size_t size() const noexcept { return slices * rows * cols; }
+
+        //Threads of the profile, unless LLPS_THREADS already chose some
+        void apply(execution_config& config) const noexcept
+        {
+            if (config.threads == 0)
+                config.threads = threads;
+        }
+    };
+
+    /*
+    * Tuning profile of a host, as written by llps_autotune: one line per
+    * grid size,
+    *   slices rows cols fd_order block_rows block_cols threads seconds_per_point
+    * with slices 1 for 2D grids, block_cols 0 for 3D ones, and lines
+    * starting with # ignored.
+    *
+    * Drivers load it at startup, before bind_threads, and look their grid
+    * up with find. Without a profile, or an entry of the same dimension,
+    * find returns the defaults, so the drivers run as they would untuned.
+    */
+    class tuning_profile
+    {
+    public:
+        //Missing files, and malformed lines, give an empty profile
+        static tuning_profile load(const std::string& path)
+        {
+            tuning_profile profile;
+
+            std::ifstream file(path);
+            std::string line;
+            while (std::getline(file, line)) {
+                if (line.empty() || line.front() == '#')
+                    continue;
+
+                std::istringstream stream(line);
+
+                tuning_entry entry;
+                if (!(stream >> entry.slices >> entry.rows >> entry.cols >> entry.fd_order >> entry.block_rows >> entry.block_cols >> entry.threads >> entry.seconds_per_point))
+                    continue;
+
+                const bool supported = entry.fd_order % 2 == 0 && entry.fd_order >= min_fd_order && entry.fd_order <= max_fd_order;
+                if (supported && entry.size() > 0)
+                    profile.set(entry);
+            }
+
+            return profile;
+        }
+
+        /*
+        * The profile at the LLPS_TUNING_PROFILE environment variable, or at
+        * default_path without it.
+        */
+        static tuning_profile from_environment(const std::string& default_path)
+        {
+            const char* path = std::getenv("LLPS_TUNING_PROFILE");
+            return load(path ? path : default_path);
+        }
+
+    public:
+        void save(const std::string& path) const
+        {
+            std::ofstream file(path);
+
+            file << "# slices rows cols fd_order block_rows block_cols threads seconds_per_point\n";
+            for (const tuning_entry& entry : _entries)
+                file << entry.slices << " " << entry.rows << " " << entry.cols << " " << entry.fd_order << " "
+                     << entry.block_rows << " " << entry.block_cols << " " << entry.threads << " " << entry.seconds_per_point << "\n";
+        }
+
+        //Adds entry, replacing any of the same size
+        void set(const tuning_entry& entry)
+        {
+            for (tuning_entry& existing : _entries) {
+                if (existing.slices == entry.slices && existing.rows == entry.rows && existing.cols == entry.cols) {
+                    existing = entry;
+                    return;
+                }
+            }
+
+            _entries.push_back(entry);
+        }
+
+        /*
+        * The entry of this size, or else the one closest to it in number of
+        * points (on a log scale) among those of the same dimension, with its
+        * size replaced by the one asked for.
+        */
+        tuning_entry find(size_t slices, size_t rows, size_t cols) const
+        {
+            tuning_entry result{ slices, rows, cols };
+
+            const double points = static_cast<double>(slices * rows * cols);
+            double closest = std::numeric_limits<double>::infinity();
+
+            for (const tuning_entry& entry : _entries) {
+                if ((entry.slices == 1) != (slices == 1))
+                    continue;
+
+                const double distance = std::abs(std::log(static_cast<double>(entry.size()) / points));
+                const bool exact = entry.slices == slices && entry.rows == rows && entry.cols == cols;
+
+                if (exact || distance < closest) {
+                    closest = exact ? -1. : distance;
+
+                    result = entry;
+                    result.slices = slices;
+                    result.rows = rows;
+                    result.cols = cols;
+                }
+            }
+
+            return result;
+        }
+
+        tuning_entry find(size_t rows, size_t cols) const { return find(1, rows, cols); }
+
+    public:
+        const std::vector<tuning_entry>& entries() const noexcept { return _entries; }
+
+    private:
+        std::vector<tuning_entry> _entries;
+    };
+
+}
+
+#endif // !LLPS_TUNING_HPP_INCLUDED
@@ -0,0 +1,315 @@
+#ifndef LLPS_UTILITIES_CLUSTERS_HPP_INCLUDED
+#define LLPS_UTILITIES_CLUSTERS_HPP_INCLUDED
+
+#include <vector>    //Access to std::vector
+#include <cstddef>   //Access to size_t
+#include <cstdint>   //Access to int32_t and INT32_MAX
+#include <cmath>     //Access to std::sin, std::cos and std::atan2
+#include <numbers>   //Access to std::numbers::pi
+#include <concepts>  //Access to std::floating_point
+#include <algorithm> //Access to std::copy
+#include <utility>   //Access to std::pair
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif // _OPENMP
+
+#include "../grid.hpp"
+
+namespace llps::utilities {
+
+    //Root of index in the forest parent, halving the path on the way
+    inline int32_t _find_root(int32_t* parent, int32_t index) noexcept
+    {
+        while (parent[index] != index) {
+            parent[index] = parent[parent[index]];
+            index = parent[index];
+        }
+
+        return index;
+    }
+
+    //Joins the trees of a and b under the lower root, so a cluster always ends up rooted at its lowest index
+    inline void _unite(int32_t* parent, int32_t a, int32_t b) noexcept
+    {
+        a = _find_root(parent, a);
+        b = _find_root(parent, b);
+
+        if (a < b)
+            parent[b] = a;
+        else if (b < a)
+            parent[a] = b;
+    }
+
+    /*
+    * Labels the 4-connected clusters of points where phi > threshold, on a
+    * grid periodic in both directions. labels receives -1 outside clusters
+    * and 0, ..., n - 1 inside, numbered in order of their first point in
+    * row-major order; n is returned.
+    *
+    * Each thread runs union-find over its own static block of rows, then the
+    * block edges and the periodic edge between the last and first row are
+    * merged serially, which costs one row per thread. Trees are always rooted
+    * at their lowest index, so labels do not depend on the thread count.
+    */
+    template<class Type, size_t _rows, size_t _cols, class Container, class LabelContainer>
+    size_t label_clusters(
+        const llps::grid<Type, _rows, _cols, Container>& phi,
+        llps::grid<int32_t, _rows, _cols, LabelContainer>& labels,
+        Type threshold = 0)
+    {
+        static_assert(_rows * _cols <= INT32_MAX, "Grid too large for 32 bit labels.");
+
+        static constexpr int32_t rows = static_cast<int32_t>(_rows);
+        static constexpr int32_t cols = static_cast<int32_t>(_cols);
+
+        const Type* values = phi.data();
+        int32_t* parent = labels.data();
+
+        int32_t threads = 1;
+
+        //Union-find within each thread's block of rows, which touches no other block's entries
+        #pragma omp parallel
+        {
+#ifdef _OPENMP
+            const int32_t thread = omp_get_thread_num();
+
+            #pragma omp single
+            threads = omp_get_num_threads();
+#else
+            const int32_t thread = 0;
+#endif // _OPENMP
+
+            const int32_t first_row = rows * thread / threads;
+            const int32_t last_row = rows * (thread + 1) / threads;
+
+            for (int32_t row = first_row; row < last_row; ++row) {
+                for (int32_t col = 0; col < cols; ++col) {
+                    const int32_t i = row * cols + col;
+
+                    if (!(values[i] > threshold)) {
+                        parent[i] = -1;
+                        continue;
+                    }
+
+                    const bool left = col > 0 && parent[i - 1] >= 0;
+                    const bool up = row > first_row && parent[i - cols] >= 0;
+
+                    //A new point joins its neighbour's tree directly, under a lower index; left and up only need a union
+                    //when the point above left, which would already connect them, is outside
+                    if (left) {
+                        parent[i] = parent[i - 1];
+
+                        if (up && parent[i - cols - 1] < 0)
+                            _unite(parent, i - 1, i - cols);
+                    }
+                    else {
+                        parent[i] = up ? parent[i - cols] : i;
+                    }
+                }
+
+                //Periodic in x
+                const int32_t first = row * cols;
+                const int32_t last = first + cols - 1;
+                if (cols > 1 && parent[first] >= 0 && parent[last] >= 0)
+                    _unite(parent, first, last);
+            }
+        }
+
+        //Block edges, including the periodic one between the last and first row
+        for (int32_t thread = 0; thread < threads; ++thread) {
+            const int32_t row = rows * thread / threads;
+            const int32_t above = (row + rows - 1) % rows;
+
+            for (int32_t col = 0; col < cols; ++col) {
+                const int32_t i = row * cols + col;
+                const int32_t j = above * cols + col;
+
+                if (parent[i] >= 0 && parent[j] >= 0)
+                    _unite(parent, i, j);
+            }
+        }
+
+        //Roots become cluster numbers, counted per block and then offset by the clusters of the blocks before.
+        //The team may be smaller than the first one (e.g. with OMP_DYNAMIC), so blocks are dealt out by omp for
+        std::vector<int32_t> roots(static_cast<size_t>(threads) + 1, 0);
+        std::vector<std::vector<int32_t>> root_of(static_cast<size_t>(threads));
+
+        auto block_range = [&](int32_t block) {
+            return std::pair{ rows * block / threads * cols, rows * (block + 1) / threads * cols };
+        };
+
+        #pragma omp parallel
+        {
+            //Finds only read, and a root never moves, so blocks can look into each other
+            #pragma omp for schedule(static)
+            for (int32_t block = 0; block < threads; ++block) {
+                const auto [first, last] = block_range(block);
+                root_of[block].resize(static_cast<size_t>(last - first));
+
+                for (int32_t i = first; i < last; ++i) {
+                    int32_t root = parent[i];
+                    if (root >= 0)
+                        while (parent[root] != root)
+                            root = parent[root];
+
+                    root_of[block][i - first] = root;
+                    roots[block + 1] += root == i;
+                }
+            }
+
+            #pragma omp single
+            for (int32_t block = 0; block < threads; ++block)
+                roots[block + 1] += roots[block];
+
+            #pragma omp for schedule(static)
+            for (int32_t block = 0; block < threads; ++block) {
+                const auto [first, last] = block_range(block);
+
+                int32_t next = roots[block];
+                for (int32_t i = first; i < last; ++i)
+                    if (root_of[block][i - first] == i)
+                        parent[i] = -2 - next++;
+            }
+
+            #pragma omp for schedule(static)
+            for (int32_t block = 0; block < threads; ++block) {
+                const auto [first, last] = block_range(block);
+
+                for (int32_t i = first; i < last; ++i) {
+                    const int32_t root = root_of[block][i - first];
+                    root_of[block][i - first] = root < 0 ? -1 : -2 - parent[root];
+                }
+            }
+
+            //Every block has read its roots' numbers (at the implicit barrier above) before any is overwritten
+            #pragma omp for schedule(static)
+            for (int32_t block = 0; block < threads; ++block)
+                std::copy(root_of[block].begin(), root_of[block].end(), parent + block_range(block).first);
+        }
+
+        return static_cast<size_t>(roots[threads]);
+    }
+
+    /*
+    * Per sample statistics of the clusters of phi > threshold (droplets of
+    * the phase above threshold), taken from an observer like
+    * radial_structure_factor: the size of each cluster, in points, and its
+    * centroid. Centroids are circular means along each axis, which stay
+    * correct for clusters wrapping around the periodic boundaries.
+    */
+    template<std::floating_point Type, size_t _rows, size_t _cols>
+    class cluster_statistics
+    {
+    public:
+        using value_type = Type;
+        using label_type = llps::grid<int32_t, _rows, _cols>;
+
+        struct cluster
+        {
+            size_t size;
+            value_type x;
+            value_type y;
+        };
+
+    public:
+        //Samples every sample_interval when called as an observer, or at every call if 0
+        cluster_statistics(value_type threshold = 0., value_type dx = 1., value_type dy = 1., double sample_interval = 0.) :
+            _threshold(threshold), _dx(dx), _dy(dy), _interval(sample_interval) {}
+
+    public:
+        //As an observer: samples phi if at least sample_interval has passed since the last sample
+        template<class Container>
+        void operator()(const llps::grid<value_type, _rows, _cols, Container>& phi, double t)
+        {
+            if (!_times.empty() && t - _times.back() < _interval * (1 - 1e-10))
+                return;
+
+            sample(phi, t);
+        }
+
+        template<class Container>
+        void sample(const llps::grid<value_type, _rows, _cols, Container>& phi, double t)
+        {
+            const size_t count = label_clusters(phi, _labels, _threshold);
+
+            //Point count and sums of the unit vectors of the x and y angles, per cluster
+            std::vector<size_t> sizes(count, 0);
+            std::vector<value_type> sums(4 * count, 0.);
+
+            for (size_t row = 0; row < _rows; ++row) {
+                for (size_t col = 0; col < _cols; ++col) {
+                    const int32_t label = _labels(row, col);
+                    if (label < 0)
+                        continue;
+
+                    ++sizes[label];
+
+                    value_type* sum = sums.data() + 4 * label;
+                    sum[0] += _cos_x[col];
+                    sum[1] += _sin_x[col];
+                    sum[2] += _cos_y[row];
+                    sum[3] += _sin_y[row];
+                }
+            }
+
+            std::vector<cluster>& clusters = _clusters.emplace_back();
+            clusters.reserve(count);
+
+            for (size_t label = 0; label < count; ++label) {
+                const value_type* sum = sums.data() + 4 * label;
+
+                clusters.push_back({ sizes[label], _dx * _circular_mean(sum[0], sum[1], _cols), _dy * _circular_mean(sum[2], sum[3], _rows) });
+            }
+
+            _times.push_back(t);
+        }
+
+    public:
+        size_t samples() const noexcept { return _times.size(); }
+
+        const std::vector<double>& times() const noexcept { return _times; }
+        //Clusters of each sample, ordered by label
+        const std::vector<std::vector<cluster>>& clusters() const noexcept { return _clusters; }
+        //Labels of the last sample
+        const label_type& labels() const noexcept { return _labels; }
+
+    private:
+        //Position in [0, n) of the mean angle of a cluster along an axis of n points
+        static value_type _circular_mean(value_type cos_sum, value_type sin_sum, size_t n)
+        {
+            value_type angle = std::atan2(sin_sum, cos_sum);
+            if (angle < 0)
+                angle += 2. * std::numbers::pi;
+
+            return angle * n / (2. * std::numbers::pi);
+        }
+
+        template<size_t n, class Func>
+        static std::vector<value_type> _angle_table(Func func)
+        {
+            std::vector<value_type> table(n);
+            for (size_t i = 0; i < n; ++i)
+                table[i] = func(2. * std::numbers::pi * i / n);
+
+            return table;
+        }
+
+    private:
+        value_type _threshold, _dx, _dy;
+        double _interval;
+
+        label_type _labels;
+
+        const std::vector<value_type> _cos_x = _angle_table<_cols>([](value_type angle) { return std::cos(angle); });
+        const std::vector<value_type> _sin_x = _angle_table<_cols>([](value_type angle) { return std::sin(angle); });
+        const std::vector<value_type> _cos_y = _angle_table<_rows>([](value_type angle) { return std::cos(angle); });
+        const std::vector<value_type> _sin_y = _angle_table<_rows>([](value_type angle) { return std::sin(angle); });
+
+        std::vector<double> _times;
+        std::vector<std::vector<cluster>> _clusters;
+    };
+
+}
+
+#endif // !LLPS_UTILITIES_CLUSTERS_HPP_INCLUDED
@@ -1,11 +1,17 @@
 #ifndef LLPS_UTILITIES_IO_HPP_INCLUDED
 #define LLPS_UTILITIES_IO_HPP_INCLUDED
 
-#include <iterator> //For access to std::iter_value_t and iterator concepts
-#include <fstream>  //For access to std::ofstream
-#include <string>   //For access to std::string
-#include <cassert>  //For access to assert macro
-#include <cstddef>  //For access to fixed size types
+#include <iterator>  //For access to std::iter_value_t and iterator concepts
+#include <fstream>   //For access to std::ofstream
+#include <string>    //For access to std::string
+#include <cassert>   //For access to assert macro
+#include <cstddef>   //For access to fixed size types
+#include <vector>    //For access to std::vector
+#include <ranges>    //For access to std::ranges::contiguous_range, data and size
+#include <concepts>  //For access to std::same_as
+#include <stdexcept> //For access to std::runtime_error
+
+#include "reduction.hpp"
 
 namespace llps::utilities {
 
@@ -108,6 +114,93 @@ namespace llps::utilities {
         serialise_to_binary(stream, value);
 
     }
+
+    /*
+    * A single video plot written frame by frame while the simulation runs,
+    * rather than from frames kept in memory until the end. The frame count
+    * and the vmin/vmax meta data are not known up front, so placeholders are
+    * written and patched on close; vmin and vmax come from summarising each
+    * frame as it is written, so frames are never read back. Sample times
+    * follow the frames, where plot_video.py reads them.
+    */
+    template<std::floating_point ValueType, std::floating_point SpaceType = ValueType>
+    class video_stream
+    {
+    public:
+        video_stream(const std::string& file_name, size_t width, size_t height, plot_header plot = {}, video_header<ValueType, SpaceType> video = {}) :
+            _file(file_name, std::ios::binary), _frame_size(width * height)
+        {
+            if (!_file.is_open())
+                throw std::runtime_error("could not open " + file_name + " for writing");
+
+            serialise_plot_header(_file, 1, plot);
+
+            serialise_meta_data_header(_file, 2);
+            serialise_meta_data(_file, "vmin", _summary.min);
+            _vmin_pos = _file.tellp() - std::streamoff(sizeof(ValueType));
+            serialise_meta_data(_file, "vmax", _summary.max);
+            _vmax_pos = _file.tellp() - std::streamoff(sizeof(ValueType));
+
+            serialise_video_header(_file, width, height, 0, video);
+            _frames_pos = _file.tellp() - std::streamoff(sizeof(uint64_t));
+        }
+
+        video_stream(const video_stream&) = delete;
+        video_stream& operator=(const video_stream&) = delete;
+
+        ~video_stream() { close(); }
+
+    public:
+        //Appends frame, sampled at t, and returns its summary
+        template<std::ranges::contiguous_range Frame>
+        field_summary<ValueType> write(const Frame& frame, double t)
+        {
+            //Frames are written as raw bytes, which plot_video.py reads as ValueType
+            static_assert(std::same_as<std::ranges::range_value_t<Frame>, ValueType>, "Frame must hold elements of ValueType!");
+            assert(std::ranges::size(frame) == _frame_size);
+
+            const field_summary<ValueType> summary = summarise(frame);
+            _summary += summary;
+
+            _file.write(reinterpret_cast<const char*>(std::ranges::data(frame)), sizeof(ValueType) * _frame_size);
+            _times.push_back(t);
+
+            return summary;
+        }
+
+        void close()
+        {
+            if (!_file.is_open())
+                return;
+
+            for (double t : _times)
+                serialise_to_binary(_file, t);
+
+            _file.seekp(_vmin_pos);
+            serialise_to_binary(_file, _summary.min);
+            _file.seekp(_vmax_pos);
+            serialise_to_binary(_file, _summary.max);
+            _file.seekp(_frames_pos);
+            serialise_to_binary<uint64_t>(_file, _times.size());
+
+            _file.close();
+        }
+
+    public:
+        size_t frames() const noexcept { return _times.size(); }
+
+        //Of every frame written so far
+        const field_summary<ValueType>& summary() const noexcept { return _summary; }
+
+    private:
+        std::ofstream _file;
+        size_t _frame_size;
+
+        std::streampos _vmin_pos, _vmax_pos, _frames_pos;
+
+        field_summary<ValueType> _summary;
+        std::vector<double> _times;
+    };
 }
 
 #endif // !LLPS_UTILITIES_IO_HPP_INCLUDED
\ No newline at end of file
@@ -0,0 +1,175 @@
+#ifndef LLPS_UTILITIES_MONITOR_HPP_INCLUDED
+#define LLPS_UTILITIES_MONITOR_HPP_INCLUDED
+
+#include <vector>    //Access to std::vector
+#include <cstddef>   //Access to ptrdiff_t and size_t
+#include <cmath>     //Access to std::abs
+#include <string>    //Access to std::string and std::to_string
+#include <stdexcept> //Access to std::runtime_error
+#include <concepts>  //Access to std::floating_point
+#include <algorithm> //Access to std::max
+
+#include "../grid.hpp"
+
+namespace llps::utilities {
+
+    //What a monitor does when a sample goes past its tolerances
+    enum class monitor_policy
+    {
+        log,  //Only record the sample, as every sample is
+        flag, //Also mark the run, see flagged()
+        abort //Throw monitor_error from the observer, which ends the integration
+    };
+
+    class monitor_error : public std::runtime_error
+    {
+    public:
+        monitor_error(const std::string& what, double t) :
+            std::runtime_error(what), _t(t) {}
+
+    public:
+        //Time of the sample which failed
+        double t() const noexcept { return _t; }
+
+    private:
+        double _t;
+    };
+
+    /*
+    * Checks a Model B run against what the continuous equation guarantees:
+    * the mass M = int phi is conserved, and the Ginzburg-Landau free energy
+    *   F = int (a/2 phi^2 + b/4 phi^4 + k/2 |grad phi|^2)
+    * never increases. Taken from an observer like radial_structure_factor,
+    * so a wrongly set tolerance shows within a few samples rather than at the
+    * end of the run.
+    *
+    * F comes from the chemical potential mu = a phi + b phi^3 - k lap phi of
+    * the model, which the right hand side forms anyway (see
+    * modelb::chemical_potential): the gradient term summed by parts,
+    * -k/2 phi lap phi, is phi/2 (mu - a phi - b phi^3), so
+    *   F = int (phi mu / 2 - b/4 phi^4),
+    * through the model's own laplacian and boundary, and M, F and int |phi|
+    * come out of one pass over phi and mu. A sample fails when M drifts from
+    * the first sample by more than mass_tolerance times int |phi|, the scale
+    * of its rounding, which unlike |M| does not vanish for a mixture of mean
+    * zero, or when F rises above the previous sample by more than
+    * energy_tolerance times |F|.
+    */
+    template<std::floating_point Type, size_t _rows, size_t _cols>
+    class conservation_monitor
+    {
+    public:
+        using value_type = Type;
+
+    public:
+        //Samples every sample_interval when called as an observer, or at every call if 0
+        conservation_monitor(
+            value_type b,
+            value_type mass_tolerance = 1e-10, value_type energy_tolerance = 1e-6,
+            monitor_policy policy = monitor_policy::log,
+            value_type dx = 1., value_type dy = 1., double sample_interval = 0.) :
+            _b(b), _mass_tolerance(mass_tolerance), _energy_tolerance(energy_tolerance),
+            _policy(policy), _dx(dx), _dy(dy), _interval(sample_interval) {}
+
+    public:
+        //As an observer: samples phi, with the chemical potential model.chemical_potential(phi) forms, if at least sample_interval has passed since the last sample
+        template<class Container, class Model>
+        void operator()(const llps::grid<value_type, _rows, _cols, Container>& phi, double t, Model& model)
+        {
+            if (!_times.empty() && t - _times.back() < _interval * (1 - 1e-10))
+                return;
+
+            sample(phi, model.chemical_potential(phi), t);
+        }
+
+        //mu may be any grid (padded or not) whose mu(row, col) is the chemical potential at phi(row, col)
+        template<class Container, class MuGrid>
+        void sample(const llps::grid<value_type, _rows, _cols, Container>& phi, const MuGrid& mu, double t)
+        {
+            const value_type b = _b / 4;
+
+            value_type mass = 0;
+            value_type energy = 0;
+            value_type magnitude = 0;
+
+            #pragma omp parallel for schedule(static) reduction(+:mass, energy, magnitude)
+            for (ptrdiff_t row = 0; row < static_cast<ptrdiff_t>(_rows); ++row) {
+                const value_type* phi_row = &phi(row, 0);
+                const value_type* mu_row = &mu(row, 0);
+
+                #pragma omp simd reduction(+:mass, energy, magnitude)
+                for (size_t col = 0; col < _cols; ++col) {
+                    const value_type phi_i = phi_row[col];
+                    const value_type phi_sq = phi_i * phi_i;
+
+                    mass += phi_i;
+                    magnitude += std::abs(phi_i);
+                    energy += phi_i * mu_row[col] / 2 - b * phi_sq * phi_sq;
+                }
+            }
+
+            mass *= _dx * _dy;
+            energy *= _dx * _dy;
+            magnitude *= _dx * _dy;
+
+            const bool mass_failed = !_masses.empty() && std::abs(mass - _masses.front()) > _mass_tolerance * magnitude;
+            const bool energy_failed = !_energies.empty() && energy - _energies.back() > _energy_tolerance * std::abs(_energies.back());
+
+            _times.push_back(t);
+            _masses.push_back(mass);
+            _energies.push_back(energy);
+
+            if (!(mass_failed || energy_failed))
+                return;
+
+            _violations.push_back(t);
+            _flagged = _policy != monitor_policy::log;
+
+            if (_policy == monitor_policy::abort)
+                throw monitor_error(mass_failed
+                    ? "Mass drifted by " + std::to_string(mass - _masses.front()) + " at t=" + std::to_string(t)
+                    : "Free energy rose by " + std::to_string(energy - _energies[_energies.size() - 2]) + " at t=" + std::to_string(t), t);
+        }
+
+    public:
+        size_t samples() const noexcept { return _times.size(); }
+
+        const std::vector<double>& times() const noexcept { return _times; }
+        //M of each sample
+        const std::vector<value_type>& masses() const noexcept { return _masses; }
+        //F of each sample
+        const std::vector<value_type>& energies() const noexcept { return _energies; }
+        //Times of the samples which failed
+        const std::vector<double>& violations() const noexcept { return _violations; }
+
+        //Whether a sample has failed under monitor_policy::flag (or abort); violations() records failures under every policy
+        bool flagged() const noexcept { return _flagged; }
+
+        //Largest drift of M from the first sample
+        value_type mass_drift() const noexcept
+        {
+            value_type drift = 0;
+            for (value_type mass : _masses)
+                drift = std::max(drift, std::abs(mass - _masses.front()));
+
+            return drift;
+        }
+
+    private:
+        value_type _b;
+        value_type _mass_tolerance, _energy_tolerance;
+        monitor_policy _policy;
+
+        value_type _dx, _dy;
+        double _interval;
+
+        std::vector<double> _times;
+        std::vector<value_type> _masses;
+        std::vector<value_type> _energies;
+        std::vector<double> _violations;
+        bool _flagged = false;
+    };
+
+}
+
+#endif // !LLPS_UTILITIES_MONITOR_HPP_INCLUDED
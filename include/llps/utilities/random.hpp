@@ -0,0 +1,439 @@
+#ifndef LLPS_UTILITIES_RANDOM_HPP_INCLUDED
+#define LLPS_UTILITIES_RANDOM_HPP_INCLUDED
+
+#include <array>   //Access to std::array
+#include <cstdint> //Access to uint32_t and uint64_t
+#include <cstddef> //Access to size_t and ptrdiff_t
+#include <cmath>   //Access to std::sqrt
+#include <ranges>  //Access to std::ranges::contiguous_range, data and size
+#include <numbers> //Access to std::numbers::pi, sqrt2 and ln2
+#include <bit>     //Access to std::bit_cast and std::rotl
+#include <utility> //Access to std::index_sequence
+
+namespace llps::utilities {
+
+    //Calls body(0), ..., body(count - 1) without a loop, as the vectoriser does not see through nested loops
+    template<size_t count, class Body>
+    constexpr void _unrolled(Body&& body)
+    {
+        [&]<size_t... i>(std::index_sequence<i...>) {
+            (body(i), ...);
+        }(std::make_index_sequence<count>{});
+    }
+
+    /*
+    * Philox4x32-10 counter based generator (Salmon et al., "Parallel random
+    * numbers: as easy as 1, 2, 3", SC11). Every counter maps to four
+    * independent 32 bit words under a given key, so any element of a stream
+    * can be computed on its own, in any order, on any thread.
+    */
+    struct philox4x32
+    {
+    public:
+        using counter_type = std::array<uint32_t, 4>;
+        using key_type     = std::array<uint32_t, 2>;
+
+        static constexpr size_t rounds = 10;
+
+    public:
+        static constexpr counter_type generate(counter_type counter, key_type key) noexcept
+        {
+            generate(counter[0], counter[1], counter[2], counter[3], key[0], key[1]);
+            return counter;
+        }
+
+        //In place on scalars, which (unlike arrays) vectorise across the iterations of a SIMD loop
+        static constexpr void generate(uint32_t& c0, uint32_t& c1, uint32_t& c2, uint32_t& c3, uint32_t k0, uint32_t k1) noexcept
+        {
+            _unrolled<rounds>([&](size_t) {
+                const uint64_t product0 = uint64_t(_mult0) * c0;
+                const uint64_t product1 = uint64_t(_mult1) * c2;
+
+                c0 = uint32_t(product1 >> 32) ^ c1 ^ k0;
+                c1 = uint32_t(product1);
+                c2 = uint32_t(product0 >> 32) ^ c3 ^ k1;
+                c3 = uint32_t(product0);
+
+                k0 += _weyl0;
+                k1 += _weyl1;
+            });
+        }
+
+    private:
+        static constexpr uint32_t _mult0 = 0xD2511F53;
+        static constexpr uint32_t _mult1 = 0xCD9E8D57;
+        static constexpr uint32_t _weyl0 = 0x9E3779B9;
+        static constexpr uint32_t _weyl1 = 0xBB67AE85;
+    };
+
+    /*
+    * xoshiro128+ (Blackman and Vigna, "Scrambled linear pseudorandom number
+    * generators", 2021), a sequential generator of 32 bit words from 128 bits
+    * of (not all zero) state. It takes 32 bit adds, shifts and xors only, so
+    * a step costs a fraction of a Philox block on SIMD sets without 32 bit
+    * products. Its lowest bits are the weakest, so only the upper ones
+    * should be relied on.
+    */
+    struct xoshiro128plus
+    {
+    public:
+        //In place on scalars, as philox4x32::generate
+        static constexpr uint32_t next(uint32_t& s0, uint32_t& s1, uint32_t& s2, uint32_t& s3) noexcept
+        {
+            const uint32_t result = s0 + s3;
+            const uint32_t shifted = s1 << 9;
+
+            s2 ^= s0;
+            s3 ^= s1;
+            s1 ^= s2;
+            s0 ^= s3;
+            s2 ^= shifted;
+            s3 = std::rotl(s3, 11);
+
+            return result;
+        }
+    };
+
+    /*
+    * A seed selects the key, a substream (e.g. the ensemble member) the high
+    * half of the counter, leaving 2^64 pairs of normals per substream.
+    */
+    struct random_stream
+    {
+        uint64_t seed = 0;
+        uint64_t substream = 0;
+    };
+
+    //52 high bits of hi:lo
+    constexpr uint64_t _high_bits(uint32_t hi, uint32_t lo) noexcept
+    {
+        return ((uint64_t(hi) << 32) | lo) >> 12;
+    }
+
+    /*
+    * (k + 1/2) / 2^52, uniform on the open interval (0, 1) for 52 random bits
+    * k. Goes through the bits of 1 + k / 2^52 as integer to floating point
+    * conversions of 64 bit lanes only vectorise with AVX-512.
+    */
+    constexpr double _uniform_open(uint64_t k) noexcept
+    {
+        return std::bit_cast<double>(0x3ff0000000000000ull | k) - (1. - 0x1p-53);
+    }
+
+    /*
+    * Natural logarithm of a normal, positive u, to within a few ulp. Only
+    * arithmetic and bit manipulation, unlike std::log, so that it vectorises
+    * and gives the same result in every lane and in scalar code.
+    */
+    constexpr double _log_positive(double u) noexcept
+    {
+        const uint64_t bits = std::bit_cast<uint64_t>(u);
+
+        //u = m 2^e, with m in [sqrt(1/2), sqrt(2)) so that |f| below stays small
+        const uint64_t mantissa_bits = (bits & 0x000fffffffffffffull) | 0x3ff0000000000000ull;
+        //1 when m > sqrt(2), from the sign of a difference as neither 64 bit integer compares nor their conversions vectorise everywhere
+        const uint64_t upper = (std::bit_cast<uint64_t>(std::numbers::sqrt2) - mantissa_bits) >> 63;
+
+        //Halving m through its exponent bits
+        const double mantissa = std::bit_cast<double>(mantissa_bits - (upper << 52));
+
+        //Biased exponent converted through the bits of 2^52 + e, which (unlike an integer conversion) vectorises on any SIMD set
+        const double exponent = std::bit_cast<double>(0x4330000000000000ull | ((bits >> 52) + upper)) - 0x1p52 - 1023.;
+
+        //log(m) = 2 atanh(f), whose series converges to double precision by f^21 for |f| < 0.172
+        const double f = (mantissa - 1.) / (mantissa + 1.);
+        const double f2 = f * f;
+
+        double series = 1. / 21;
+        _unrolled<10>([&](size_t i) {
+            series = series * f2 + 1. / static_cast<double>(19 - 2 * i);
+        });
+
+        return exponent * std::numbers::ln2 + 2. * f * series;
+    }
+
+    //Taylor coefficients (-1)^n / (2n + 1)! of sin(x) / x and (-1)^n / (2n)! of cos(x), enough for |x| <= pi / 4
+    inline constexpr auto _sin_coefficients = [] {
+        std::array<double, 9> coefficients{};
+        double term = 1.;
+        for (size_t n = 0; n < coefficients.size(); ++n, term /= (2. * n) * (2. * n + 1.))
+            coefficients[n] = n & 1 ? -term : term;
+        return coefficients;
+    }();
+
+    inline constexpr auto _cos_coefficients = [] {
+        std::array<double, 9> coefficients{};
+        double term = 1.;
+        for (size_t n = 0; n < coefficients.size(); ++n, term /= (2. * n - 1.) * (2. * n))
+            coefficients[n] = n & 1 ? -term : term;
+        return coefficients;
+    }();
+
+    /*
+    * sin(2 pi v) and cos(2 pi v) for v = (k + 1/2) / 2^52, to within a few
+    * ulp, for the same reasons as _log_positive. v is reduced exactly, in
+    * integers, to the nearest quarter turn, leaving |x| <= pi / 4 for the
+    * series.
+    */
+    constexpr void _sincos_turns(uint64_t k, double& sin, double& cos) noexcept
+    {
+        const uint64_t quadrant = (k + (uint64_t(1) << 49)) >> 50;
+
+        //2 (k - quadrant 2^50) + 1, odd and of magnitude below 2^50, made exact as a double through the bits of 2^52 + 2^50 + it
+        const uint64_t offset = 2 * (k - (quadrant << 50)) + 1 + (uint64_t(1) << 50);
+        const double remainder = std::bit_cast<double>(0x4330000000000000ull | offset) - (0x1p52 + 0x1p50);
+
+        const double x = remainder * (2. * std::numbers::pi * 0x1p-53);
+        const double x2 = x * x;
+
+        constexpr size_t terms = _sin_coefficients.size();
+
+        double sin_series = 0.;
+        double cos_series = 0.;
+        _unrolled<terms>([&](size_t i) {
+            sin_series = sin_series * x2 + _sin_coefficients[terms - 1 - i];
+            cos_series = cos_series * x2 + _cos_coefficients[terms - 1 - i];
+        });
+
+        const double sin_x = x * sin_series;
+        const double cos_x = cos_series;
+
+        //Rotation by the quarter turns taken off, selecting and negating through the bits so that
+        //nothing needs a branch (floating point selects may not be if-converted, as they could trap)
+        const uint64_t swap = uint64_t(0) - (quadrant & 1);
+        const uint64_t sin_sign = (quadrant & 2) << 62;
+        const uint64_t cos_sign = ((quadrant + 1) & 2) << 62;
+
+        const uint64_t sin_bits = std::bit_cast<uint64_t>(sin_x);
+        const uint64_t cos_bits = std::bit_cast<uint64_t>(cos_x);
+
+        sin = std::bit_cast<double>(((cos_bits & swap) | (sin_bits & ~swap)) ^ sin_sign);
+        cos = std::bit_cast<double>(((sin_bits & swap) | (cos_bits & ~swap)) ^ cos_sign);
+    }
+
+    /*
+    * (k + 1/2) / 2^31 for 31 random bits k, uniform on (0, 1] in single
+    * precision: from 2^24 on k + 1/2 rounds, the largest k to 1, which
+    * Box-Muller maps to a radius of 0. At least 2^-32, so radii reach
+    * sqrt(64 ln 2), 6.66.
+    */
+    constexpr float _uniform_open(uint32_t k) noexcept
+    {
+        return (static_cast<float>(static_cast<int32_t>(k)) + 0.5f) * 0x1p-31f;
+    }
+
+    //Single precision _log_positive, to within a few float ulp, the series converging by f^11
+    constexpr float _log_positive(float u) noexcept
+    {
+        const uint32_t bits = std::bit_cast<uint32_t>(u);
+
+        const uint32_t mantissa_bits = (bits & 0x007fffffu) | 0x3f800000u;
+        const uint32_t upper = (std::bit_cast<uint32_t>(std::numbers::sqrt2_v<float>) - mantissa_bits) >> 31;
+
+        const float mantissa = std::bit_cast<float>(mantissa_bits - (upper << 23));
+
+        //32 bit integer conversions vectorise on any SIMD set
+        const float exponent = static_cast<float>(static_cast<int32_t>((bits >> 23) + upper) - 127);
+
+        const float f = (mantissa - 1.f) / (mantissa + 1.f);
+        const float f2 = f * f;
+
+        float series = 1.f / 9;
+        _unrolled<4>([&](size_t i) {
+            series = series * f2 + 1.f / static_cast<float>(7 - 2 * i);
+        });
+
+        return exponent * std::numbers::ln2_v<float> + 2.f * f * series;
+    }
+
+    /*
+    * Single precision _sincos_turns, for v = (k + 1/2) / 2^25 and 25 random
+    * bits k. The remainder after the reduction, 2 (k - quadrant 2^23) + 1, is
+    * odd and below 2^23 in magnitude, so exact as a float.
+    */
+    constexpr void _sincos_turns(uint32_t k, float& sin, float& cos) noexcept
+    {
+        const uint32_t quadrant = (k + (1u << 22)) >> 23;
+        const int32_t remainder = 2 * static_cast<int32_t>(k - (quadrant << 23)) + 1;
+
+        const float x = static_cast<float>(remainder) * (2.f * std::numbers::pi_v<float> * 0x1p-26f);
+        const float x2 = x * x;
+
+        //Through x^9 and x^10, the first terms left out being below half a float ulp
+        float sin_series = 0.f;
+        _unrolled<5>([&](size_t i) {
+            sin_series = sin_series * x2 + static_cast<float>(_sin_coefficients[4 - i]);
+        });
+
+        float cos_series = 0.f;
+        _unrolled<6>([&](size_t i) {
+            cos_series = cos_series * x2 + static_cast<float>(_cos_coefficients[5 - i]);
+        });
+
+        const float sin_x = x * sin_series;
+        const float cos_x = cos_series;
+
+        const uint32_t swap = uint32_t(0) - (quadrant & 1);
+        const uint32_t sin_sign = (quadrant & 2) << 30;
+        const uint32_t cos_sign = ((quadrant + 1) & 2) << 30;
+
+        const uint32_t sin_bits = std::bit_cast<uint32_t>(sin_x);
+        const uint32_t cos_bits = std::bit_cast<uint32_t>(cos_x);
+
+        sin = std::bit_cast<float>(((cos_bits & swap) | (sin_bits & ~swap)) ^ sin_sign);
+        cos = std::bit_cast<float>(((sin_bits & swap) | (cos_bits & ~swap)) ^ cos_sign);
+    }
+
+    /*
+    * Fills range with normally distributed values, element i of the range
+    * being element first_index + i of stream. Pair p of the stream comes from
+    * counter (p, substream) through a Box-Muller transform, so the result
+    * depends only on stream and the indicies, never on the thread count or
+    * on which thread generated which element.
+    *
+    * Distributed grids pass the global index of their first owned point as
+    * first_index, and end up with the same field on any number of ranks.
+    *
+    * Pairs are generated a whole block at a time as a SIMD loop, counters
+    * and transform alike, and only then copied into range. Every pair thus
+    * takes the same path, with no scalar remainder rounding differently.
+    */
+    template<std::ranges::contiguous_range Range>
+    void fill_normal(Range&& range, random_stream stream, double mean = 0., double stddev = 1., uint64_t first_index = 0)
+    {
+        using value_type = std::ranges::range_value_t<Range>;
+
+        value_type* data = std::ranges::data(range);
+        const uint64_t size = static_cast<uint64_t>(std::ranges::size(range));
+
+        if (size == 0)
+            return;
+
+        const uint32_t key0 = uint32_t(stream.seed);
+        const uint32_t key1 = uint32_t(stream.seed >> 32);
+        const uint32_t substream0 = uint32_t(stream.substream);
+        const uint32_t substream1 = uint32_t(stream.substream >> 32);
+
+        const uint64_t first_pair = first_index / 2;
+        const uint64_t last_pair = (first_index + size - 1) / 2;
+
+        static constexpr ptrdiff_t block = 64;
+        const ptrdiff_t blocks = static_cast<ptrdiff_t>((last_pair - first_pair) / block + 1);
+
+        #pragma omp parallel for schedule(static)
+        for (ptrdiff_t b = 0; b < blocks; ++b) {
+            const uint64_t block_first = first_pair + static_cast<uint64_t>(b) * block;
+
+            alignas(64) double normals[2][block];
+
+            #pragma omp simd
+            for (ptrdiff_t i = 0; i < block; ++i) {
+                const uint64_t pair = block_first + static_cast<uint64_t>(i);
+
+                uint32_t c0 = uint32_t(pair), c1 = uint32_t(pair >> 32);
+                uint32_t c2 = substream0, c3 = substream1;
+                philox4x32::generate(c0, c1, c2, c3, key0, key1);
+
+                const double radius = std::sqrt(-2. * _log_positive(_uniform_open(_high_bits(c0, c1))));
+
+                double sin, cos;
+                _sincos_turns(_high_bits(c2, c3), sin, cos);
+
+                normals[0][i] = mean + stddev * radius * cos;
+                normals[1][i] = mean + stddev * radius * sin;
+            }
+
+            for (ptrdiff_t i = 0; i < block; ++i) {
+                const uint64_t pair = block_first + static_cast<uint64_t>(i);
+                if (pair > last_pair)
+                    break;
+
+                for (uint64_t part = 0; part < 2; ++part) {
+                    const uint64_t index = 2 * pair + part;
+                    if (index >= first_index && index < first_index + size)
+                        data[index - first_index] = static_cast<value_type>(normals[part][i]);
+                }
+            }
+        }
+    }
+
+    //Box-Muller pair of two words of one of the generators of fill_normal_pairs, upper bits first
+    template<class Type>
+    inline void _normal_pair(uint32_t& s0, uint32_t& s1, uint32_t& s2, uint32_t& s3, Type& x, Type& y) noexcept
+    {
+        const uint32_t radius_bits = xoshiro128plus::next(s0, s1, s2, s3);
+        const uint32_t angle_bits = xoshiro128plus::next(s0, s1, s2, s3);
+
+        const float radius = std::sqrt(-2.f * _log_positive(_uniform_open(radius_bits >> 1)));
+
+        float sin, cos;
+        _sincos_turns(angle_bits >> 7, sin, cos);
+
+        x = static_cast<Type>(radius * cos);
+        y = static_cast<Type>(radius * sin);
+    }
+
+    //Generators a row of fill_normal_pairs is shared between
+    inline constexpr size_t _normal_lanes = 8;
+
+    /*
+    * Fills x[0, count) and y[0, count) with independent standard normals,
+    * x[i] and y[i] being the two of one Box-Muller pair, as row `row` of
+    * stream. Meant for fields drawn a row at a time (see conserved_noise),
+    * for a fraction of the cost per normal of fill_normal:
+    *   - Philox only seeds the _normal_lanes xoshiro128+ generators of the
+    *     row, generator i then drawing pairs i, i + _normal_lanes, ...
+    *   - the transform is in single precision, so four lanes to an SSE2
+    *     register rather than two, and good to a few float ulp.
+    * A row depends only on stream, row and count, never on the SIMD width or
+    * the thread which drew it. Its seeds are pairs row _normal_lanes to
+    * (row + 1) _normal_lanes - 1 of stream as fill_normal numbers them, so a
+    * stream should be used by one or the other.
+    */
+    template<class Type>
+    void fill_normal_pairs(Type* x, Type* y, size_t count, random_stream stream, uint64_t row)
+    {
+        static constexpr size_t lanes = _normal_lanes;
+
+        alignas(64) std::array<uint32_t, lanes> s0, s1, s2, s3;
+
+        #pragma omp simd
+        for (size_t lane = 0; lane < lanes; ++lane) {
+            const uint64_t pair = row * lanes + lane;
+
+            uint32_t c0 = uint32_t(pair), c1 = uint32_t(pair >> 32);
+            uint32_t c2 = uint32_t(stream.substream), c3 = uint32_t(stream.substream >> 32);
+            philox4x32::generate(c0, c1, c2, c3, uint32_t(stream.seed), uint32_t(stream.seed >> 32));
+
+            //An all zero state would stay so, one in 2^128
+            s0[lane] = c0;
+            s1[lane] = c1;
+            s2[lane] = c2;
+            s3[lane] = c3 | uint32_t((c0 | c1 | c2 | c3) == 0);
+        }
+
+        size_t first = 0;
+        for (; first + lanes <= count; first += lanes) {
+            #pragma omp simd
+            for (size_t lane = 0; lane < lanes; ++lane)
+                _normal_pair(s0[lane], s1[lane], s2[lane], s3[lane], x[first + lane], y[first + lane]);
+        }
+
+        //The last pairs through a block, taking the same path as the others
+        if (first < count) {
+            alignas(64) std::array<Type, lanes> x_rest, y_rest;
+
+            #pragma omp simd
+            for (size_t lane = 0; lane < lanes; ++lane)
+                _normal_pair(s0[lane], s1[lane], s2[lane], s3[lane], x_rest[lane], y_rest[lane]);
+
+            for (size_t lane = 0; first + lane < count; ++lane) {
+                x[first + lane] = x_rest[lane];
+                y[first + lane] = y_rest[lane];
+            }
+        }
+    }
+
+}
+
+#endif // !LLPS_UTILITIES_RANDOM_HPP_INCLUDED
@@ -0,0 +1,76 @@
+#ifndef LLPS_UTILITIES_REDUCTION_HPP_INCLUDED
+#define LLPS_UTILITIES_REDUCTION_HPP_INCLUDED
+
+#include <cstddef>  //Access to ptrdiff_t and size_t
+#include <cmath>    //Access to std::sqrt
+#include <limits>   //Access to std::numeric_limits
+#include <ranges>   //Access to std::ranges::contiguous_range, data and size
+#include <concepts> //Access to std::floating_point
+
+namespace llps::utilities {
+
+    /*
+    * Minimum, maximum, sum and sum of squares of a field. The sum is the
+    * discrete mass (times dx dy), and the sum of squares gives the L2 norm.
+    * Summaries of separate fields, e.g. consecutive frames, merge with +=.
+    */
+    template<std::floating_point Type>
+    struct field_summary
+    {
+    public:
+        Type min = std::numeric_limits<Type>::max();
+        Type max = std::numeric_limits<Type>::lowest();
+        Type sum = 0;
+        Type square_sum = 0;
+        size_t count = 0;
+
+    public:
+        Type mean() const noexcept { return count > 0 ? sum / count : Type(0); }
+        Type l2_norm() const noexcept { return std::sqrt(square_sum); }
+
+        field_summary& operator+=(const field_summary& other) noexcept
+        {
+            min = other.min < min ? other.min : min;
+            max = other.max > max ? other.max : max;
+            sum += other.sum;
+            square_sum += other.square_sum;
+            count += other.count;
+
+            return *this;
+        }
+    };
+
+    /*
+    * All four reductions of field_summary in a single threaded, vectorised
+    * pass over range, rather than one pass (and one read of the field from
+    * memory) for each.
+    */
+    template<std::ranges::contiguous_range Range>
+    auto summarise(const Range& range)
+    {
+        using value_type = std::ranges::range_value_t<Range>;
+
+        const value_type* data = std::ranges::data(range);
+        const ptrdiff_t size = static_cast<ptrdiff_t>(std::ranges::size(range));
+
+        value_type min = std::numeric_limits<value_type>::max();
+        value_type max = std::numeric_limits<value_type>::lowest();
+        value_type sum = 0;
+        value_type square_sum = 0;
+
+        #pragma omp parallel for simd schedule(static) reduction(min:min) reduction(max:max) reduction(+:sum, square_sum)
+        for (ptrdiff_t i = 0; i < size; ++i) {
+            const value_type value = data[i];
+
+            min = value < min ? value : min;
+            max = value > max ? value : max;
+            sum += value;
+            square_sum += value * value;
+        }
+
+        return field_summary<value_type>{ min, max, sum, square_sum, static_cast<size_t>(size) };
+    }
+
+}
+
+#endif // !LLPS_UTILITIES_REDUCTION_HPP_INCLUDED
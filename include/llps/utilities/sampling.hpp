@@ -0,0 +1,189 @@
+#ifndef LLPS_UTILITIES_SAMPLING_HPP_INCLUDED
+#define LLPS_UTILITIES_SAMPLING_HPP_INCLUDED
+
+#include <vector>    //Access to std::vector
+#include <cstddef>   //Access to ptrdiff_t and size_t
+#include <cmath>     //Access to std::pow and std::sqrt
+#include <limits>    //Access to std::numeric_limits
+#include <ranges>    //Access to std::ranges::contiguous_range, range_value_t, data and size
+#include <concepts>  //Access to std::floating_point
+#include <algorithm> //Access to std::copy
+#include <cassert>   //Access to assert
+
+namespace llps::utilities {
+
+    /*
+    * Samplers decide, from an observer, whether the state at t should be
+    * sampled, in place of the fixed "t - last_t >= sample_int" test: call
+    * them at every observer call and write a frame when they return true.
+    * Steps rarely land on the times asked for, so the frame is taken at the
+    * first step at or after them, and sample times must be stored with the
+    * frames, as video_stream does.
+    */
+
+    /*
+    * Samples uniformly in log(t): count times from t_first to t_last, each
+    * a constant factor after the last, so the fast early dynamics (spinodal
+    * decomposition) get as many frames per decade as the slow, logarithmic
+    * coarsening after. Scheduled times passed over by a single step are
+    * skipped rather than sampled several times at once.
+    */
+    class log_time_sampler
+    {
+    public:
+        log_time_sampler(double t_first, double t_last, size_t count) :
+            _t_first(t_first), _ratio(count > 1 ? std::pow(t_last / t_first, 1. / (count - 1)) : 1.), _count(count)
+        {
+            assert(t_first > 0. && t_last >= t_first);
+        }
+
+    public:
+        bool operator()(double t)
+        {
+            if (_next >= _count || t < _scheduled(_next) * (1 - 1e-10))
+                return false;
+
+            //First scheduled time after t
+            while (_next < _count && _scheduled(_next) <= t * (1 + 1e-10))
+                ++_next;
+
+            return true;
+        }
+
+    public:
+        //Scheduled times not yet passed
+        size_t remaining() const noexcept { return _count - _next; }
+
+    private:
+        double _scheduled(size_t index) const { return _t_first * std::pow(_ratio, static_cast<double>(index)); }
+
+    private:
+        double _t_first, _ratio;
+        size_t _count;
+        size_t _next = 0;
+    };
+
+    /*
+    * Samples when the field has changed enough since the last sample,
+    *   ||phi - phi_last||_2 > relative_change * ||phi_last||_2,
+    * so frames follow the dynamics rather than the clock: dense while the
+    * pattern forms, sparse once it only coarsens. min_interval stops fast
+    * dynamics sampling every step, and max_interval still samples a state
+    * which has stopped changing every so often. The first call is always
+    * sampled.
+    *
+    * phi is a contiguous range of values, or a range of them, such as the
+    * std::array of fields of the coupled drivers, taken as one state. Both
+    * norms come from one pass, and the last sample is only copied when one
+    * is taken.
+    */
+    template<std::floating_point Type>
+    class change_sampler
+    {
+    public:
+        using value_type = Type;
+
+    public:
+        change_sampler(value_type relative_change, double min_interval = 0., double max_interval = std::numeric_limits<double>::infinity()) :
+            _change(relative_change), _min_interval(min_interval), _max_interval(max_interval) {}
+
+    public:
+        template<class Fields>
+        bool operator()(const Fields& phi, double t)
+        {
+            if (_sampled && t - _last_t < _min_interval * (1 - 1e-10))
+                return false;
+
+            const bool sample = !_sampled || t - _last_t >= _max_interval * (1 - 1e-10) || _changed(phi);
+            if (!sample)
+                return false;
+
+            _store(phi, 0);
+            _sampled = true;
+            _last_t = t;
+
+            return true;
+        }
+
+    public:
+        //Relative change of the last call
+        value_type last_change() const noexcept { return _last_change; }
+
+    private:
+        //Whether phi has moved far enough from the last sample
+        template<class Fields>
+        bool _changed(const Fields& phi)
+        {
+            value_type difference_sq = 0;
+            value_type norm_sq = 0;
+            _accumulate(phi, 0, difference_sq, norm_sq);
+
+            _last_change = norm_sq > 0 ? std::sqrt(difference_sq / norm_sq) : std::numeric_limits<value_type>::infinity();
+            return _last_change > _change;
+        }
+
+        template<class Fields>
+        size_t _accumulate(const Fields& phi, size_t offset, value_type& difference_sq, value_type& norm_sq) const
+        {
+            if constexpr (std::ranges::contiguous_range<Fields> && std::floating_point<std::ranges::range_value_t<Fields>>) {
+                const value_type* data = std::ranges::data(phi);
+                const value_type* last = _last.data() + offset;
+                const ptrdiff_t size = static_cast<ptrdiff_t>(std::ranges::size(phi));
+
+                value_type difference = 0;
+                value_type norm = 0;
+
+                #pragma omp parallel for simd schedule(static) reduction(+:difference, norm)
+                for (ptrdiff_t i = 0; i < size; ++i) {
+                    difference += (data[i] - last[i]) * (data[i] - last[i]);
+                    norm += last[i] * last[i];
+                }
+
+                difference_sq += difference;
+                norm_sq += norm;
+
+                return offset + size;
+            }
+            else {
+                for (const auto& field : phi)
+                    offset = _accumulate(field, offset, difference_sq, norm_sq);
+
+                return offset;
+            }
+        }
+
+        template<class Fields>
+        size_t _store(const Fields& phi, size_t offset)
+        {
+            if constexpr (std::ranges::contiguous_range<Fields> && std::floating_point<std::ranges::range_value_t<Fields>>) {
+                const size_t size = std::ranges::size(phi);
+                if (_last.size() < offset + size)
+                    _last.resize(offset + size);
+
+                const value_type* data = std::ranges::data(phi);
+                std::copy(data, data + size, _last.data() + offset);
+
+                return offset + size;
+            }
+            else {
+                for (const auto& field : phi)
+                    offset = _store(field, offset);
+
+                return offset;
+            }
+        }
+
+    private:
+        value_type _change;
+        double _min_interval, _max_interval;
+
+        bool _sampled = false;
+        double _last_t = 0.;
+        value_type _last_change = 0;
+
+        std::vector<value_type> _last;
+    };
+
+}
+
+#endif // !LLPS_UTILITIES_SAMPLING_HPP_INCLUDED
@@ -0,0 +1,128 @@
+#ifndef LLPS_UTILITIES_STEADY_STATE_HPP_INCLUDED
+#define LLPS_UTILITIES_STEADY_STATE_HPP_INCLUDED
+
+#include <vector>   //Access to std::vector
+#include <cstddef>  //Access to ptrdiff_t and size_t
+#include <cmath>    //Access to std::sqrt
+#include <limits>   //Access to std::numeric_limits
+#include <ranges>   //Access to std::ranges::contiguous_range, data and size
+#include <concepts> //Access to std::floating_point
+#include <cassert>  //Access to assert
+
+namespace llps::utilities {
+
+    /*
+    * Decides when a run has become stationary, e.g. an arrested microphase
+    * pattern, from a rate sampled over the run: the RMS of dphi/dt, taken
+    * from successive states when used as an observer, or any other rate
+    * handed to update(), such as |dF/dt| / |F| from a conservation_monitor.
+    *
+    * With hysteresis: the run becomes stationary once the rate has stayed
+    * below enter_tolerance for hold samples in a row, and only stops being
+    * so when the rate rises above exit_tolerance, so a rate hovering about a
+    * single threshold does not toggle the decision at every sample.
+    */
+    template<std::floating_point Type>
+    class steady_state_detector
+    {
+    public:
+        using value_type = Type;
+
+    public:
+        //Samples every sample_interval when called as an observer, or at every call if 0
+        steady_state_detector(value_type enter_tolerance, value_type exit_tolerance, size_t hold = 3, double sample_interval = 0.) :
+            _enter(enter_tolerance), _exit(exit_tolerance), _hold(hold), _interval(sample_interval)
+        {
+            assert(enter_tolerance <= exit_tolerance);
+        }
+
+    public:
+        //As an observer: the RMS of dphi/dt between phi and the state of the last sample, once at least sample_interval has passed
+        template<std::ranges::contiguous_range Range>
+        bool operator()(const Range& phi, double t)
+        {
+            if (!_previous.empty() && t - _previous_t < _interval * (1 - 1e-10))
+                return _stationary;
+
+            const value_type* data = std::ranges::data(phi);
+            const ptrdiff_t size = static_cast<ptrdiff_t>(std::ranges::size(phi));
+
+            if (_previous.empty()) {
+                _previous.assign(data, data + size);
+                _previous_t = t;
+                return _stationary;
+            }
+
+            value_type* previous = _previous.data();
+            value_type square_sum = 0;
+
+            //Difference and copy in one pass, the previous state is not read again
+            #pragma omp parallel for simd schedule(static) reduction(+:square_sum)
+            for (ptrdiff_t i = 0; i < size; ++i) {
+                const value_type difference = data[i] - previous[i];
+                square_sum += difference * difference;
+                previous[i] = data[i];
+            }
+
+            const double elapsed = t - _previous_t;
+            _previous_t = t;
+
+            return update(std::sqrt(square_sum / size) / static_cast<value_type>(elapsed), t);
+        }
+
+        //Takes the next sample of the rate, returning whether the run is now stationary
+        bool update(value_type rate, double t)
+        {
+            _times.push_back(t);
+            _rates.push_back(rate);
+
+            if (_stationary) {
+                if (rate > _exit) {
+                    _stationary = false;
+                    _below = 0;
+                }
+            }
+            else if (rate < _enter) {
+                if (++_below >= _hold) {
+                    _stationary = true;
+                    _stationary_since = t;
+                }
+            }
+            else {
+                _below = 0;
+            }
+
+            return _stationary;
+        }
+
+    public:
+        bool stationary() const noexcept { return _stationary; }
+
+        //Time of the sample at which the run last became stationary, NaN if it never has
+        double stationary_since() const noexcept { return _stationary_since; }
+
+        size_t samples() const noexcept { return _times.size(); }
+
+        const std::vector<double>& times() const noexcept { return _times; }
+        //Rate of each sample
+        const std::vector<value_type>& rates() const noexcept { return _rates; }
+
+    private:
+        value_type _enter, _exit;
+        size_t _hold;
+        double _interval;
+
+        bool _stationary = false;
+        size_t _below = 0;
+        double _stationary_since = std::numeric_limits<double>::quiet_NaN();
+
+        std::vector<value_type> _previous;
+        double _previous_t = 0.;
+
+        std::vector<double> _times;
+        std::vector<value_type> _rates;
+    };
+
+}
+
+#endif // !LLPS_UTILITIES_STEADY_STATE_HPP_INCLUDED
@@ -0,0 +1,180 @@
+#ifndef LLPS_UTILITIES_STRUCTURE_FACTOR_HPP_INCLUDED
+#define LLPS_UTILITIES_STRUCTURE_FACTOR_HPP_INCLUDED
+
+#include <vector>    //Access to std::vector
+#include <cstddef>   //Access to size_t
+#include <cstdint>   //Access to int32_t
+#include <cmath>     //Access to std::sqrt, std::floor and std::lround
+#include <numbers>   //Access to std::numbers::pi
+#include <ranges>    //Access to std::ranges::forward_range
+#include <concepts>  //Access to std::floating_point
+#include <algorithm> //Access to std::max and std::min
+
+#include "../calculus/differentiate.hpp"
+#include "../grid.hpp"
+
+namespace llps::utilities {
+
+    /*
+    * Circularly averaged structure factor S(k, t) and characteristic length
+    * L(t), computed in situ from the fields handed to it by an observer, so
+    * that frames need not be kept:
+    *   S(k) = <|phi_q|^2>_{|q| in bin k} / (rows * cols),
+    *   L    = 2 pi sum_k S(k) / sum_k k S(k)   (k > 0),
+    * the inverse of the first moment of S. Bins are shells of the width of
+    * the coarser fundamental wavenumber 2 pi / max(rows dy, cols dx), up to
+    * the lower of the two Nyquist wavenumbers; the corners beyond are left out.
+    *
+    * Shells are averaged over the full spectrum, each half spectrum mode
+    * standing in for its conjugate as well, and k of a shell is the mean |q|
+    * of its modes. The transform goes through spectral_operator, which also
+    * handles the alignment and backend.
+    */
+    template<std::floating_point Type, size_t _rows, size_t _cols>
+    class radial_structure_factor
+    {
+    public:
+        using value_type = Type;
+
+        static constexpr size_t freq_cols = _cols / 2 + 1;
+
+    public:
+        //Samples every sample_interval when called as an observer, or at every call if 0
+        radial_structure_factor(value_type dx = 1., value_type dy = 1., double sample_interval = 0.) :
+            _operator(dx, dy), _interval(sample_interval), _bin(_rows * freq_cols, -1), _weight(_rows * freq_cols, 0)
+        {
+            const value_type x_freq_elem = 2. * std::numbers::pi / (_cols * dx);
+            const value_type y_freq_elem = 2. * std::numbers::pi / (_rows * dy);
+
+            const value_type bin_width = std::min(x_freq_elem, y_freq_elem);
+            const value_type k_max = std::numbers::pi / std::max(dx, dy);
+
+            const size_t bins = static_cast<size_t>(std::floor(k_max / bin_width + 0.5)) + 1;
+            _wavenumbers.assign(bins, 0.);
+            _counts.assign(bins, 0.);
+
+            for (size_t row = 0, i = 0; row < _rows; ++row) {
+                const value_type kappa_y = y_freq_elem * calculus::freq_index(row, _rows);
+
+                for (size_t col = 0; col < freq_cols; ++col, ++i) {
+                    const value_type kappa_x = x_freq_elem * col;
+                    const value_type kappa = std::sqrt(kappa_x * kappa_x + kappa_y * kappa_y);
+
+                    const size_t bin = static_cast<size_t>(std::lround(kappa / bin_width));
+                    if (bin >= bins)
+                        continue;
+
+                    //Columns other than 0 and the Nyquist column have their conjugate in the missing half
+                    const bool self_conjugate = col == 0 || 2 * col == _cols;
+
+                    _bin[i] = static_cast<int32_t>(bin);
+                    _weight[i] = self_conjugate ? 1. : 2.;
+
+                    _wavenumbers[bin] += _weight[i] * kappa;
+                    _counts[bin] += _weight[i];
+                }
+            }
+
+            for (size_t bin = 0; bin < bins; ++bin)
+                _wavenumbers[bin] = _counts[bin] > 0 ? _wavenumbers[bin] / _counts[bin] : bin * bin_width;
+        }
+
+    public:
+        //As an observer: samples phi if at least sample_interval has passed since the last sample
+        template<class Fields>
+        void operator()(const Fields& phi, double t)
+        {
+            if (!_times.empty() && t - _times.back() < _interval * (1 - 1e-10))
+                return;
+
+            sample(phi, t);
+        }
+
+        template<class Container>
+        void sample(const llps::grid<value_type, _rows, _cols, Container>& phi, double t)
+        {
+            std::vector<value_type>& values = _values.emplace_back(_counts.size(), 0.);
+
+            _accumulate(phi, values);
+            _finish(values, 1, t);
+        }
+
+        //Averages S over several realisations of the field, all at time t, e.g. the members of an ensemble
+        template<std::ranges::forward_range Members>
+        void sample(const Members& members, double t)
+        {
+            std::vector<value_type>& values = _values.emplace_back(_counts.size(), 0.);
+
+            size_t count = 0;
+            for (const auto& member : members) {
+                _accumulate(member, values);
+                ++count;
+            }
+
+            _finish(values, count, t);
+        }
+
+    public:
+        size_t samples() const noexcept { return _times.size(); }
+        size_t bins() const noexcept { return _wavenumbers.size(); }
+
+        //Mean |k| of each shell
+        const std::vector<value_type>& wavenumbers() const noexcept { return _wavenumbers; }
+
+        const std::vector<double>& times() const noexcept { return _times; }
+        //S(k) of each sample, over wavenumbers()
+        const std::vector<std::vector<value_type>>& values() const noexcept { return _values; }
+        //L(t) of each sample
+        const std::vector<value_type>& lengths() const noexcept { return _lengths; }
+
+    private:
+        template<class Container>
+        void _accumulate(const llps::grid<value_type, _rows, _cols, Container>& phi, std::vector<value_type>& values)
+        {
+            _operator.forward(phi);
+            const value_type* spectrum = reinterpret_cast<const value_type*>(_operator.spectrum());
+
+            for (size_t i = 0; i < _bin.size(); ++i) {
+                if (_bin[i] >= 0)
+                    values[_bin[i]] += _weight[i] * (spectrum[2 * i] * spectrum[2 * i] + spectrum[2 * i + 1] * spectrum[2 * i + 1]);
+            }
+        }
+
+        //Normalises the sums of count realisations into S, and takes L from its first moment
+        void _finish(std::vector<value_type>& values, size_t count, double t)
+        {
+            value_type moment0 = 0.;
+            value_type moment1 = 0.;
+            for (size_t bin = 0; bin < values.size(); ++bin) {
+                if (_counts[bin] > 0)
+                    values[bin] /= _counts[bin] * count * static_cast<value_type>(_rows * _cols);
+
+                if (bin > 0) {
+                    moment0 += values[bin];
+                    moment1 += _wavenumbers[bin] * values[bin];
+                }
+            }
+
+            _times.push_back(t);
+            _lengths.push_back(moment1 > 0 ? 2. * std::numbers::pi * moment0 / moment1 : 0.);
+        }
+
+    private:
+        calculus::spectral_operator<value_type, _rows, _cols> _operator;
+        double _interval;
+
+        //Shell of each half spectrum mode (-1 if beyond the last), and how many modes of the full spectrum it stands for
+        std::vector<int32_t> _bin;
+        std::vector<value_type> _weight;
+
+        std::vector<value_type> _wavenumbers;
+        std::vector<value_type> _counts;
+
+        std::vector<double> _times;
+        std::vector<std::vector<value_type>> _values;
+        std::vector<value_type> _lengths;
+    };
+
+}
+
+#endif // !LLPS_UTILITIES_STRUCTURE_FACTOR_HPP_INCLUDED
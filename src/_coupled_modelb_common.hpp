@@ -0,0 +1,237 @@
+#ifndef _COUPLED_MODELB_COMMON_HPP_INCLUDED
+#define _COUPLED_MODELB_COMMON_HPP_INCLUDED
+
+#include <array>     //Access to std::array
+#include <vector>    //Access to std::vector
+#include <cstddef>   //Access to size_t and ptrdiff_t
+#include <algorithm> //Access to std::min and std::max
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif // _OPENMP
+
+#include "llps/calculus/differentiate.hpp"
+#include "llps/aligned_allocator.hpp"
+#include "llps/grid.hpp"
+
+/*
+* Model B for N interacting species, where the chemical potential of species i
+* is
+*
+*   mu_i = a_i phi_i + b_i phi_i^3 - k_i lap(phi_i) + sum_{j != i} xi_ij phi_j
+*
+* and each species may switch into any other at rate rates_ij (i -> j):
+*
+*   dphi_i/dt = lap(mu_i) + sum_{j != i} (rates_ji phi_j - rates_ij phi_i)
+*
+* A purely diffusive species with coefficient D is obtained with a = D, b = k = 0.
+* Diagonal entries of xi and rates are ignored.
+*
+* Both laplacians are fused into one sweep over the tiles of
+* laplacian_central_fd, shared between threads in the same way. Within a tile, the rows of mu of every species are
+* written into a ring of order + 1 rows per thread, and each row of dphi is
+* taken as soon as the rows of mu it reaches are in it. mu never goes to
+* memory, and phi is still in cache for the coupling and switching terms, so
+* a species reads phi and writes dphi once per call, where two separate
+* sweeps also write and read back mu. The price is the order rows and
+* columns of mu around each tile, which are computed by both tiles they
+* border: taller tiles waste less. The state type is
+* std::array<field_type, N>, to be integrated with array_of_ranges_algebra.
+*/
+template<size_t order, class FieldType, size_t N>
+struct coupled_modelb
+{
+public:
+    using field_type  = FieldType;
+    using state_type  = std::array<field_type, N>;
+    using value_type  = typename field_type::value_type;
+    using vector_type = std::array<value_type, N>;
+    using matrix_type = std::array<vector_type, N>;
+
+public:
+    //Tile of the sweep, zeros for its own estimate (see _block_cols), as in modelb, and dx along the columns and dy along the rows, which may differ
+    coupled_modelb(vector_type a, vector_type b, vector_type k, matrix_type xi, matrix_type rates, llps::calculus::fd2D_tile tile = {}, value_type dx = 1., value_type dy = 1.) :
+        _a(a), _b(b), _k(k), _xi(xi), _switching{},
+        _tile{ tile.rows == 0 ? llps::calculus::_fd2D_band_rows : tile.rows, tile.cols == 0 ? _block_cols() : tile.cols }
+    {
+        static constexpr auto stencil = llps::calculus::central_fd_stencil<order, value_type>(2);
+
+        for (size_t i = 0; i <= order; ++i) {
+            _x_weights[i] = stencil[i] / (dx * dx);
+            _y_weights[i] = stencil[i] / (dy * dy);
+        }
+
+        //Fold the rates into a single matrix: inflow off the diagonal, total outflow on it
+        for (size_t i = 0; i < N; ++i) {
+            _xi[i][i] = 0.;
+
+            for (size_t j = 0; j < N; ++j) {
+                if (i != j) {
+                    _switching[i][j]  = rates[j][i];
+                    _switching[i][i] -= rates[i][j];
+                }
+            }
+        }
+
+        //A whole number of cache lines per ring row, so no two rows share one
+        _ring_cols = (std::min(_tile.cols, field_type::cols()) + order + 7) / 8 * 8;
+    }
+
+public:
+    void operator()(const state_type& phi, state_type& dphi, double)
+    {
+        static constexpr size_t rows = field_type::rows();
+        static constexpr size_t cols = field_type::cols();
+        static constexpr size_t offset = order / 2;
+
+        const size_t ring_size = N * (order + 1) * _ring_cols;
+
+#ifdef _OPENMP
+        const size_t threads = static_cast<size_t>(omp_get_max_threads());
+#else
+        const size_t threads = 1;
+#endif // _OPENMP
+
+        //Kept between calls, so that no call allocates
+        if (_rings.size() < threads * ring_size)
+            _rings.resize(threads * ring_size);
+
+        const ptrdiff_t bands = static_cast<ptrdiff_t>((rows + _tile.rows - 1) / _tile.rows);
+        const ptrdiff_t blocks = static_cast<ptrdiff_t>((cols + _tile.cols - 1) / _tile.cols);
+
+        #pragma omp parallel
+        {
+#ifdef _OPENMP
+            value_type* ring = _rings.data() + static_cast<size_t>(omp_get_thread_num()) * ring_size;
+#else
+            value_type* ring = _rings.data();
+#endif // _OPENMP
+
+            #pragma omp for collapse(2) schedule(static)
+            for (ptrdiff_t band = 0; band < bands; ++band)
+            {
+                for (ptrdiff_t block = 0; block < blocks; ++block)
+                {
+                    const size_t row_begin = band * _tile.rows;
+                    const size_t row_end = std::min(row_begin + _tile.rows, rows);
+                    const size_t col_begin = block * _tile.cols;
+                    const size_t col_end = std::min(col_begin + _tile.cols, cols);
+
+                    //mu of row_begin - offset + r goes to ring row r % (order + 1)
+                    for (size_t r = 0; r < row_end - row_begin + order; ++r) {
+                        _mu_row(phi, ring, r % (order + 1), llps::calculus::_wrap_back(row_begin + r, offset, rows), col_begin, col_end);
+
+                        if (r >= order)
+                            _dphi_row(phi, dphi, ring, r + 1, row_begin + r - order, col_begin, col_end);
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    /*
+    * Columns of a tile unless given, such that the rings and the rows of phi
+    * they are computed from, 2 N (order + 1) rows in all, fit in a typical
+    * (1MiB) L2 cache, in whole cache lines. Unlike the segments of
+    * laplacian_central_fd, the rows of a ring are not meant to stay in L1, and
+    * wider tiles compute fewer columns of mu twice.
+    */
+    static consteval size_t _block_cols()
+    {
+        constexpr size_t cache_size = 1024 * 1024;
+        constexpr size_t line = 64 / sizeof(value_type);
+        constexpr size_t cols = cache_size / (2 * N * (order + 1) * sizeof(value_type));
+
+        return std::max<size_t>(cols / line * line, line);
+    }
+
+    //mu of columns [col_begin - offset, col_end + offset) of row, wrapped, into ring row slot of every species
+    void _mu_row(const state_type& phi, value_type* ring, size_t slot, size_t row, size_t col_begin, size_t col_end) const
+    {
+        static constexpr size_t rows = field_type::rows();
+        static constexpr size_t cols = field_type::cols();
+        static constexpr size_t offset = order / 2;
+
+        for (size_t i = 0; i < N; ++i) {
+            const value_type a = _a[i], b = _b[i], k = _k[i];
+            const value_type* phi_i = phi[i].data() + row * cols;
+            value_type* mu = ring + (i * (order + 1) + slot) * _ring_cols;
+
+            std::array<const value_type*, order + 1> row_ptrs;
+            for (size_t j = 0; j <= order; ++j)
+                row_ptrs[j] = phi[i].data() + llps::calculus::_wrap_back(row + j, offset, rows) * cols;
+
+            //In pieces which do not wrap, counted from a whole number of rows on so that first never goes below 0
+            static constexpr size_t shift = (offset / cols + 1) * cols;
+
+            size_t ring_col = 0;
+            for (size_t first = col_begin + shift - offset, last = col_end + shift + offset; first < last;) {
+                const size_t col = first % cols;
+                const size_t piece = std::min(last - first, cols - col);
+
+                llps::calculus::_laplacian_fd_segment<order>(row_ptrs, mu + ring_col, col, col + piece, cols, _x_weights, _y_weights);
+
+                value_type* mu_piece = mu + ring_col;
+                const value_type* phi_piece = phi_i + col;
+
+                #pragma omp simd
+                for (size_t index = 0; index < piece; ++index)
+                    mu_piece[index] = phi_piece[index] * (a + b * phi_piece[index] * phi_piece[index]) - k * mu_piece[index];
+
+                //The rows of phi are still in L1, so a pass per coupling costs little
+                for (size_t j = 0; j < N; ++j)
+                    _axpy(_xi[i][j], phi[j].data() + row * cols + col, mu_piece, piece);
+
+                first += piece;
+                ring_col += piece;
+            }
+        }
+    }
+
+    //dphi of columns [col_begin, col_end) of row, the ring holding mu of the order + 1 rows around it, the oldest in ring row next % (order + 1)
+    void _dphi_row(const state_type& phi, state_type& dphi, const value_type* ring, size_t next, size_t row, size_t col_begin, size_t col_end) const
+    {
+        static constexpr size_t cols = field_type::cols();
+        static constexpr size_t offset = order / 2;
+
+        const size_t width = col_end - col_begin;
+
+        for (size_t i = 0; i < N; ++i) {
+            std::array<const value_type*, order + 1> row_ptrs;
+            for (size_t j = 0; j <= order; ++j)
+                row_ptrs[j] = ring + (i * (order + 1) + (next + j) % (order + 1)) * _ring_cols;
+
+            value_type* out = dphi[i].data() + row * cols + col_begin;
+
+            //The ring's columns are padded by offset either side, so every one is interior
+            llps::calculus::_laplacian_fd_segment<order>(row_ptrs, out, offset, offset + width, width + order, _x_weights, _y_weights);
+
+            for (size_t j = 0; j < N; ++j)
+                _axpy(_switching[i][j], phi[j].data() + row * cols + col_begin, out, width);
+        }
+    }
+
+    //out += weight * in over [0, count), skipped for uncoupled species
+    static void _axpy(value_type weight, const value_type* in, value_type* out, size_t count)
+    {
+        if (weight == 0.)
+            return;
+
+        #pragma omp simd
+        for (size_t index = 0; index < count; ++index)
+            out[index] += weight * in[index];
+    }
+
+private:
+    vector_type _a, _b, _k;
+    matrix_type _xi, _switching;
+    std::array<value_type, order + 1> _x_weights, _y_weights;
+    llps::calculus::fd2D_tile _tile;
+
+    //Rings of mu, one after the other, N * (order + 1) rows of _ring_cols each per thread
+    size_t _ring_cols;
+    std::vector<value_type, llps::aligned_allocator<value_type>> _rings;
+};
+
+#endif // !_COUPLED_MODELB_COMMON_HPP_INCLUDED
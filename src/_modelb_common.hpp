@@ -6,71 +6,265 @@
 #include <fstream>
 #include <string>
 #include <numeric>
+#include <type_traits>
 
-#include "calculus/differentiate.hpp"
-#include "utilities/io.hpp"
-#include "grid.hpp"
+#include "llps/calculus/differentiate.hpp"
+#include "llps/calculus/stencil.hpp"
+#include "llps/utilities/io.hpp"
+#include "llps/boundary.hpp"
+#include "llps/grid.hpp"
 
 //using state_type = llps::grid<double, 256, 256>;
 
-template<size_t order, class state_type>
+//Laplacian of modelb: central differences of its order, or one of the compact ones, of order 2 and 4 respectively
+enum class modelb_laplacian { central, isotropic, mehrstellen };
+
+/*
+* Boundary applies to phi. The chemical potential takes its conserving
+* form, Dirichlet walls becoming no flux, so walls never let mass through.
+* Other than periodic everywhere, phi and mu are copied into padded grids
+* whose ghost cells hold the boundary conditions. The Mehrstellen laplacian
+* is periodic only.
+*
+* The chemical potential is computed on each row of the first laplacian as
+* it is written, so it costs no pass over the grid of its own.
+*/
+template<size_t order, class state_type, class Boundary = llps::periodic_boundary, modelb_laplacian laplacian = modelb_laplacian::central>
 struct modelb
 {
+    static_assert(laplacian != modelb_laplacian::isotropic || order == 2, "the isotropic laplacian is of order 2!");
+    static_assert(laplacian != modelb_laplacian::mehrstellen || order == 4, "the Mehrstellen laplacian is of order 4!");
+    static_assert(laplacian != modelb_laplacian::mehrstellen || Boundary::is_periodic, "the Mehrstellen laplacian is periodic only!");
+
 public:
-    modelb(double a, double b, double k) :
-        _a(a), _b(b), _k(k) {}
+    //Tile of the laplacian, zeros for its own estimate, and dx along the columns and dy along the rows, which may differ
+    modelb(double a, double b, double k, llps::calculus::fd2D_tile tile = {}, double dx = 1., double dy = 1., Boundary boundary = {}) :
+        _a(a), _b(b), _k(k), _laplacian(_make_laplacian(dx, dy, tile)), _boundary(boundary) {}
 
 public:
     LLPS_FORCE_INLINE void operator()(const state_type& phi, state_type& dphi, double)
     {
-        static constexpr double dx = 1.;
-        static constexpr double dy = 1.;
-        llps::calculus::laplacian_central_fd<order>(phi, dphi, dx, dy);
-
-        auto dphi_it = dphi.begin();
-        for (auto phi_it = phi.begin(); phi_it != phi.end(); ++phi_it, ++dphi_it) {
-            const auto& phi = *phi_it;
-            *dphi_it = phi * (_a + _b * phi * phi) - _k * (*dphi_it);
+        _form_chemical_potential(phi);
+
+        if constexpr (!Boundary::is_periodic)
+            _boundary.conserving().fill_halo(_scratch.mu);
+
+        _laplacian(_scratch.mu, dphi);
+    }
+
+    /*
+    * mu of phi, as the right hand side forms it, in the model's own scratch
+    * grid (padded under walls), so valid until the next call of either. For
+    * a conservation_monitor, whose samples fall between steps rather than on
+    * the stages the right hand side is called on; costs the first of its two
+    * laplacians.
+    */
+    const auto& chemical_potential(const state_type& phi)
+    {
+        _form_chemical_potential(phi);
+        return _scratch.mu;
+    }
+
+private:
+    using _laplacian_type =
+        std::conditional_t<laplacian == modelb_laplacian::isotropic, llps::calculus::compact_laplacian_operator,
+        std::conditional_t<laplacian == modelb_laplacian::mehrstellen, llps::calculus::mehrstellen_laplacian<state_type>,
+        llps::calculus::stencil_operator<order, llps::calculus::partial<2, 0>, llps::calculus::partial<0, 2>>>>;
+
+    using _padded_type = llps::padded_grid<typename state_type::value_type, state_type::rows(), state_type::cols(), _laplacian_type::radius>;
+
+    static _laplacian_type _make_laplacian(double dx, double dy, llps::calculus::fd2D_tile tile)
+    {
+        if constexpr (laplacian == modelb_laplacian::isotropic)
+            return llps::calculus::make_isotropic_laplacian(dx, dy, tile);
+        else if constexpr (laplacian == modelb_laplacian::mehrstellen)
+            return _laplacian_type(dx, dy, tile);
+        else
+            return llps::calculus::make_stencil_operator<order>(llps::calculus::D_xx + llps::calculus::D_yy, dx, dy, tile);
+    }
+
+    void _form_chemical_potential(const state_type& phi)
+    {
+        if constexpr (Boundary::is_periodic)
+            _laplacian(phi, _scratch.mu, _chemical_potential(phi, _scratch.mu));
+        else {
+            _boundary.load(phi, _scratch.phi);
+            _laplacian(_scratch.phi, _scratch.mu, _chemical_potential(phi, _scratch.mu));
+        }
+    }
+
+    //mu = a phi + b phi^3 - k mu on each row segment of mu, once it holds the laplacian of phi
+    template<class MuGrid>
+    auto _chemical_potential(const state_type& phi, MuGrid& mu) const
+    {
+        return [&phi, &mu, a = _a, b = _b, k = _k](size_t row, size_t col_begin, size_t col_end) {
+            const auto* phi_row = &phi(row, 0);
+            auto* mu_row = &mu(row, 0);
+
+            #pragma omp simd
+            for (size_t col = col_begin; col < col_end; ++col)
+                mu_row[col] = phi_row[col] * (a + b * phi_row[col] * phi_row[col]) - k * mu_row[col];
+        };
+    }
+
+    //Kept between calls, as in modelb3D, so that no call allocates
+    struct _periodic_scratch { state_type mu; };
+    struct _padded_scratch { _padded_type phi, mu; };
+
+    double _a, _b, _k;
+    _laplacian_type _laplacian;
+
+    Boundary _boundary;
+    std::conditional_t<Boundary::is_periodic, _periodic_scratch, _padded_scratch> _scratch;
+};
+
+template<size_t order, class state_type>
+struct modelb3D
+{
+public:
+    //block_rows of the laplacian, 0 for its own estimate
+    modelb3D(double a, double b, double k, size_t block_rows = 0, double dx = 1., double dy = 1., double dz = 1.) :
+        _a(a), _b(b), _k(k), _dx(dx), _dy(dy), _dz(dz), _block_rows(block_rows), _mu() {}
+
+public:
+    void operator()(const state_type& phi, state_type& dphi, double)
+    {
+        llps::calculus::laplacian_central_fd<order>(phi, _mu, _dx, _dy, _dz, _block_rows);
+
+        const double* phi_data = phi.data();
+        double* mu_data = _mu.data();
+
+        #pragma omp parallel for schedule(static)
+        for (ptrdiff_t i = 0; i < static_cast<ptrdiff_t>(state_type::size()); ++i) {
+            const double phi_i = phi_data[i];
+            mu_data[i] = phi_i * (_a + _b * phi_i * phi_i) - _k * mu_data[i];
         }
 
-        dphi = llps::calculus::laplacian_central_fd<order>(dphi, dx, dy);
+        llps::calculus::laplacian_central_fd<order>(_mu, dphi, _dx, _dy, _dz, _block_rows);
     }
 
 private:
     double _a, _b, _k;
+    double _dx, _dy, _dz;
+    size_t _block_rows;
+    state_type _mu;
 };
 
+//Video of FrameType sized frames, streamed to file_name as they are sampled
+template<class FrameType>
+llps::utilities::video_stream<typename FrameType::value_type> open_video(const char* file_name, std::string title)
+{
+    llps::utilities::plot_header plot_header;
+    plot_header.title = title;
+    plot_header.x_label = "x";
+    plot_header.y_label = "y";
+
+    return { file_name, FrameType::cols(), FrameType::rows(), plot_header };
+}
+
+//Frames kept over a run, with their indicies standing in for sample times. Drivers which can should stream frames through open_video instead
 template<class FrameType>
 void save_to_file(const char* file_name, const std::vector<FrameType>& data, std::string title)
 {
-    using value_type = FrameType::value_type;
-
-    //Calculate minimum and maximum values
-    auto vmin = std::numeric_limits<value_type>::max();
-    auto vmax = std::numeric_limits<value_type>::min();
-    for (auto& frame : data) {
-        auto [frame_min, frame_max] = std::ranges::minmax(frame);
-        vmin = std::min(frame_min, vmin);
-        vmax = std::max(frame_max, vmax);
+    auto video = open_video<FrameType>(file_name, title);
+
+    for (size_t frame = 0; frame < data.size(); ++frame)
+        video.write(data[frame], static_cast<double>(frame));
+}
+
+//S(k) of every sample of analysis as one line each, over k
+template<class Analysis>
+void save_structure_factor(const char* file_name, const Analysis& analysis, std::string title)
+{
+    using value_type = typename Analysis::value_type;
+
+    std::ofstream file(file_name, std::ios::binary);
+
+    llps::utilities::plot_header plot_header;
+    plot_header.title = title;
+    plot_header.x_label = "k";
+    plot_header.y_label = "S(k)";
+    plot_header.x_scale = "log";
+    plot_header.y_scale = "log";
+
+    llps::utilities::serialise_plot_header(file, analysis.samples(), plot_header);
+
+    for (size_t sample = 0; sample < analysis.samples(); ++sample) {
+        llps::utilities::line_header line_header;
+        line_header.label = "t=" + std::to_string(analysis.times()[sample]);
+
+        //Shell 0 is the mean, which has no place on a log axis
+        llps::utilities::serialise_line_header<value_type, value_type>(file, analysis.bins() - 1, line_header);
+
+        for (size_t bin = 1; bin < analysis.bins(); ++bin)
+            llps::utilities::serialise_to_binary(file, analysis.wavenumbers()[bin]);
+        for (size_t bin = 1; bin < analysis.bins(); ++bin)
+            llps::utilities::serialise_to_binary(file, analysis.values()[sample][bin]);
     }
 
+    file.close();
+}
+
+//L(t) of analysis as a single line
+template<class Analysis>
+void save_domain_length(const char* file_name, const Analysis& analysis, std::string title)
+{
+    using value_type = typename Analysis::value_type;
+
     std::ofstream file(file_name, std::ios::binary);
 
     llps::utilities::plot_header plot_header;
     plot_header.title = title;
-    plot_header.x_label = "x";
-    plot_header.y_label = "y";
+    plot_header.x_label = "t";
+    plot_header.y_label = "L(t)";
+    plot_header.x_scale = "log";
+    plot_header.y_scale = "log";
+
+    llps::utilities::serialise_plot_header(file, 1, plot_header);
+    llps::utilities::serialise_line_header<double, value_type>(file, analysis.samples());
+
+    for (double t : analysis.times())
+        llps::utilities::serialise_to_binary(file, t);
+    for (value_type length : analysis.lengths())
+        llps::utilities::serialise_to_binary(file, length);
+
+    file.close();
+}
+
+//A quantity sampled over a run, e.g. the free energy of a conservation_monitor, as a single line
+template<class Value>
+void save_time_series(const char* file_name, const std::vector<double>& times, const std::vector<Value>& values, std::string title, std::string y_label)
+{
+    std::ofstream file(file_name, std::ios::binary);
+
+    llps::utilities::plot_header plot_header;
+    plot_header.title = title;
+    plot_header.x_label = "t";
+    plot_header.y_label = y_label;
 
     llps::utilities::serialise_plot_header(file, 1, plot_header);
+    llps::utilities::serialise_line_header<double, Value>(file, times.size());
 
-    llps::utilities::video_header<value_type, value_type> video_header;
-    video_header.min_max = { vmin, vmax };
+    for (double t : times)
+        llps::utilities::serialise_to_binary(file, t);
+    for (const Value& value : values)
+        llps::utilities::serialise_to_binary(file, value);
+
+    file.close();
+}
+
+//Clusters of every sample of statistics as a text table, one cluster per line
+template<class Statistics>
+void save_cluster_table(const char* file_name, const Statistics& statistics)
+{
+    std::ofstream file(file_name);
 
-    llps::utilities::serialise_video_header(file, FrameType::cols(), FrameType::rows(), data.size(), video_header);
+    file << "# t cluster size x y\n";
+    for (size_t sample = 0; sample < statistics.samples(); ++sample) {
+        const auto& clusters = statistics.clusters()[sample];
 
-    for (auto& frame : data) {
-        for (auto& value : frame)
-            llps::utilities::serialise_to_binary(file, value);
+        for (size_t cluster = 0; cluster < clusters.size(); ++cluster)
+            file << statistics.times()[sample] << " " << cluster << " " << clusters[cluster].size << " " << clusters[cluster].x << " " << clusters[cluster].y << "\n";
     }
 
     file.close();
@@ -0,0 +1,57 @@
+#ifndef _MODELB_SPECTRAL_COMMON_HPP_INCLUDED
+#define _MODELB_SPECTRAL_COMMON_HPP_INCLUDED
+
+#include <cstddef>
+
+#include "llps/calculus/differentiate.hpp"
+#include "llps/grid.hpp"
+
+/*
+* Pseudo-spectral Model B right hand side,
+*   dphi/dt = lap(a*phi + b*phi^3 - k*lap(phi)),
+* evaluated entirely in Fourier space apart from the cubic term, which is
+* formed in real space and dealiased according to mode, truncation keeping
+* the modes below half the grid size (the 1/2 rule of cubic terms).
+*/
+template<class state_type>
+struct modelb_spectral
+{
+public:
+    using value_type = typename state_type::value_type;
+
+    modelb_spectral(double a, double b, double k, llps::calculus::dealiasing mode = llps::calculus::dealiasing::truncation) :
+        _a(a), _b(b), _k(k), _operator(dx, dy, mode, 3) {}
+
+public:
+    void operator()(const state_type& phi, state_type& dphi, double)
+    {
+        _operator.forward_nonlinear(phi, [b = _b](value_type phi) { return b * phi * phi * phi; });
+
+        value_type* phi_hat = reinterpret_cast<value_type*>(_operator.spectrum());
+        const value_type* cubic_hat = reinterpret_cast<const value_type*>(_operator.nonlinear_spectrum());
+
+        const value_type* laplacian = _operator.tables().laplacian().data();
+        const value_type* biharmonic = _operator.tables().biharmonic().data();
+
+        #pragma omp simd
+        for (ptrdiff_t i = 0; i < static_cast<ptrdiff_t>(operator_type::tables_type::size); ++i) {
+            for (ptrdiff_t part = 0; part < 2; ++part) {
+                const value_type phi_i = phi_hat[2 * i + part];
+                phi_hat[2 * i + part] = laplacian[i] * (_a * phi_i + cubic_hat[2 * i + part]) - _k * biharmonic[i] * phi_i;
+            }
+        }
+
+        _operator.backward(dphi);
+    }
+
+private:
+    using operator_type = llps::calculus::spectral_operator<value_type, state_type::rows(), state_type::cols()>;
+
+    static constexpr double dx = 1;
+    static constexpr double dy = 1;
+
+    double _a, _b, _k;
+    operator_type _operator;
+};
+
+#endif // !_MODELB_SPECTRAL_COMMON_HPP_INCLUDED
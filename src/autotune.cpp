@@ -0,0 +1,210 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <numbers>
+#include <limits>
+#include <algorithm>
+#include <utility>
+#include <cassert>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif // _OPENMP
+
+#include "_modelb_common.hpp"
+
+#include "llps/utilities/random.hpp"
+#include "llps/utilities/meta.hpp"
+#include "llps/tuning.hpp"
+#include "llps/grid_arena.hpp"
+#include "llps/grid.hpp"
+
+/*
+* Benchmarks the Model B right hand side of the drivers over every
+* finite difference order accurate enough, thread count and stencil
+* blocking (rows per block in 3D, rows and columns per tile in 2D), and
+* writes the fastest of each grid size to the tuning profile they load at
+* startup.
+*
+* Usage: llps_autotune [relative error] [points per wavelength] [profile]
+*   relative error        accuracy target of the laplacian, default 1e-3
+*   points per wavelength resolution of the finest feature, default that
+*                         of the fastest growing mode at a = -1, k = 1
+*   profile               default LLPS_OUTPUT_DIR/llps_tuning.txt
+*/
+
+//Model B parameters of the drivers, only setting the values benchmarked on
+static constexpr double a = -1.;
+static constexpr double b = -a;
+static constexpr double k = 1.;
+
+//Repeats of each configuration, of which the fastest counts
+static constexpr size_t repeats = 5;
+
+//Fewer threads are kept while within this of the fastest, leaving cores free for no loss
+static constexpr double thread_slack = 1.05;
+
+//The state, its derivative and the model's temporaries
+static constexpr size_t arena_slots = 4;
+
+//Seconds of the fastest of repeats evaluations, after one to set up pages
+template<class Model, class State>
+double time_rhs(Model& model, const State& phi)
+{
+    using clock = std::chrono::steady_clock;
+
+    State dphi;
+    model(phi, dphi, 0.);
+
+    double best = std::numeric_limits<double>::infinity();
+    for (size_t i = 0; i < repeats; ++i) {
+        const auto start = clock::now();
+        model(phi, dphi, 0.);
+
+        best = std::min(best, std::chrono::duration<double>(clock::now() - start).count());
+    }
+
+    return best;
+}
+
+std::vector<int> thread_candidates()
+{
+#ifdef _OPENMP
+    const int max_threads = omp_get_max_threads();
+
+    std::vector<int> threads;
+    for (int count = 1; count < max_threads; count *= 2)
+        threads.push_back(count);
+    threads.push_back(max_threads);
+
+    return threads;
+#else
+    return { 0 };
+#endif // _OPENMP
+}
+
+void set_threads(int threads)
+{
+#ifdef _OPENMP
+    if (threads > 0)
+        omp_set_num_threads(threads);
+#else
+    (void)threads;
+#endif // _OPENMP
+}
+
+template<size_t slices, size_t rows, size_t cols>
+llps::tuning_entry tune(double target, double points_per_wavelength)
+{
+    static constexpr bool is_3D = slices > 1;
+
+    //The drivers' state, in an arena as they run it, so that the timings include its placement and allocation
+    using state_type = std::conditional_t<is_3D, llps::pmr_grid3D<double, slices, rows, cols>, llps::pmr_grid<double, rows, cols>>;
+
+    state_type phi0;
+    llps::utilities::fill_normal(phi0, { 69 });
+
+    //Rows and columns per block, 0 first, so the kernel's own estimate wins ties. 2D tiles grow by 4 each way, keeping the
+    //candidates few enough to time at every order and thread count
+    std::vector<std::pair<size_t, size_t>> block_candidates{ { 0, 0 } };
+    if constexpr (is_3D) {
+        for (size_t block_rows = 1; block_rows <= rows; block_rows *= 2)
+            block_candidates.push_back({ block_rows, 0 });
+    }
+    else {
+        for (size_t block_rows = 8; block_rows <= rows; block_rows *= 4)
+            for (size_t block_cols = 32; block_cols <= cols; block_cols *= 4)
+                block_candidates.push_back({ block_rows, block_cols });
+    }
+
+    llps::tuning_entry best{ slices, rows, cols };
+    best.seconds_per_point = std::numeric_limits<double>::infinity();
+
+    llps::utilities::constexpr_for<llps::min_fd_order, llps::max_fd_order + 1, 2>([&]<size_t order>(llps::utilities::size_t_constant<order>) {
+        if (llps::fd_laplacian_error(order, points_per_wavelength) > target)
+            return;
+
+        for (auto [block_rows, block_cols] : block_candidates) {
+            double fastest = std::numeric_limits<double>::infinity();
+            int fastest_threads = 0;
+
+            for (int threads : thread_candidates()) {
+                set_threads(threads);
+
+                //Made after the thread count is set, so first touch places the pages as it would in a driver on as many threads
+                llps::grid_arena arena(sizeof(typename state_type::value_type) * state_type::size(), arena_slots);
+                llps::scoped_default_resource arena_scope(&arena);
+
+                const state_type phi(phi0);
+
+                double seconds;
+                if constexpr (is_3D) {
+                    modelb3D<order, state_type> model(a, b, k, block_rows);
+                    seconds = time_rhs(model, phi);
+                }
+                else {
+                    modelb<order, state_type> model(a, b, k, { block_rows, block_cols });
+                    seconds = time_rhs(model, phi);
+                }
+
+                assert(arena.overflows() == 0 && "arena_slots is too small for the model!");
+
+                if (seconds * thread_slack < fastest) {
+                    fastest = seconds;
+                    fastest_threads = threads;
+                }
+            }
+
+            const double seconds_per_point = fastest / state_type::size();
+            if (seconds_per_point < best.seconds_per_point) {
+                best.fd_order = order;
+                best.block_rows = block_rows;
+                best.block_cols = block_cols;
+                best.threads = fastest_threads;
+                best.seconds_per_point = seconds_per_point;
+            }
+        }
+    });
+
+    //Even the highest order misses the target, so fall back to it
+    if (!std::isfinite(best.seconds_per_point)) {
+        std::cout << "No order reaches " << target << " at " << points_per_wavelength << " points per wavelength\n";
+        best.fd_order = llps::max_fd_order;
+        best.seconds_per_point = 0.;
+    }
+
+    std::cout << std::setw(4) << slices << "x" << std::setw(4) << rows << "x" << std::setw(4) << cols
+              << ": order " << std::setw(2) << best.fd_order << ", block rows " << std::setw(3) << best.block_rows
+              << ", block cols " << std::setw(3) << best.block_cols
+              << ", threads " << std::setw(3) << best.threads << ", " << std::scientific << std::setprecision(3)
+              << best.seconds_per_point << " s/point" << std::defaultfloat << "\n";
+
+    return best;
+}
+
+int main(int argc, char** argv)
+{
+    const double target = argc > 1 ? std::stod(argv[1]) : 1e-3;
+    const double points_per_wavelength = argc > 2 ? std::stod(argv[2]) : 2. * std::numbers::pi * std::sqrt(-2. * k / a);
+    const std::string path = argc > 3 ? argv[3] : LLPS_OUTPUT_DIR"llps_tuning.txt";
+
+    std::cout << "Relative error of the laplacian at " << points_per_wavelength << " points per wavelength:\n";
+    for (size_t order = llps::min_fd_order; order <= llps::max_fd_order; order += 2)
+        std::cout << "  order " << std::setw(2) << order << ": " << llps::fd_laplacian_error(order, points_per_wavelength) << "\n";
+
+    //Keeps the entries of sizes not tuned here
+    llps::tuning_profile profile = llps::tuning_profile::load(path);
+
+    //The sizes of the drivers, and a size either side of them
+    profile.set(tune<1, 128, 128>(target, points_per_wavelength));
+    profile.set(tune<1, 256, 256>(target, points_per_wavelength));
+    profile.set(tune<1, 512, 512>(target, points_per_wavelength));
+    profile.set(tune<64, 64, 64>(target, points_per_wavelength));
+    profile.set(tune<128, 128, 128>(target, points_per_wavelength));
+
+    profile.save(path);
+    std::cout << "Profile written to " << path << "\n";
+}
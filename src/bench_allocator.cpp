@@ -0,0 +1,194 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <algorithm>
+
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif // __linux__
+
+#include "llps/calculus/differentiate.hpp"
+#include "llps/aligned_allocator.hpp"
+#include "llps/grid.hpp"
+
+/*
+* Compares 2048x2048 grids allocated with and without transparent huge pages:
+* throughput and data TLB misses of a stream triad, a column sweep (every
+* access on a different 4KiB page) and the sixth order finite difference
+* laplacian. Kernels run on the calling thread only, which is all the TLB
+* counter observes.
+*/
+
+static constexpr size_t rows = 2048;
+static constexpr size_t cols = 2048;
+
+template<bool HugePages>
+using grid_type = llps::grid<double, rows, cols, std::vector<double, llps::aligned_allocator<double, 64, HugePages>>>;
+
+#if defined(__linux__)
+
+//Data TLB read misses of the calling thread, through perf_event_open
+struct dtlb_counter
+{
+public:
+    dtlb_counter()
+    {
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+
+        _fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    ~dtlb_counter()
+    {
+        if (_fd >= 0)
+            close(_fd);
+    }
+
+public:
+    bool available() const noexcept { return _fd >= 0; }
+
+    void start()
+    {
+        if (available()) {
+            ioctl(_fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(_fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+
+    uint64_t stop()
+    {
+        uint64_t count = 0;
+        if (available()) {
+            ioctl(_fd, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(_fd, &count, sizeof(count)) != sizeof(count))
+                count = 0;
+        }
+
+        return count;
+    }
+
+private:
+    int _fd = -1;
+};
+
+#else
+
+struct dtlb_counter
+{
+    bool available() const noexcept { return false; }
+    void start() {}
+    uint64_t stop() { return 0; }
+};
+
+#endif // __linux__
+
+//Value of a "<key>: <value> kB" line of a /proc file, or -1 when unavailable
+long long read_proc_kb(const char* file_name, const std::string& key)
+{
+    std::ifstream file(file_name);
+
+    for (std::string line; std::getline(file, line);) {
+        if (line.rfind(key + ":", 0) == 0)
+            return std::stoll(line.substr(key.size() + 1));
+    }
+
+    return -1;
+}
+
+template<class Kernel>
+void measure(const char* name, size_t repeats, double bytes_per_repeat, dtlb_counter& counter, Kernel&& kernel)
+{
+    using clock = std::chrono::steady_clock;
+
+    //Warm up, which also faults every page in
+    kernel();
+
+    counter.start();
+    const auto start = clock::now();
+
+    for (size_t i = 0; i < repeats; ++i)
+        kernel();
+
+    const double seconds = std::chrono::duration<double>(clock::now() - start).count();
+    const uint64_t misses = counter.stop();
+
+    std::cout << "  " << std::left << std::setw(14) << name
+        << std::setw(14) << bytes_per_repeat * repeats / seconds * 1e-9;
+
+    if (counter.available())
+        std::cout << static_cast<double>(misses) / repeats;
+    else
+        std::cout << "n/a";
+
+    std::cout << "\n";
+}
+
+template<bool HugePages>
+void benchmark(dtlb_counter& counter)
+{
+    static constexpr size_t repeats = 20;
+    static constexpr double grid_bytes = sizeof(double) * rows * cols;
+
+    const long long huge_before = read_proc_kb("/proc/self/smaps_rollup", "AnonHugePages");
+
+    grid_type<HugePages> a, b, c;
+    std::ranges::fill(b, 1.);
+    std::ranges::fill(c, 2.);
+
+    const long long huge_after = read_proc_kb("/proc/self/smaps_rollup", "AnonHugePages");
+
+    std::cout << (HugePages ? "Huge pages" : "Base pages");
+    if (huge_before >= 0 && huge_after >= 0)
+        std::cout << " (AnonHugePages +" << (huge_after - huge_before) / 1024 << " MiB)";
+    std::cout << "\n  " << std::left << std::setw(14) << "kernel" << std::setw(14) << "GB/s" << "dTLB misses/pass\n";
+
+    measure("triad", repeats, 3 * grid_bytes, counter, [&] {
+        const double* b_data = b.data();
+        const double* c_data = c.data();
+        double* a_data = a.data();
+
+        for (size_t i = 0; i < rows * cols; ++i)
+            a_data[i] = b_data[i] + 0.5 * c_data[i];
+    });
+
+    measure("column sweep", repeats, grid_bytes, counter, [&] {
+        double* a_data = a.data();
+
+        for (size_t col = 0; col < cols; ++col)
+            for (size_t row = 0; row < rows; ++row)
+                a_data[row * cols + col] += 1.;
+    });
+
+    measure("laplacian", repeats, 2 * grid_bytes, counter, [&] {
+        llps::calculus::laplacian_central_fd<6>(b, a, 1., 1.);
+    });
+}
+
+int main()
+{
+    std::ifstream thp_mode("/sys/kernel/mm/transparent_hugepage/enabled");
+    std::string mode;
+    std::getline(thp_mode, mode);
+
+    std::cout << "Grid: " << rows << "x" << cols << " doubles, transparent huge pages: " << (mode.empty() ? "n/a" : mode) << "\n";
+
+    dtlb_counter counter;
+    if (!counter.available())
+        std::cout << "dTLB counter unavailable (needs Linux and perf_event_paranoid <= 2)\n";
+
+    benchmark<false>(counter);
+    benchmark<true>(counter);
+}
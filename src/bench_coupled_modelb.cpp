@@ -0,0 +1,95 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <array>
+#include <utility>
+#include <limits>
+#include <algorithm>
+
+#include "_modelb_common.hpp"
+#include "_coupled_modelb_common.hpp"
+
+#include "llps/utilities/random.hpp"
+#include "llps/grid.hpp"
+
+/*
+* Right hand side cost of coupled_modelb per species and grid point, for
+* N = 1 to 8 coupled species on 2048x2048 grids, against N independent modelb
+* right hand sides (two separate laplacian sweeps per species), best of the
+* repeats. Each species is coupled to the next, so N = 1 is uncoupled and
+* costs a little less; past that, the cost per species should not grow with
+* N. The coupled engine keeps mu in cache rather than writing and reading it
+* back, so it should undercut the separate sweeps even with the coupling
+* terms, which they do not have, once the grids no longer fit in cache.
+*/
+
+static constexpr size_t rows = 2048;
+static constexpr size_t cols = 2048;
+static constexpr size_t repeats = 10;
+
+using field_type = llps::grid<double, rows, cols>;
+
+template<class Callable>
+double ns_per_point(Callable&& callable, size_t species)
+{
+    //The first call only warms up
+    callable();
+
+    //Best rather than mean, as other processes only ever add to it
+    double seconds = std::numeric_limits<double>::max();
+    for (size_t repeat = 0; repeat < repeats; ++repeat) {
+        const auto start = std::chrono::steady_clock::now();
+        callable();
+
+        seconds = std::min(seconds, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    return seconds * 1e9 / (species * field_type::size());
+}
+
+template<size_t N>
+void benchmark()
+{
+    using model_type = coupled_modelb<6, field_type, N>;
+    using state_type = typename model_type::state_type;
+
+    typename model_type::vector_type a, b, k;
+    typename model_type::matrix_type xi{}, rates{};
+    for (size_t i = 0; i < N; ++i) {
+        a[i] = -1.;
+        b[i] = 1.;
+        k[i] = 1.;
+
+        //Each species coupled to the next, so the pointwise work per species does not grow with N either
+        if (N > 1) {
+            xi[i][(i + 1) % N] = 0.5;
+            rates[i][(i + 1) % N] = 1e-3;
+        }
+    }
+
+    state_type phi, dphi;
+    for (size_t i = 0; i < N; ++i)
+        llps::utilities::fill_normal(phi[i], { 69, i });
+
+    model_type coupled(a, b, k, xi, rates);
+    const double coupled_ns = ns_per_point([&] { coupled(phi, dphi, 0.); }, N);
+
+    modelb<6, field_type> separate(-1., 1., 1.);
+    const double separate_ns = ns_per_point([&] {
+        for (size_t i = 0; i < N; ++i)
+            separate(phi[i], dphi[i], 0.);
+    }, N);
+
+    std::cout << "N = " << N << std::fixed << std::setprecision(2)
+        << "  coupled: " << coupled_ns << " ns"
+        << "  separate: " << separate_ns << " ns (per species and point)\n";
+}
+
+int main()
+{
+    std::cout << "Grid: " << rows << "x" << cols << " doubles, order 6\n";
+
+    [] <size_t... N>(std::index_sequence<N...>) {
+        (benchmark<N + 1>(), ...);
+    }(std::make_index_sequence<8>{});
+}
@@ -0,0 +1,101 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+
+#include "boost/numeric/odeint.hpp"
+
+#include "_modelb_spectral_common.hpp"
+#include "llps/utilities/random.hpp"
+#include "llps/calculus/differentiate.hpp"
+#include "llps/grid.hpp"
+
+/*
+* Measures the cost of each dealiasing mode of the spectral Model B right hand
+* side: the time per evaluation, and the evaluations, accepted steps and wall
+* time an adaptive integration from the same initial condition takes.
+*/
+
+using state_type = llps::grid<double, 128, 128>;
+
+struct run_stats
+{
+    double seconds_per_rhs = 0.;
+    size_t rhs_calls = 0;
+    size_t steps = 0;
+    double seconds = 0.;
+};
+
+run_stats benchmark(llps::calculus::dealiasing mode, const state_type& phi0)
+{
+    using namespace boost::numeric;
+    using clock = std::chrono::steady_clock;
+
+    //Model B paramaters
+    constexpr double a = -1.;
+    constexpr double b = -a;
+    constexpr double k = 1.;
+
+    //Integration paramaters
+    constexpr double t_min = 0.;
+    constexpr double t_max = 100.;
+    constexpr double dt = 1e-2;
+
+    constexpr size_t rhs_repeats = 200;
+
+    run_stats stats;
+    modelb_spectral<state_type> model(a, b, k, mode);
+
+    {
+        state_type dphi;
+
+        const auto start = clock::now();
+        for (size_t i = 0; i < rhs_repeats; ++i)
+            model(phi0, dphi, 0.);
+
+        stats.seconds_per_rhs = std::chrono::duration<double>(clock::now() - start).count() / rhs_repeats;
+    }
+
+    using stepper_type = odeint::runge_kutta_cash_karp54<state_type, state_type::value_type>;
+    auto stepper = odeint::make_controlled<stepper_type>(1e-8, 1e-6);
+
+    auto counted_model = [&](const state_type& phi, state_type& dphi, double t) {
+        ++stats.rhs_calls;
+        model(phi, dphi, t);
+    };
+
+    state_type phi = phi0;
+
+    const auto start = clock::now();
+    stats.steps = odeint::integrate_adaptive(stepper, counted_model, phi, t_min, t_max, dt);
+    stats.seconds = std::chrono::duration<double>(clock::now() - start).count();
+
+    return stats;
+}
+
+int main()
+{
+    state_type phi0;
+    llps::utilities::fill_normal(phi0, { 69 });
+
+    static constexpr std::pair<llps::calculus::dealiasing, const char*> modes[] = {
+        { llps::calculus::dealiasing::none,       "none" },
+        { llps::calculus::dealiasing::truncation, "1/2 truncation" },
+        { llps::calculus::dealiasing::padding,    "zero padding" },
+    };
+
+    std::cout << std::left << std::setw(16) << "dealiasing"
+        << std::setw(16) << "us/rhs"
+        << std::setw(12) << "rhs calls"
+        << std::setw(12) << "steps"
+        << "total (s)\n";
+
+    for (auto [mode, name] : modes) {
+        const run_stats stats = benchmark(mode, phi0);
+
+        std::cout << std::left << std::setw(16) << name
+            << std::setw(16) << stats.seconds_per_rhs * 1e6
+            << std::setw(12) << stats.rhs_calls
+            << std::setw(12) << stats.steps
+            << stats.seconds << "\n";
+    }
+}
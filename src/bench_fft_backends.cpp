@@ -0,0 +1,92 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <string>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+#include "llps/fft/fft.hpp"
+#include "llps/aligned_allocator.hpp"
+
+/*
+* Times a forward and backward real transform pair of the FFT backend this
+* executable was built against (one is built per available backend, see the
+* bench_fft target), and checks that the pair round trips.
+*/
+
+using value_type = double;
+using vector_type = std::vector<value_type, llps::aligned_allocator<value_type>>;
+
+void benchmark(const std::vector<size_t>& dims)
+{
+    using clock = std::chrono::steady_clock;
+    using complex_type = llps::fft::complex<value_type>;
+
+    size_t size = 1;
+    for (size_t n : dims)
+        size *= n;
+    const size_t spectrum_size = size / dims.back() * (dims.back() / 2 + 1);
+
+    vector_type phi(size), result(size);
+
+    std::default_random_engine rnd_eng{ 69 };
+    std::normal_distribution normal_dist{ 0., 1. };
+    std::ranges::generate(phi, std::bind(normal_dist, rnd_eng));
+
+    complex_type* spectrum = llps::fft::allocate<complex_type>(spectrum_size);
+
+    const auto plan_start = clock::now();
+    const llps::fft::real_plan<value_type> plan(dims);
+    const double plan_seconds = std::chrono::duration<double>(clock::now() - plan_start).count();
+
+    //Warm up, and measures the round trip error
+    plan.forward(phi.data(), spectrum);
+    plan.backward(spectrum, result.data());
+
+    value_type max_err = 0;
+    for (size_t i = 0; i < size; ++i)
+        max_err = std::max(max_err, std::abs(result[i] / size - phi[i]));
+
+    //Enough repeats for roughly a second of work on the slower backends
+    const size_t repeats = std::max<size_t>(5, (1 << 24) / size);
+
+    const auto start = clock::now();
+    for (size_t i = 0; i < repeats; ++i) {
+        plan.forward(phi.data(), spectrum);
+        plan.backward(spectrum, result.data());
+    }
+    const double seconds = std::chrono::duration<double>(clock::now() - start).count() / repeats;
+
+    llps::fft::deallocate(spectrum);
+
+    std::string shape;
+    for (size_t n : dims)
+        shape += (shape.empty() ? "" : "x") + std::to_string(n);
+
+    std::cout << std::left << std::setw(10) << llps::fft::backend_name()
+        << std::setw(16) << shape
+        << std::setw(16) << plan_seconds * 1e3
+        << std::setw(20) << seconds * 1e3
+        << max_err << "\n";
+}
+
+int main()
+{
+    std::cout << std::left << std::setw(10) << "backend"
+        << std::setw(16) << "shape"
+        << std::setw(16) << "plan (ms)"
+        << std::setw(20) << "forw+back (ms)"
+        << "round trip error\n";
+
+    //Powers of two, as used by the drivers, and a few which are not
+    for (const std::vector<size_t>& dims : std::vector<std::vector<size_t>>{
+        { 128, 128 }, { 256, 256 }, { 512, 512 }, { 1024, 1024 },
+        { 384, 384 }, { 250, 250 }, { 243, 243 },
+        { 64, 64, 64 }, { 128, 128, 128 } })
+    {
+        benchmark(dims);
+    }
+}
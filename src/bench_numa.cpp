@@ -0,0 +1,112 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <map>
+#include <string>
+#include <chrono>
+#include <algorithm>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif // _OPENMP
+
+#include "llps/execution.hpp"
+#include "llps/aligned_allocator.hpp"
+#include "llps/grid.hpp"
+
+/*
+* Memory bandwidth seen by the threads of each socket running a stream triad
+* over 2048x4096 grids, once with the grids initialised on the main thread
+* (every page on its socket) and once first touched by the workers. Threads
+* are pinned with LLPS_THREAD_BINDING, or spread over the sockets if unset.
+*
+* Each thread times its own static block of rows, so a socket's figure is the
+* sum over its threads of the bytes they moved over the time they took.
+*/
+
+static constexpr size_t rows = 2048;
+static constexpr size_t cols = 4096;
+static constexpr size_t repeats = 20;
+
+template<bool FirstTouch>
+using grid_type = llps::grid<double, rows, cols, std::vector<double, llps::aligned_allocator<double, 64, llps::_huge_pages_default, FirstTouch>>>;
+
+template<bool FirstTouch>
+void benchmark(const std::vector<int>& placement, const std::map<int, int>& socket_of)
+{
+    grid_type<FirstTouch> a, b, c;
+
+    //As the drivers generate their initial conditions, from the main thread
+    std::ranges::fill(b, 1.);
+    std::ranges::fill(c, 2.);
+
+    std::vector<double> seconds(placement.size(), 0.);
+    std::vector<double> bytes(placement.size(), 0.);
+
+    const double* b_data = b.data();
+    const double* c_data = c.data();
+    double* a_data = a.data();
+
+    for (size_t repeat = 0; repeat <= repeats; ++repeat) {
+        #pragma omp parallel
+        {
+#ifdef _OPENMP
+            const size_t thread = static_cast<size_t>(omp_get_thread_num());
+#else
+            const size_t thread = 0;
+#endif // _OPENMP
+
+            const auto start = std::chrono::steady_clock::now();
+            size_t points = 0;
+
+            #pragma omp for schedule(static) nowait
+            for (ptrdiff_t row = 0; row < static_cast<ptrdiff_t>(rows); ++row) {
+                for (size_t col = 0; col < cols; ++col) {
+                    const size_t i = row * cols + col;
+                    a_data[i] = b_data[i] + 0.5 * c_data[i];
+                }
+                points += cols;
+            }
+
+            //The first pass only warms up
+            if (repeat > 0) {
+                seconds[thread] += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                bytes[thread] += 3. * sizeof(double) * points;
+            }
+        }
+    }
+
+    std::map<int, double> bandwidth;
+    for (size_t thread = 0; thread < placement.size(); ++thread) {
+        const auto socket = socket_of.find(placement[thread]);
+        bandwidth[socket != socket_of.end() ? socket->second : -1] += seconds[thread] > 0 ? bytes[thread] / seconds[thread] : 0.;
+    }
+
+    std::cout << (FirstTouch ? "Worker first touch\n" : "Main thread first touch\n");
+    for (const auto& [socket, value] : bandwidth)
+        std::cout << "  socket " << std::setw(4) << std::left << (socket < 0 ? std::string("?") : std::to_string(socket))
+            << std::fixed << std::setprecision(2) << value * 1e-9 << " GB/s\n";
+}
+
+int main()
+{
+    llps::execution_config config = llps::execution_config::from_environment();
+    if (config.binding == llps::thread_binding::none)
+        config.binding = llps::thread_binding::spread;
+
+    const std::vector<int> placement = llps::bind_threads(config);
+
+    std::map<int, int> socket_of;
+    for (const llps::cpu_info& info : llps::available_cpus())
+        socket_of[info.cpu] = info.socket;
+
+    std::cout << "Grid: " << rows << "x" << cols << " doubles, " << placement.size() << " threads, binding: " << llps::to_string(config.binding) << "\n";
+    for (size_t thread = 0; thread < placement.size(); ++thread) {
+        const auto socket = socket_of.find(placement[thread]);
+        std::cout << "  thread " << thread << " -> cpu " << placement[thread]
+            << " (socket " << (socket != socket_of.end() ? std::to_string(socket->second) : std::string("?")) << ")\n";
+    }
+
+    benchmark<false>(placement, socket_of);
+    benchmark<true>(placement, socket_of);
+}
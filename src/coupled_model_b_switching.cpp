@@ -1,16 +1,19 @@
 #include <iostream>
 #include <fstream>
-#include <random>
 #include <iomanip>
+#include <span>
 
 #include "boost/numeric/odeint.hpp"
 
 #include "_modelb_common.hpp"
 
-#include "utilities/io.hpp"
-#include "utilities/timer.hpp"
-#include "calculus/differentiate.hpp"
-#include "grid.hpp"
+#include "llps/utilities/io.hpp"
+#include "llps/utilities/random.hpp"
+#include "llps/utilities/steady_state.hpp"
+#include "llps/utilities/timer.hpp"
+#include "llps/calculus/differentiate.hpp"
+#include "llps/integrate.hpp"
+#include "llps/grid.hpp"
 
 
 template<size_t rows, size_t cols>
@@ -105,12 +108,9 @@ int main()
     using stepper_type = odeint::runge_kutta_cash_karp54<state_type, state_type::value_type>;
     auto stepper = odeint::make_controlled<stepper_type>(1e-10, 1e-6);
 
-    std::default_random_engine rnd_eng{ 69 };
-    std::normal_distribution normal_dist{ 0., 1. };
-
     state_type phi0;
 
-    std::ranges::generate(phi0, std::bind(normal_dist, rnd_eng));
+    llps::utilities::fill_normal(phi0, { 69 });
 
     double sum = 0;
     for (auto& val : phi0)
@@ -131,29 +131,39 @@ int main()
     constexpr size_t samples = 2500;
     constexpr double sample_int = (t_max - t_min)/samples;
 
+    //Stationary once the RMS of dphi/dt stays below 1e-6 for 5 samples, and no longer if it passes 1e-5. Either the run
+    //stops there or, to follow a pattern which might still unlock, carries on sampling 10 times less often
+    constexpr bool stop_when_stationary = true;
+    constexpr double sparse_sample_int = 10. * sample_int;
+
+    llps::utilities::steady_state_detector<double> detector(1e-6, 1e-5, 5, sample_int);
+
+    //Streamed with the time of each sample, as the interval between samples grows once stationary
+    static constexpr size_t field_size = state_type::size() / 2;
     using field_type = llps::grid<state_type::value_type, state_type::rows() / 2, state_type::cols()>;
-    std::vector<field_type> field1;
-    std::vector<field_type> field2;
-    field1.reserve(samples);
-    field2.reserve(samples);
+
+    auto video1 = open_video<field_type>(LLPS_OUTPUT_DIR"modelb_coupled_switching_1(a=-b=-k=-1,varphi=1,xi1=2,xi2=1,k10=0.5,k01=0.2)+.dat", "$\\phi_1$");
+    auto video2 = open_video<field_type>(LLPS_OUTPUT_DIR"modelb_coupled_switching_2(a=-b=-k=-1,varphi=1,xi1=2,xi2=1,k10=0.5,k01=0.2)+.dat", "$\\phi_2$");
 
     auto model = modelb_coupled<6>(a, b, k);
 
     { llps::timer timer;
 
     double last_t = t_min;
-    odeint::integrate_adaptive(stepper, std::ref(model), phi0, t_min, t_max, dt, [&](const state_type& phi, double t) {
-        if (t - last_t >= sample_int) {
+    llps::integrate_adaptive_until(stepper, std::ref(model), phi0, t_min, t_max, dt, [&](const state_type& phi, double t) {
+        detector(phi, t);
+
+        if (t - last_t >= (detector.stationary() ? sparse_sample_int : sample_int)) {
             std::cout << "Progress: " << std::setprecision(2) << t << "/" << std::fixed << t_max << "\r";
 
-            field1.push_back(phi.field(0));
-            field2.push_back(phi.field(1));
-            last_t += sample_int;
+            video1.write(std::span<const double>(phi.data(), field_size), t);
+            video2.write(std::span<const double>(phi.data() + field_size, field_size), t);
+            last_t = t;
         }
-        });
+        },
+        [&](const state_type&, double) { return stop_when_stationary && detector.stationary(); });
     }
 
-    save_to_file(LLPS_OUTPUT_DIR"modelb_coupled_switching_1(a=-b=-k=-1,varphi=1,xi1=2,xi2=1,k10=0.5,k01=0.2)+.dat", field1, "$\\phi_1$");
-    save_to_file(LLPS_OUTPUT_DIR"modelb_coupled_switching_2(a=-b=-k=-1,varphi=1,xi1=2,xi2=1,k10=0.5,k01=0.2)+.dat", field2, "$\\phi_2$");
-
+    if (detector.stationary())
+        std::cout << "\nStationary from t=" << detector.stationary_since() << "\n";
 }
\ No newline at end of file
@@ -2,97 +2,40 @@
 
 #include <iostream>
 #include <array>
-#include <random>
 #include <algorithm>
 #include <ranges>
 #include <fstream>
 
 #include "boost/numeric/odeint.hpp"
-//#include "_modelb_common.hpp"
+#include "_coupled_modelb_common.hpp"
 #include "multi_range_algebra.hpp"
+#include "llps/utilities/random.hpp"
 #include "llps/utilities/timer.hpp"
 #include "llps/utilities/io.hpp"
+#include "llps/utilities/sampling.hpp"
 #include "llps/calculus/differentiate.hpp"
 
 using time_type = double;
 
-
-template<size_t order, typename _field_type>
-struct modelb_coupled_diffusion
-{
-private:
-    using _state_type = std::array<_field_type, 2>;
-    using _value_type = typename _field_type::value_type;
-
-public:
-    modelb_coupled_diffusion(_value_type a, _value_type b, _value_type k, _value_type k01, _value_type k10, _value_type d):
-        _a(a), _b(b), _k(k), _k01(k01), _k10(k10), _d(d) {}
-
-public:
-    LLPS_FORCE_INLINE void operator()(const _state_type& phi, _state_type& dphi, time_type)
-    {
-        static constexpr _value_type dx = 1.;
-        static constexpr _value_type dy = 1.;
-
-        const auto& field_1 = phi[0];
-        auto& dfield_1 = dphi[0];
-
-        llps::calculus::laplacian_central_fd<order>(field_1, dfield_1, dx, dy);
-
-        auto field_1_it = field_1.begin();
-        for (auto& dfield_1_val : dfield_1) {
-            const _value_type field_1_val = *field_1_it;
-            ++field_1_it;
-
-            dfield_1_val = field_1_val * (_a + _b * field_1_val * field_1_val) - _k * dfield_1_val; //+ _xi[i] * (*field_j_it);
-        }
-
-        dfield_1 = llps::calculus::laplacian_central_fd<order>(dfield_1, dx, dy);
-
-        //Diffusion
-        llps::calculus::laplacian_central_fd<order>(phi[1], dphi[1], dx, dy);
-
-             field_1_it = field_1.begin();
-        auto field_2_it = phi[1].begin();
-
-        auto dfield_1_it = dfield_1.begin();
-        auto dfield_2_it = dphi[1].begin();
-
-        for (; field_1_it != field_1.end(); ++field_1_it, ++field_2_it, ++dfield_1_it, ++dfield_2_it)
-        {
-            //Multiply diffusion coeff here cause why not. 
-            *dfield_2_it *= _d;
-
-            const _value_type switching = _k01 * (*field_2_it) -_k10 * (*field_1_it);
-            *dfield_1_it += switching;
-            *dfield_2_it -= switching;
-        }
-    }
-
-private:
-    _value_type _a, _b, _k, _k01, _k10, _d;
-};
-
 int main()
 {
     using namespace boost::numeric;
 
     using field_type = llps::grid<double, 256, 256>;
-    using state_type = std::array<field_type, 2>;
+    using model_type = coupled_modelb<6, field_type, 2>;
+    using state_type = model_type::state_type;
     using value_type = field_type::value_type;
 
     using stepper_type = odeint::runge_kutta_cash_karp54<state_type, value_type, state_type, time_type, array_of_ranges_algebra>;
     auto stepper = odeint::make_controlled<stepper_type>(1e-10, 1e-6);
 
-    std::default_random_engine rnd_eng{ 69 };
-    std::normal_distribution normal_dist{ -0.3, 1. };
-
     state_type phi0;
     value_type intphi0 = 0;
-    for (auto& field : phi0) {
-        std::ranges::generate(field, std::bind(normal_dist, rnd_eng));
+    for (size_t species = 0; species < phi0.size(); ++species) {
+        auto& field = phi0[species];
+        llps::utilities::fill_normal(field, { 69, species }, -0.3);
 
-        intphi0 = std::accumulate(field.begin(), field.end(), intphi0);
+        intphi0 += llps::utilities::summarise(field).sum;
     }
     //Ensure the fields are different
     assert(!std::ranges::equal(phi0[0], phi0[1]));
@@ -112,12 +55,14 @@ int main()
     constexpr time_type t_max = 1000;
     constexpr time_type dt = 1.;
 
-    //Sampling  parameters
+    //Sampling  parameters, a frame whenever the fields have moved by 2% since the last, at most every 0.1 and at least every 10
     constexpr size_t samples = 1001;
-    constexpr time_type sample_int = (t_max - t_min) / (samples - 1);
+    llps::utilities::change_sampler<value_type> sampler(0.02, 0.1, 10.);
 
     std::vector<time_type> times;
     std::vector<field_type> fields[2];
+    //Range of every frame, kept up as frames are sampled rather than found afterwards
+    llps::utilities::field_summary<value_type> range;
 
     //Initialise outputs
     times.reserve(samples);
@@ -126,34 +71,28 @@ int main()
         field.reserve(samples);
 
     //Integration:
-    auto model = modelb_coupled_diffusion<6, field_type>(a, b, k, k01, k10, d);
+    //The second species only diffuses, with mu = d phi_2. k10 turns species 1 into 2, k01 turns it back
+    auto model = model_type({ a, d }, { b, 0. }, { k, 0. }, {}, {{ { 0., k10 }, { k01, 0. } }});
     {
         llps::timer timer;
 
-        time_type last_t = 0;
-        odeint::integrate_adaptive(stepper, model, phi0, t_min, t_max, dt, [&](const state_type& phi, time_type t)
+        odeint::integrate_adaptive(stepper, std::ref(model), phi0, t_min, t_max, dt, [&](const state_type& phi, time_type t)
             {
-                if (t - last_t >= sample_int) {
+                if (sampler(phi, t)) {
                     std::cout << "Progress: " << std::setprecision(2) << t << "/" << std::fixed << t_max << "\r";
 
-                    for (size_t i = 0; i < std::ranges::size(fields); ++i)
+                    for (size_t i = 0; i < std::ranges::size(fields); ++i) {
                         fields[i].push_back(phi[i]);
+                        range += llps::utilities::summarise(phi[i]);
+                    }
 
                     times.push_back(t);
-                    last_t += sample_int;
                 }
             });
     }
 
-    value_type vmin = std::numeric_limits<value_type>::max();
-    value_type vmax = std::numeric_limits<value_type>::min();
-    for (const auto& field : fields) {
-        for (const auto& frame : field) {
-            auto [frame_min, frame_max] = std::ranges::minmax(frame);
-            vmin = std::min(vmin, frame_min);
-            vmax = std::max(vmax, frame_max);
-        }
-    }
+    const value_type vmin = range.min;
+    const value_type vmax = range.max;
 
     std::string data_suffix = std::format(
         "phi0={:.2f},a={:.2f},b={:.2f},k={:.2f},k01={:.2E},k10={:.2E},D={:.2f},t={}", intphi0, a, b, k, k01, k10, d, t_max);
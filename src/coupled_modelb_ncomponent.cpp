@@ -0,0 +1,98 @@
+#include <iostream>
+#include <array>
+#include <iomanip>
+#include <string>
+#include <utility>
+
+#include "boost/numeric/odeint.hpp"
+
+#include "_modelb_common.hpp"
+#include "_coupled_modelb_common.hpp"
+#include "multi_range_algebra.hpp"
+
+#include "llps/grid.hpp"
+#include "llps/utilities/random.hpp"
+#include "llps/utilities/timer.hpp"
+
+using time_type = double;
+
+int main()
+{
+    using namespace boost::numeric;
+
+    static constexpr size_t species = 3;
+
+    using field_type = llps::grid<double, 256, 256>;
+    using model_type = coupled_modelb<6, field_type, species>;
+    using state_type = model_type::state_type;
+    using value_type = field_type::value_type;
+
+    using stepper_type = odeint::runge_kutta_cash_karp54<state_type, value_type, state_type, time_type, array_of_ranges_algebra>;
+    auto stepper = odeint::make_controlled<stepper_type>(1e-10, 1e-6);
+
+    state_type phi0;
+    value_type intphi0 = 0;
+    for (size_t i = 0; i < phi0.size(); ++i) {
+        auto& field = phi0[i];
+        llps::utilities::fill_normal(field, { 69, i });
+
+        intphi0 += llps::utilities::summarise(field).sum;
+    }
+
+    //Model B paramaters (per species). The last species is purely diffusive (D = a).
+    constexpr model_type::vector_type a = { -1., -1., 1. };
+    constexpr model_type::vector_type b = {  1.,  1., 0. };
+    constexpr model_type::vector_type k = {  1.,  1., 0. };
+
+    //Coupling matrix, xi[i][j] couples species j into the chemical potential of species i
+    constexpr model_type::matrix_type xi = {{
+        {  0.,  2., 0. },
+        { -1.,  0., 0. },
+        {  0.,  0., 0. }
+    }};
+
+    //Switching rates, rates[i][j] is the rate at which species i turns into species j
+    constexpr model_type::matrix_type rates = {{
+        { 0.,    0.,   1e-3 },
+        { 0.,    0.,   0.   },
+        { 1e-3,  0.,   0.   }
+    }};
+
+    //Integration paramaters
+    constexpr time_type t_min = 0.;
+    constexpr time_type t_max = 1000.;
+    constexpr time_type dt = 1.;
+
+    //Sampling  parameters
+    constexpr size_t samples = 1001;
+    constexpr time_type sample_int = (t_max - t_min) / (samples - 1);
+
+    //One video per species, streamed with the time of each sample
+    const std::string run_name = "coupled_modelB_ncomponent(N=" + std::to_string(species) + ",t=" + std::to_string(t_max) + ")";
+    const std::string title = "Coupled ModelB with " + std::to_string(species) + " species, $\\phi_0$=" + std::to_string(intphi0);
+
+    auto videos = [&]<size_t... I>(std::index_sequence<I...>) {
+        return std::array{ open_video<field_type>(
+            (LLPS_OUTPUT_DIR"simulations/coupled model B/" + run_name + "_" + std::to_string(I + 1) + ".dat").c_str(),
+            title + ", $\\phi_" + std::to_string(I + 1) + "$")... };
+    }(std::make_index_sequence<species>{});
+
+    //Integration:
+    auto model = model_type(a, b, k, xi, rates);
+    {
+        llps::timer timer;
+
+        time_type last_t = -sample_int;
+        odeint::integrate_adaptive(stepper, std::ref(model), phi0, t_min, t_max, dt, [&](const state_type& phi, time_type t)
+        {
+            if (t - last_t >= sample_int) {
+                std::cout << "Progress: " << std::setprecision(2) << t << "/" << std::fixed << t_max << "\r";
+
+                for (size_t i = 0; i < species; ++i)
+                    videos[i].write(phi[i], t);
+
+                last_t += sample_int;
+            }
+        });
+    }
+}
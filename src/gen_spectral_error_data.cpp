@@ -32,7 +32,7 @@ struct test_func
 
 int main()
 {   
-    using fftw_vector_t = std::vector<value_type, llps::fftw_allocator<value_type>>;
+    using aligned_vector_t = std::vector<value_type, llps::aligned_allocator<value_type>>;
 
     //For pretty plots
     static constexpr const char* colours[] = { "#f0f921", "#fdb42f", "#ed7953", "#cc4778", "#9c179e", "#5c01a6", "#0d0887" };
@@ -64,7 +64,7 @@ int main()
         static constexpr size_t rows = 1 << (I + 2);
         static constexpr value_type dx = (x_max - x_min) / rows;
 
-        using grid_t = llps::grid<value_type, rows, rows, fftw_vector_t>;
+        using grid_t = llps::grid<value_type, rows, rows, aligned_vector_t>;
 
         grid_t phi, expected;
         llps::apply_equi2D(expected, x_min, x_max, test_func::dphi);
@@ -9,6 +9,7 @@
 
 #include "llps/grid.hpp"
 #include "llps/calculus/differentiate.hpp"
+#include "llps/calculus/stencil.hpp"
 #include "llps/utilities/data_analytics.hpp"
 #include "llps/utilities/meta.hpp"
 #include "llps/utilities/io.hpp"
@@ -34,8 +35,8 @@ struct test_func
 
 int main()
 {
-    //For pretty plots
-    static constexpr const char* colours[] = {"#f0f921", "#fdb42f", "#ed7953", "#cc4778", "#9c179e", "#5c01a6", "#0d0887"};
+    //For pretty plots, the compact laplacians in green
+    static constexpr const char* colours[] = {"#f0f921", "#fdb42f", "#ed7953", "#cc4778", "#9c179e", "#5c01a6", "#0d0887", "#5ec962", "#21918c"};
 
     static constexpr value_type x_min = 0;
     static constexpr value_type x_max = 2.*std::numbers::pi;
@@ -49,12 +50,15 @@ int main()
     plot_header.x_scale = "log";
     plot_header.y_scale = "log";
 
-    static constexpr size_t lines_count = 7;
+    //The central differences of orders 2 to 14, then the isotropic 9 point and Mehrstellen laplacians
+    static constexpr size_t central_count = 7;
+    static constexpr size_t lines_count = central_count + 2;
     llps::utilities::serialise_plot_header(file, lines_count, plot_header);
 
     llps::utilities::constexpr_for<lines_count>([&]<size_t I>(llps::utilities::size_t_constant<I>)
     {
-        static constexpr size_t order = 2 * (I+1);
+        static constexpr bool is_central = I < central_count;
+        static constexpr size_t order = is_central ? 2 * (I+1) : 2 * (I-central_count+1);
         static constexpr size_t samples = 30;
 
         std::vector<value_type> delta_xs;
@@ -73,7 +77,13 @@ int main()
             llps::apply_equi2D(phi, x_min, x_max, test_func::phi);
             llps::apply_equi2D(expected, x_min, x_max, test_func::dphi);
 
-            grid_t actual = llps::calculus::laplacian_central_fd<order>(phi, dx, dx);
+            grid_t actual;
+            if constexpr (is_central)
+                actual = llps::calculus::laplacian_central_fd<order>(phi, dx, dx);
+            else if constexpr (order == 2)
+                actual = llps::calculus::laplacian_isotropic(phi, dx, dx);
+            else
+                actual = llps::calculus::laplacian_mehrstellen(phi, dx, dx);
             //Using max absolute error to measure error
             value_type max_abs_err = llps::utilities::max_abs_error(expected, actual);
 
@@ -100,6 +110,8 @@ int main()
         llps::utilities::line_header line_header;
         line_header.colour = colours[I];
         line_header.label  = "O($\\Delta x^{"s + std::to_string(order) + "}$)"s;
+        if constexpr (!is_central)
+            line_header.label = (order == 2 ? "9 point "s : "Mehrstellen "s) + line_header.label;
 
         llps::utilities::serialise_line_header<value_type, value_type>(file, samples, line_header);
 
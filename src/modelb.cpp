@@ -1,31 +1,52 @@
 #include <iostream>
 #include <fstream>
-#include <random>
 #include <iomanip>
+#include <functional>
+#include <cassert>
 
 #include "boost/numeric/odeint.hpp"
 
 #include "_modelb_common.hpp"
 
 #include "llps/utilities/io.hpp"
+#include "llps/utilities/monitor.hpp"
+#include "llps/utilities/sampling.hpp"
+#include "llps/utilities/random.hpp"
 #include "llps/utilities/timer.hpp"
 #include "llps/calculus/differentiate.hpp"
+#include "llps/execution.hpp"
+#include "llps/tuning.hpp"
+#include "llps/grid_arena.hpp"
 #include "llps/grid.hpp"
 
-using state_type = llps::grid<double, 256, 256>;
+using state_type = llps::pmr_grid<double, 256, 256>;
+
+using monitor_type = llps::utilities::conservation_monitor<double, state_type::rows(), state_type::cols()>;
+
+//Two copies of the stepper's temporaries (integrate_adaptive takes it by value), the state and the model's temporaries
+static constexpr size_t arena_slots = 32;
 
 int main()
 {
     using namespace boost::numeric;
 
+    //Order and threads measured best on this host by llps_autotune, LLPS_THREADS still taking precedence
+    const llps::tuning_entry tuning = llps::tuning_profile::from_environment(LLPS_OUTPUT_DIR"llps_tuning.txt").find(state_type::rows(), state_type::cols());
+
+    //Pinned before anything is allocated, so first touch happens on the threads' final cores
+    llps::execution_config config = llps::execution_config::from_environment();
+    tuning.apply(config);
+    std::cout << "Threads: " << llps::bind_threads(config).size() << ", binding: " << llps::to_string(config.binding) << ", order: " << tuning.fd_order << ", tile: " << tuning.block_rows << "x" << tuning.block_cols << "\n";
+
+    //Working storage of the stepper, the model and their temporaries, reserved and placed up front
+    llps::grid_arena arena(sizeof(state_type::value_type) * state_type::size(), arena_slots);
+    llps::scoped_default_resource arena_scope(&arena);
+
     using stepper_type = odeint::runge_kutta_cash_karp54<state_type, state_type::value_type>;
     auto stepper = odeint::make_controlled<stepper_type>(1e-10, 1e-6);
 
-    std::default_random_engine rnd_eng{ 69 };
-    std::normal_distribution normal_dist{ 0., 1. };
-
     state_type phi0;
-    std::ranges::generate(phi0, std::bind(normal_dist, rnd_eng));
+    llps::utilities::fill_normal(phi0, { 69 });
 
     //Model B paramaters
     constexpr double a = -1.;
@@ -37,26 +58,40 @@ int main()
     constexpr double t_max = 1000.;
     constexpr double dt = 1.;
 
-    //Sampling 
-    constexpr double sample_int = 1.;
-    constexpr size_t samples = static_cast<size_t>((t_max - t_min)/sample_int) + 1;
+    //Sampling, uniform in log(t) so that the spinodal decomposition gets as many frames per decade as the coarsening after it
+    constexpr size_t frames = 200;
+    llps::utilities::log_time_sampler sampler(0.1, t_max, frames);
+
+    //Monitoring
+    constexpr double monitor_int = 1.;
+
+    auto video = open_video<state_type>(LLPS_OUTPUT_DIR"modelb(a=-b=-k=-1).dat", "Modelb simulation using finite difference,\nup to t=" + std::to_string(t_max));
+
+    llps::dispatch_fd_order(tuning.fd_order, [&]<size_t order>(llps::utilities::size_t_constant<order>) {
+        //Marks the run if mass drifts or the free energy rises, leaving it to finish so the frames show what went wrong
+        monitor_type monitor(b, 1e-10, 1e-6, llps::utilities::monitor_policy::flag, 1., 1., monitor_int);
+
+        modelb<order, state_type> model(a, b, k, { tuning.block_rows, tuning.block_cols });
+        { llps::timer timer;
+
+            odeint::integrate_adaptive(stepper, std::ref(model), phi0, t_min, t_max, dt, [&](const state_type& phi, double t) {
+                monitor(phi, t, model);
 
-    std::vector<state_type> result;
-    result.reserve(samples);
+                if (sampler(t)) {
+                    std::cout << "Progress: " << std::setprecision(2) << t << "/" << std::fixed << t_max << "\r";
 
-    modelb<6, state_type> model(a, b, k);
-    { llps::timer timer;
+                    video.write(phi, t);
+                }
+            });
+        }
 
-        double last_t = t_min;
-        odeint::integrate_adaptive(stepper, model, phi0, t_min, t_max, dt, [&](const state_type& phi, double t) {
-            if (t - last_t >= sample_int) {
-                std::cout << "Progress: " << std::setprecision(2) << t << "/" << std::fixed << t_max << "\r";
+        if (monitor.flagged())
+            std::cout << "\nFlagged: " << monitor.violations().size() << " samples failed, the first at t=" << monitor.violations().front() << "\n";
 
-                result.push_back(phi);
-                last_t += sample_int;
-            }
-        });
-    }
+        std::cout << "Arena: peak " << arena.peak_slots_in_use() << "/" << arena.slots() << " slots, " << arena.overflows() << " overflows\n";
+        assert(arena.overflows() == 0 && "arena_slots is too small for the stepper and model!");
+        std::cout << "Mass drift: " << std::scientific << monitor.mass_drift() << ", range: [" << video.summary().min << ", " << video.summary().max << "]\n";
 
-    save_to_file(LLPS_OUTPUT_DIR"modelb(a=-b=-k=-1).dat", result, "Modelb simulation using finite difference,\nup to t=" + std::to_string(t_max));
+        save_time_series(LLPS_OUTPUT_DIR"modelb(a=-b=-k=-1) F(t).dat", monitor.times(), monitor.energies(), "Free energy of Modelb simulation using finite difference", "F");
+    });
 }
\ No newline at end of file
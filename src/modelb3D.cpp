@@ -0,0 +1,85 @@
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <span>
+#include <cassert>
+
+#include "boost/numeric/odeint.hpp"
+
+#include "_modelb_common.hpp"
+
+#include "llps/utilities/io.hpp"
+#include "llps/utilities/random.hpp"
+#include "llps/utilities/timer.hpp"
+#include "llps/calculus/differentiate.hpp"
+#include "llps/execution.hpp"
+#include "llps/tuning.hpp"
+#include "llps/grid_arena.hpp"
+#include "llps/grid.hpp"
+
+using state_type = llps::pmr_grid3D<double, 128, 128, 128>;
+using frame_type = llps::grid<double, state_type::rows(), state_type::cols()>;
+
+//Two copies of the stepper's temporaries (integrate_adaptive takes it by value), the state and the model's temporaries
+static constexpr size_t arena_slots = 32;
+
+int main()
+{
+    using namespace boost::numeric;
+
+    //Order, threads and stencil blocking measured best on this host by llps_autotune, LLPS_THREADS still taking precedence
+    const llps::tuning_entry tuning = llps::tuning_profile::from_environment(LLPS_OUTPUT_DIR"llps_tuning.txt").find(state_type::slices(), state_type::rows(), state_type::cols());
+
+    //Pinned before anything is allocated, so first touch happens on the threads' final cores
+    llps::execution_config config = llps::execution_config::from_environment();
+    tuning.apply(config);
+    std::cout << "Threads: " << llps::bind_threads(config).size() << ", binding: " << llps::to_string(config.binding) << ", order: " << tuning.fd_order << ", block rows: " << tuning.block_rows << "\n";
+
+    //Working storage of the stepper, the model and their temporaries, reserved and placed up front
+    llps::grid_arena arena(sizeof(state_type::value_type) * state_type::size(), arena_slots);
+    llps::scoped_default_resource arena_scope(&arena);
+
+    using stepper_type = odeint::runge_kutta_cash_karp54<state_type, state_type::value_type>;
+    auto stepper = odeint::make_controlled<stepper_type>(1e-10, 1e-6);
+
+    state_type phi0;
+    llps::utilities::fill_normal(phi0, { 69 });
+
+    //Model B paramaters
+    constexpr double a = -1.;
+    constexpr double b = -a;
+    constexpr double k = 1.;
+
+    //Integration paramaters
+    constexpr double t_min = 0.;
+    constexpr double t_max = 1000.;
+    constexpr double dt = 1.;
+
+    //Sampling
+    constexpr double sample_int = 1.;
+
+    //Only the central z-plane is stored, a full 3D frame per sample is far too large
+    constexpr size_t sample_slice = state_type::slices() / 2;
+
+    auto video = open_video<frame_type>(LLPS_OUTPUT_DIR"modelb3D(a=-b=-k=-1).dat", "Modelb 3D simulation using finite difference (z=" + std::to_string(sample_slice) + "),\nup to t=" + std::to_string(t_max));
+
+    llps::dispatch_fd_order(tuning.fd_order, [&]<size_t order>(llps::utilities::size_t_constant<order>) {
+        modelb3D<order, state_type> model(a, b, k, tuning.block_rows);
+        { llps::timer timer;
+
+            double last_t = t_min;
+            odeint::integrate_adaptive(stepper, std::ref(model), phi0, t_min, t_max, dt, [&](const state_type& phi, double t) {
+                if (t - last_t >= sample_int) {
+                    std::cout << "Progress: " << std::setprecision(2) << t << "/" << std::fixed << t_max << "\r";
+
+                    video.write(std::span<const double>(phi.slice_data(sample_slice), state_type::slice_size()), t);
+
+                    last_t += sample_int;
+                }
+            });
+        }
+    });
+
+    std::cout << "Arena: peak " << arena.peak_slots_in_use() << "/" << arena.slots() << " slots, " << arena.overflows() << " overflows\n";
+    assert(arena.overflows() == 0 && "arena_slots is too small for the stepper and model!");
+}
\ No newline at end of file
@@ -0,0 +1,103 @@
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <functional>
+#include <cassert>
+
+#include "boost/numeric/odeint.hpp"
+
+#include "_modelb_common.hpp"
+
+#include "llps/utilities/io.hpp"
+#include "llps/utilities/monitor.hpp"
+#include "llps/utilities/sampling.hpp"
+#include "llps/utilities/random.hpp"
+#include "llps/utilities/timer.hpp"
+#include "llps/calculus/differentiate.hpp"
+#include "llps/execution.hpp"
+#include "llps/tuning.hpp"
+#include "llps/grid_arena.hpp"
+#include "llps/grid.hpp"
+
+//A long periodic channel, for the interfaces across it
+using state_type = llps::pmr_grid<double, 256, 4096>;
+
+using monitor_type = llps::utilities::conservation_monitor<double, state_type::rows(), state_type::cols()>;
+
+//Two copies of the stepper's temporaries (integrate_adaptive takes it by value), the state and the model's temporaries
+static constexpr size_t arena_slots = 32;
+
+int main()
+{
+    using namespace boost::numeric;
+
+    //Order and threads measured best on this host by llps_autotune, LLPS_THREADS still taking precedence
+    const llps::tuning_entry tuning = llps::tuning_profile::from_environment(LLPS_OUTPUT_DIR"llps_tuning.txt").find(state_type::rows(), state_type::cols());
+
+    //Pinned before anything is allocated, so first touch happens on the threads' final cores
+    llps::execution_config config = llps::execution_config::from_environment();
+    tuning.apply(config);
+    std::cout << "Threads: " << llps::bind_threads(config).size() << ", binding: " << llps::to_string(config.binding) << ", order: " << tuning.fd_order << ", tile: " << tuning.block_rows << "x" << tuning.block_cols << "\n";
+
+    //Working storage of the stepper, the model and their temporaries, reserved and placed up front
+    llps::grid_arena arena(sizeof(state_type::value_type) * state_type::size(), arena_slots);
+    llps::scoped_default_resource arena_scope(&arena);
+
+    using stepper_type = odeint::runge_kutta_cash_karp54<state_type, state_type::value_type>;
+    auto stepper = odeint::make_controlled<stepper_type>(1e-10, 1e-6);
+
+    //Model B paramaters
+    constexpr double a = -1.;
+    constexpr double b = -a;
+    constexpr double k = 1.;
+
+    //Half the resolution across the channel, along the interfaces, as along it
+    constexpr double dx = 1.;
+    constexpr double dy = 2.;
+
+    //A dense stripe over the middle half of the channel, with two interfaces across it roughened by noise
+    state_type phi0;
+    llps::utilities::fill_normal(phi0, { 69 }, 0., 0.05);
+
+    for (size_t row = 0; row < state_type::rows(); ++row)
+        for (size_t col = 0; col < state_type::cols(); ++col)
+            phi0(row, col) += 4 * col >= state_type::cols() && 4 * col < 3 * state_type::cols() ? 1. : -1.;
+
+    //Integration paramaters
+    constexpr double t_min = 0.;
+    constexpr double t_max = 200.;
+    constexpr double dt = 0.1;
+
+    //Sampling, few frames as each is 8MiB
+    constexpr size_t frames = 20;
+    llps::utilities::log_time_sampler sampler(1., t_max, frames);
+
+    //Monitoring
+    constexpr double monitor_int = 1.;
+
+    auto video = open_video<state_type>(LLPS_OUTPUT_DIR"modelb_channel(a=-b=-k=-1).dat", "Modelb channel simulation using finite difference (dx=1, dy=2),\nup to t=" + std::to_string(t_max));
+
+    llps::dispatch_fd_order(tuning.fd_order, [&]<size_t order>(llps::utilities::size_t_constant<order>) {
+        monitor_type monitor(b, 1e-10, 1e-6, llps::utilities::monitor_policy::log, dx, dy, monitor_int);
+
+        modelb<order, state_type> model(a, b, k, { tuning.block_rows, tuning.block_cols }, dx, dy);
+        { llps::timer timer;
+
+            odeint::integrate_adaptive(stepper, std::ref(model), phi0, t_min, t_max, dt, [&](const state_type& phi, double t) {
+                monitor(phi, t, model);
+
+                if (sampler(t)) {
+                    std::cout << "Progress: " << std::setprecision(2) << t << "/" << std::fixed << t_max << "\r";
+
+                    video.write(phi, t);
+                }
+            });
+        }
+
+        std::cout << "Arena: peak " << arena.peak_slots_in_use() << "/" << arena.slots() << " slots, " << arena.overflows() << " overflows\n";
+        assert(arena.overflows() == 0 && "arena_slots is too small for the stepper and model!");
+        std::cout << "Mass drift: " << std::scientific << monitor.mass_drift() << ", violations: " << monitor.violations().size() << "\n";
+
+        save_time_series(LLPS_OUTPUT_DIR"modelb_channel(a=-b=-k=-1) F(t).dat", monitor.times(), monitor.energies(), "Free energy of Modelb channel simulation using finite difference", "F");
+    });
+}
@@ -0,0 +1,88 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <functional>
+#include <cassert>
+
+#include "boost/numeric/odeint.hpp"
+
+#include "_modelb_common.hpp"
+
+#include "llps/utilities/structure_factor.hpp"
+#include "llps/utilities/clusters.hpp"
+#include "llps/utilities/random.hpp"
+#include "llps/utilities/timer.hpp"
+#include "llps/execution.hpp"
+#include "llps/grid_arena.hpp"
+#include "llps/grid.hpp"
+
+/*
+* Coarsening of Model B after a quench, analysed in situ: the observer hands
+* each state to a radial_structure_factor and a cluster_statistics, and only
+* S(k, t), L(t) and the droplets of phi > 0 are written out, never the
+* frames.
+*/
+
+using state_type = llps::pmr_grid<double, 512, 512>;
+using analysis_type = llps::utilities::radial_structure_factor<double, state_type::rows(), state_type::cols()>;
+using clusters_type = llps::utilities::cluster_statistics<double, state_type::rows(), state_type::cols()>;
+
+//Two copies of the stepper's temporaries (integrate_adaptive takes it by value), the state and the model's temporaries
+static constexpr size_t arena_slots = 32;
+
+int main()
+{
+    using namespace boost::numeric;
+
+    //Pinned before anything is allocated, so first touch happens on the threads' final cores
+    const llps::execution_config config = llps::execution_config::from_environment();
+    std::cout << "Threads: " << llps::bind_threads(config).size() << ", binding: " << llps::to_string(config.binding) << "\n";
+
+    //Working storage of the stepper, the model and their temporaries, reserved and placed up front
+    llps::grid_arena arena(sizeof(state_type::value_type) * state_type::size(), arena_slots);
+    llps::scoped_default_resource arena_scope(&arena);
+
+    using stepper_type = odeint::runge_kutta_cash_karp54<state_type, state_type::value_type>;
+    auto stepper = odeint::make_controlled<stepper_type>(1e-10, 1e-6);
+
+    state_type phi0;
+    llps::utilities::fill_normal(phi0, { 69 }, 0., 0.1);
+
+    //Model B paramaters
+    constexpr double a = -1.;
+    constexpr double b = -a;
+    constexpr double k = 1.;
+
+    //Integration paramaters
+    constexpr double t_min = 0.;
+    constexpr double t_max = 1000.;
+    constexpr double dt = 1.;
+
+    //Sampling
+    constexpr double sample_int = 10.;
+
+    modelb<6, state_type> model(a, b, k);
+    analysis_type analysis(1., 1., sample_int);
+    clusters_type clusters(0., 1., 1., sample_int);
+
+    { llps::timer timer;
+
+        odeint::integrate_adaptive(stepper, std::ref(model), phi0, t_min, t_max, dt, [&](const state_type& phi, double t) {
+            analysis(phi, t);
+            clusters(phi, t);
+
+            if (analysis.times().back() == t)
+                std::cout << "Progress: " << std::setprecision(2) << t << "/" << std::fixed << t_max << ", L: " << analysis.lengths().back()
+                    << ", droplets: " << clusters.clusters().back().size() << "\r";
+        });
+    }
+
+    std::cout << "\nArena: peak " << arena.peak_slots_in_use() << "/" << arena.slots() << " slots, " << arena.overflows() << " overflows\n";
+    assert(arena.overflows() == 0 && "arena_slots is too small for the stepper and model!");
+
+    const std::string title = "Modelb coarsening (a=-b=-k=-1) on " + std::to_string(state_type::rows()) + "x" + std::to_string(state_type::cols()) + ",\nup to t=" + std::to_string(t_max);
+
+    save_structure_factor(LLPS_OUTPUT_DIR"modelb_coarsening(a=-b=-k=-1) S(k,t).dat", analysis, title);
+    save_domain_length(LLPS_OUTPUT_DIR"modelb_coarsening(a=-b=-k=-1) L(t).dat", analysis, title);
+    save_cluster_table(LLPS_OUTPUT_DIR"modelb_coarsening(a=-b=-k=-1) clusters.txt", clusters);
+}
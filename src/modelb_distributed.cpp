@@ -0,0 +1,110 @@
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+
+#include <mpi.h>
+
+#include "boost/numeric/odeint.hpp"
+
+#include "_modelb_common.hpp"
+
+#include "llps/distributed/slab_grid.hpp"
+#include "llps/distributed/differentiate.hpp"
+#include "llps/distributed/algebra.hpp"
+#include "llps/utilities/random.hpp"
+#include "llps/utilities/timer.hpp"
+#include "llps/grid.hpp"
+
+static constexpr size_t order = 6;
+
+using frame_type = llps::grid<double, 256, 256>;
+using state_type = llps::distributed::slab_grid<double, frame_type::rows(), frame_type::cols(), order / 2>;
+
+struct modelb_distributed
+{
+public:
+    modelb_distributed(double a, double b, double k) :
+        _a(a), _b(b), _k(k), _mu() {}
+
+public:
+    void operator()(const state_type& phi, state_type& dphi, double)
+    {
+        static constexpr double dx = 1.;
+        static constexpr double dy = 1.;
+
+        //Takes the communicator of the state, as odeint's temporaries do, a no-op after the first call
+        _mu.resize(phi);
+
+        llps::distributed::laplacian_central_fd<order>(phi, _mu, dx, dy);
+
+        auto mu_it = _mu.begin();
+        for (auto phi_it = phi.begin(); phi_it != phi.end(); ++phi_it, ++mu_it) {
+            const auto& phi = *phi_it;
+            *mu_it = phi * (_a + _b * phi * phi) - _k * (*mu_it);
+        }
+
+        llps::distributed::laplacian_central_fd<order>(_mu, dphi, dx, dy);
+    }
+
+private:
+    double _a, _b, _k;
+    state_type _mu;
+};
+
+int main(int argc, char** argv)
+{
+    MPI_Init(&argc, &argv);
+
+    using namespace boost::numeric;
+
+    using stepper_type = odeint::runge_kutta_cash_karp54<
+        state_type, double, state_type, double, llps::distributed::slab_algebra>;
+    auto stepper = odeint::make_controlled<stepper_type>(1e-10, 1e-6);
+
+    state_type phi0;
+    const bool is_root = phi0.rank() == 0;
+
+    //Every rank generates its own rows, indexed globally, so the initial condition does not depend on the rank count
+    llps::utilities::fill_normal(phi0, { 69 }, 0., 1., phi0.row_offset() * state_type::cols());
+
+    //Model B paramaters
+    constexpr double a = -1.;
+    constexpr double b = -a;
+    constexpr double k = 1.;
+
+    //Integration paramaters
+    constexpr double t_min = 0.;
+    constexpr double t_max = 1000.;
+    constexpr double dt = 1.;
+
+    //Sampling
+    constexpr double sample_int = 1.;
+    constexpr size_t samples = static_cast<size_t>((t_max - t_min)/sample_int) + 1;
+
+    std::vector<frame_type> result;
+    if (is_root)
+        result.reserve(samples);
+
+    frame_type frame;
+    modelb_distributed model(a, b, k);
+    {
+        double last_t = t_min;
+        odeint::integrate_adaptive(stepper, std::ref(model), phi0, t_min, t_max, dt, [&](const state_type& phi, double t) {
+            if (t - last_t >= sample_int) {
+                phi.gather(frame);
+
+                if (is_root) {
+                    std::cout << "Progress: " << std::setprecision(2) << t << "/" << std::fixed << t_max << "\r";
+                    result.push_back(frame);
+                }
+
+                last_t += sample_int;
+            }
+        });
+    }
+
+    if (is_root)
+        save_to_file(LLPS_OUTPUT_DIR"modelb_mpi(a=-b=-k=-1).dat", result, "Modelb simulation using finite difference on " + std::to_string(phi0.ranks()) + " ranks,\nup to t=" + std::to_string(t_max));
+
+    MPI_Finalize();
+}
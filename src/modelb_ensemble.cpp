@@ -0,0 +1,104 @@
+#include <iostream>
+#include <iomanip>
+#include <functional>
+#include <utility>
+#include <vector>
+#include <span>
+#include <cassert>
+
+#include "_modelb_common.hpp"
+
+#include "llps/stochastic/conserved_noise.hpp"
+#include "llps/stochastic/stochastic_heun.hpp"
+#include "llps/stochastic/ensemble.hpp"
+#include "llps/utilities/io.hpp"
+#include "llps/utilities/random.hpp"
+#include "llps/utilities/timer.hpp"
+#include "llps/execution.hpp"
+#include "llps/grid_arena.hpp"
+#include "llps/grid.hpp"
+
+using state_type = llps::pmr_grid<double, 256, 256>;
+using statistics_type = llps::stochastic::ensemble_statistics<double, state_type::rows(), state_type::cols()>;
+
+static constexpr size_t members = 16;
+
+//The members, the noise fields of each member, the stepper's four temporaries and the model's temporaries
+static constexpr size_t arena_slots = 3 * members + 8;
+
+int main()
+{
+    //Pinned before anything is allocated, so first touch happens on the threads' final cores
+    const llps::execution_config config = llps::execution_config::from_environment();
+    std::cout << "Threads: " << llps::bind_threads(config).size() << ", binding: " << llps::to_string(config.binding) << "\n";
+
+    //Working storage of every member, its noise and the shared stepper, reserved and placed up front
+    llps::grid_arena arena(sizeof(state_type::value_type) * state_type::size(), arena_slots);
+    llps::scoped_default_resource arena_scope(&arena);
+
+    //Model B paramaters
+    constexpr double a = -1.;
+    constexpr double b = -a;
+    constexpr double k = 1.;
+    constexpr double temperature = 0.05;
+
+    //Integration paramaters, dt within the stability limit of the explicit biharmonic term
+    constexpr double t_min = 0.;
+    constexpr double t_max = 1000.;
+    constexpr double dt = 0.01;
+
+    //Sampling
+    constexpr double sample_int = 10.;
+
+    //Members differ by their initial conditions and their noise, each on its own substream
+    llps::stochastic::ensemble<llps::stochastic::stochastic_heun<state_type>, state_type> ensemble(members);
+
+    std::vector<llps::stochastic::conserved_noise<6, state_type>> noises;
+    noises.reserve(members);
+
+    for (size_t member = 0; member < members; ++member) {
+        llps::utilities::fill_normal(ensemble[member], { 69, member }, 0., 0.1);
+        noises.emplace_back(temperature, 1., 1., llps::utilities::random_stream{ 420, member });
+    }
+
+    //Shared by every member
+    modelb<6, state_type> model(a, b, k);
+
+    statistics_type statistics;
+
+    //Each sample is written as it is taken, one video per quantity as none share a colour range
+    const std::string name = "modelb_ensemble(a=-b=-k=-1,T=0.05,M=" + std::to_string(members) + ")";
+    const std::string title = "Stochastic Modelb ensemble of " + std::to_string(members) + " members (T=" + std::to_string(temperature) + "),\nup to t=" + std::to_string(t_max);
+
+    auto mean_video = open_video<statistics_type::frame_type>((LLPS_OUTPUT_DIR + name + " mean.dat").c_str(), "Mean of " + title);
+    auto variance_video = open_video<statistics_type::frame_type>((LLPS_OUTPUT_DIR + name + " variance.dat").c_str(), "Variance of " + title);
+
+    llps::utilities::plot_header spectrum_header;
+    spectrum_header.title = "Structure factor of " + title;
+    spectrum_header.x_label = "k_x";
+    spectrum_header.y_label = "k_y";
+
+    llps::utilities::video_stream<double> structure_factor_video(LLPS_OUTPUT_DIR + name + " S(k).dat",
+        statistics_type::spectrum_type::cols(), statistics_type::spectrum_type::rows(), spectrum_header);
+
+    { llps::timer timer;
+
+        double last_t = t_min - sample_int;
+        ensemble.integrate_const([&](size_t member) { return std::make_pair(std::ref(model), std::ref(noises[member])); }, t_min, t_max, dt,
+            [&](std::span<const state_type> phi, double t) {
+                if (t - last_t >= sample_int - dt / 2) {
+                    std::cout << "Progress: " << std::setprecision(2) << t << "/" << std::fixed << t_max << "\r";
+
+                    statistics.sample(phi, t);
+                    mean_video.write(statistics.mean(), t);
+                    variance_video.write(statistics.variance(), t);
+                    structure_factor_video.write(statistics.structure_factor(), t);
+
+                    last_t += sample_int;
+                }
+            });
+    }
+
+    std::cout << "Arena: peak " << arena.peak_slots_in_use() << "/" << arena.slots() << " slots, " << arena.overflows() << " overflows\n";
+    assert(arena.overflows() == 0 && "arena_slots is too small for the stepper and model!");
+}
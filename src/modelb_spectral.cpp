@@ -1,56 +1,46 @@
 #include <iostream>
 #include <fstream>
-#include <random>
 #include <iomanip>
+#include <cmath>
+#include <functional>
+#include <cassert>
 
 #include "boost/numeric/odeint.hpp"
 
 #include "_modelb_common.hpp"
+#include "_modelb_spectral_common.hpp"
+#include "llps/utilities/random.hpp"
 #include "llps/utilities/timer.hpp"
 #include "llps/calculus/differentiate.hpp"
+#include "llps/calculus/hybrid.hpp"
+#include "llps/execution.hpp"
+#include "llps/grid_arena.hpp"
 #include "llps/grid.hpp"
 
-using state_type = llps::grid<double, 256, 256>;
+using state_type = llps::pmr_grid<double, 256, 256>;
+using hybrid_type = llps::calculus::hybrid_rhs<state_type, modelb<6, state_type>, std::reference_wrapper<modelb_spectral<state_type>>>;
 
-struct modelb_spectral
-{
-public:
-    modelb_spectral(double a, double b, double k) :
-        _a(a), _b(b), _k(k) {}
-
-public:
-    void operator()(const state_type& phi, state_type& dphi, double)
-    {
-        static constexpr double dx = 1;
-        static constexpr double dy = 1;
-
-        llps::calculus::laplacian_spectral(const_cast<state_type&>(phi), dphi, dx, dy);
-
-        auto dphi_it = dphi.begin();
-        for (auto phi_it = phi.begin(); phi_it != phi.end(); ++phi_it, ++dphi_it) {
-            const auto& phi = *phi_it;
-            *dphi_it = phi * (_a + _b * phi * phi) - _k * (*dphi_it);
-        }
-
-        llps::calculus::laplacian_spectral(dphi, dphi, dx, dy);
-    }
-
-private:
-    double _a, _b, _k;
-};
+//Two copies of the stepper's temporaries (integrate_adaptive takes it by value), the state, the models' temporaries and the
+//hybrid's copy of the model it checks against, with the two right hand sides it compares
+static constexpr size_t arena_slots = 37;
 
 int main()
 {
     using namespace boost::numeric;
 
+    //Pinned before anything is allocated, so first touch happens on the threads' final cores
+    const llps::execution_config config = llps::execution_config::from_environment();
+    std::cout << "Threads: " << llps::bind_threads(config).size() << ", binding: " << llps::to_string(config.binding) << "\n";
+
+    //Working storage of the stepper, the model and their temporaries, reserved and placed up front
+    llps::grid_arena arena(sizeof(state_type::value_type) * state_type::size(), arena_slots);
+    llps::scoped_default_resource arena_scope(&arena);
+
     using stepper_type = odeint::runge_kutta_cash_karp54<state_type, state_type::value_type>;
     auto stepper = odeint::make_controlled<stepper_type>(1e-10, 1e-6);
 
-    std::default_random_engine rnd_eng{ 69 };
-    std::normal_distribution normal_dist{ 0., 1. };
-
     state_type phi0;
-    std::ranges::generate(phi0, std::bind(normal_dist, rnd_eng));
+    llps::utilities::fill_normal(phi0, { 69 });
 
     //Model B paramaters
     constexpr double a = -1.;
@@ -64,27 +54,43 @@ int main()
 
     //Sampling variables
     constexpr double sample_rate = 1.;
-    constexpr size_t samples = static_cast<size_t>((t_max - t_min)/sample_rate) + 1;
 
-    std::vector<state_type> result;
-    result.reserve(samples);
+    //The spectral operator owns its FFT plans, so is passed by reference. Finite differences are used whenever they are
+    //cheaper per unit time and their right hand side is within 1e-3 of the spectral one, checked every 5 time units on
+    //accepted states, so the model never changes within a step
+    modelb_spectral<state_type> spectral_model(a, b, k, llps::calculus::dealiasing::truncation);
+    hybrid_type model(modelb<6, state_type>(a, b, k), std::ref(spectral_model), phi0, 1e-3, 5.);
+
+    std::cout << std::scientific << "Cost per unit time: finite difference " << model.cost(llps::calculus::hybrid_method::finite_difference)
+        << "s, spectral " << model.cost(llps::calculus::hybrid_method::spectral) << "s\n" << std::defaultfloat;
+
+    auto video = open_video<state_type>(LLPS_OUTPUT_DIR"modelb_spectral(a=-b=-k=-1).dat", "Modelb simulation up to t=" + std::to_string(t_max));
+
+    //Model B conserves mass, so every frame should sum to what phi0 does, across switches as well
+    const double mass0 = llps::utilities::summarise(phi0).sum;
+    double mass_drift = 0.;
 
     { llps::timer timer;
 
         double last_t = t_min;
         auto observer = [&](const state_type& phi, double t) {
+            model.check(phi, t);
+
             if (t - last_t >= sample_rate) {
                 std::cout << "Progress: " << std::setprecision(2) << t << "/" << std::fixed << t_max << "\r";
-                result.push_back(phi);
+                mass_drift = std::max(mass_drift, std::abs(video.write(phi, t).sum - mass0));
                 last_t += sample_rate;
             }
         };
 
-        //Time offset (from t_min) to switch from finite difference to spectral
-        constexpr double switch_offset = 20.;
-        odeint::integrate_adaptive(stepper, modelb<6>(a, b, k)      , phi0, t_min, t_min + switch_offset, dt, observer);
-        odeint::integrate_adaptive(stepper, modelb_spectral(a, b, k), phi0, t_min + switch_offset, t_max, dt, observer);
+        odeint::integrate_adaptive(stepper, std::ref(model), phi0, t_min, t_max, dt, observer);
     }
 
-    save_to_file(LLPS_OUTPUT_DIR"modelb_spectral(a=-b=-k=-1).dat", result, "Modelb simulation up to t=" + std::to_string(t_max));
+    for (const auto& event : model.switches())
+        std::cout << "t=" << event.t << ": " << (event.method == llps::calculus::hybrid_method::spectral ? "spectral" : "finite difference")
+            << " (difference " << event.difference << ")\n";
+
+    std::cout << "Arena: peak " << arena.peak_slots_in_use() << "/" << arena.slots() << " slots, " << arena.overflows() << " overflows\n";
+    assert(arena.overflows() == 0 && "arena_slots is too small for the stepper and model!");
+    std::cout << "Mass drift: " << std::scientific << mass_drift << ", range: [" << video.summary().min << ", " << video.summary().max << "]\n";
 }
\ No newline at end of file
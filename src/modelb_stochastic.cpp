@@ -0,0 +1,86 @@
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <cmath>
+#include <functional>
+#include <utility>
+#include <cassert>
+
+#include "boost/numeric/odeint.hpp"
+
+#include "_modelb_common.hpp"
+
+#include "llps/stochastic/conserved_noise.hpp"
+#include "llps/stochastic/stochastic_heun.hpp"
+#include "llps/utilities/io.hpp"
+#include "llps/utilities/random.hpp"
+#include "llps/utilities/timer.hpp"
+#include "llps/calculus/differentiate.hpp"
+#include "llps/execution.hpp"
+#include "llps/grid_arena.hpp"
+#include "llps/grid.hpp"
+
+using state_type = llps::pmr_grid<double, 256, 256>;
+
+//The stepper's four temporaries, the noise field, the state and the model's temporaries
+static constexpr size_t arena_slots = 16;
+
+int main()
+{
+    using namespace boost::numeric;
+
+    //Pinned before anything is allocated, so first touch happens on the threads' final cores
+    const llps::execution_config config = llps::execution_config::from_environment();
+    std::cout << "Threads: " << llps::bind_threads(config).size() << ", binding: " << llps::to_string(config.binding) << "\n";
+
+    //Working storage of the stepper, the model, the noise and their temporaries, reserved and placed up front
+    llps::grid_arena arena(sizeof(state_type::value_type) * state_type::size(), arena_slots);
+    llps::scoped_default_resource arena_scope(&arena);
+
+    llps::stochastic::stochastic_heun<state_type> stepper;
+
+    //Small fluctuations about the critical composition, which the noise then sustains
+    state_type phi0;
+    llps::utilities::fill_normal(phi0, { 69 }, 0., 0.1);
+
+    //Model B paramaters
+    constexpr double a = -1.;
+    constexpr double b = -a;
+    constexpr double k = 1.;
+    constexpr double temperature = 0.05;
+
+    //Integration paramaters, dt within the stability limit of the explicit biharmonic term
+    constexpr double t_min = 0.;
+    constexpr double t_max = 1000.;
+    constexpr double dt = 0.01;
+
+    //Sampling 
+    constexpr double sample_int = 1.;
+
+    auto video = open_video<state_type>(LLPS_OUTPUT_DIR"modelb_stochastic(a=-b=-k=-1,T=0.05).dat", "Stochastic Modelb simulation using finite difference (T=" + std::to_string(temperature) + "),\nup to t=" + std::to_string(t_max));
+
+    //The noise is a divergence, so mass is conserved to round off here too
+    const double mass0 = llps::utilities::summarise(phi0).sum;
+    double mass_drift = 0.;
+
+    modelb<6, state_type> model(a, b, k);
+    llps::stochastic::conserved_noise<6, state_type> noise(temperature, 1., 1., { 420 });
+
+    { llps::timer timer;
+
+        //t drifts by round off from a whole number of steps, so sample half a step early rather than one late
+        double last_t = t_min;
+        odeint::integrate_const(stepper, std::make_pair(std::ref(model), std::ref(noise)), phi0, t_min, t_max, dt, [&](const state_type& phi, double t) {
+            if (t - last_t >= sample_int - dt / 2) {
+                std::cout << "Progress: " << std::setprecision(2) << t << "/" << std::fixed << t_max << "\r";
+
+                mass_drift = std::max(mass_drift, std::abs(video.write(phi, t).sum - mass0));
+                last_t += sample_int;
+            }
+        });
+    }
+
+    std::cout << "Arena: peak " << arena.peak_slots_in_use() << "/" << arena.slots() << " slots, " << arena.overflows() << " overflows\n";
+    assert(arena.overflows() == 0 && "arena_slots is too small for the stepper and model!");
+    std::cout << "Mass drift: " << std::scientific << mass_drift << ", range: [" << video.summary().min << ", " << video.summary().max << "]\n";
+}
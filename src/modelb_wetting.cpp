@@ -0,0 +1,94 @@
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <numeric>
+#include <cmath>
+#include <functional>
+#include <cassert>
+
+#include "boost/numeric/odeint.hpp"
+
+#include "_modelb_common.hpp"
+
+#include "llps/utilities/io.hpp"
+#include "llps/utilities/sampling.hpp"
+#include "llps/utilities/random.hpp"
+#include "llps/utilities/timer.hpp"
+#include "llps/execution.hpp"
+#include "llps/tuning.hpp"
+#include "llps/boundary.hpp"
+#include "llps/grid_arena.hpp"
+#include "llps/grid.hpp"
+
+//A film between two walls across the rows, periodic along the columns
+using state_type = llps::pmr_grid<double, 128, 256>;
+
+//The first wall favours the dense phase and the last the dilute one; mu sees both as no flux
+using boundary_type = llps::boundary_conditions<llps::periodic, llps::periodic, llps::dirichlet, llps::dirichlet>;
+
+//Two copies of the stepper's temporaries (integrate_adaptive takes it by value) and the state
+static constexpr size_t arena_slots = 32;
+
+int main()
+{
+    using namespace boost::numeric;
+
+    //Order and threads measured best on this host by llps_autotune, LLPS_THREADS still taking precedence
+    const llps::tuning_entry tuning = llps::tuning_profile::from_environment(LLPS_OUTPUT_DIR"llps_tuning.txt").find(state_type::rows(), state_type::cols());
+
+    //Pinned before anything is allocated, so first touch happens on the threads' final cores
+    llps::execution_config config = llps::execution_config::from_environment();
+    tuning.apply(config);
+    std::cout << "Threads: " << llps::bind_threads(config).size() << ", binding: " << llps::to_string(config.binding) << ", order: " << tuning.fd_order << ", tile: " << tuning.block_rows << "x" << tuning.block_cols << "\n";
+
+    //Working storage of the stepper and its temporaries, reserved and placed up front
+    llps::grid_arena arena(sizeof(state_type::value_type) * state_type::size(), arena_slots);
+    llps::scoped_default_resource arena_scope(&arena);
+
+    using stepper_type = odeint::runge_kutta_cash_karp54<state_type, state_type::value_type>;
+    auto stepper = odeint::make_controlled<stepper_type>(1e-10, 1e-6);
+
+    state_type phi0;
+    llps::utilities::fill_normal(phi0, { 69 });
+
+    //Model B paramaters
+    constexpr double a = -1.;
+    constexpr double b = -a;
+    constexpr double k = 1.;
+
+    //Wall values, those of the two bulk phases
+    const boundary_type boundary({}, {}, llps::dirichlet{ 1. }, llps::dirichlet{ -1. });
+
+    //Integration paramaters
+    constexpr double t_min = 0.;
+    constexpr double t_max = 1000.;
+    constexpr double dt = 1.;
+
+    //Sampling, uniform in log(t) as for the periodic runs
+    constexpr size_t frames = 200;
+    llps::utilities::log_time_sampler sampler(0.1, t_max, frames);
+
+    auto video = open_video<state_type>(LLPS_OUTPUT_DIR"modelb_wetting(a=-b=-k=-1).dat", "Modelb simulation between Dirichlet walls (phi=1 and phi=-1) using finite difference,\nup to t=" + std::to_string(t_max));
+
+    const double mass0 = std::accumulate(phi0.begin(), phi0.end(), 0.);
+
+    llps::dispatch_fd_order(tuning.fd_order, [&]<size_t order>(llps::utilities::size_t_constant<order>) {
+        //By reference, so the stepper's copies do not duplicate its padded grids
+        modelb<order, state_type, boundary_type> model(a, b, k, { tuning.block_rows, tuning.block_cols }, 1., 1., boundary);
+        { llps::timer timer;
+
+            odeint::integrate_adaptive(stepper, std::ref(model), phi0, t_min, t_max, dt, [&](const state_type& phi, double t) {
+                if (sampler(t)) {
+                    std::cout << "Progress: " << std::setprecision(2) << t << "/" << std::fixed << t_max << "\r";
+
+                    video.write(phi, t);
+                }
+            });
+        }
+
+        std::cout << "Arena: peak " << arena.peak_slots_in_use() << "/" << arena.slots() << " slots, " << arena.overflows() << " overflows\n";
+        assert(arena.overflows() == 0 && "arena_slots is too small for the stepper and model!");
+        std::cout << "Mass drift: " << std::scientific << std::abs(std::accumulate(phi0.begin(), phi0.end(), 0.) - mass0) / state_type::size()
+                  << ", range: [" << video.summary().min << ", " << video.summary().max << "]\n";
+    });
+}
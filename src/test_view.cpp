@@ -1,87 +1,42 @@
 
 #include <iostream>
 #include <array>
-#include <random>
 #include <algorithm>
 #include <ranges>
 #include <fstream>
 
 #include "boost/numeric/odeint.hpp"
 
-//#include "_modelb_common.hpp"
+#include "_coupled_modelb_common.hpp"
 #include "multi_range_algebra.hpp"
 
 #include "llps/grid.hpp"
+#include "llps/utilities/random.hpp"
 #include "llps/utilities/timer.hpp"
 #include "llps/utilities/io.hpp"
 #include "llps/calculus/differentiate.hpp"
 
 using time_type = double;
 
-template<size_t order, typename _field_type>
-struct modelb_coupled
-{
-private:
-    using _state_type = std::array<_field_type, 2>;
-    using _value_type = typename _field_type::value_type;
-
-public:
-    modelb_coupled(double a, double b, double k, std::array<double, 2> xi) :
-        _a(a), _b(b), _k(k), _xi(xi) {}
-
-public:
-    LLPS_FORCE_INLINE void operator()(const _state_type& phi, _state_type& dphi, time_type)
-    {
-        static constexpr _value_type dx = 1.;
-        static constexpr _value_type dy = 1.;
-
-        for (size_t i = 0, j = 1; i < 2; j = i++) {
-            const auto& field_i = phi[i];
-            const auto& field_j = phi[j];
-            auto& dfield_i = dphi[i];
-
-            llps::calculus::laplacian_central_fd<order>(field_i, dfield_i, dx, dy);
-
-            auto field_i_it = field_i.begin();
-            auto field_j_it = field_j.begin();
-            for (auto& dfield_i_val : dfield_i) {
-                const _value_type field_i_val = *field_i_it;
-
-                dfield_i_val = field_i_val * (_a + _b * field_i_val * field_i_val) - _k * dfield_i_val + _xi[i] * (*field_j_it);
-
-                ++field_i_it;
-                ++field_j_it;
-            }
-
-            dfield_i = llps::calculus::laplacian_central_fd<order>(dfield_i, dx, dy);
-        }
-    }
-
-private:
-    _value_type _a, _b, _k;
-    std::array<_value_type, 2> _xi;
-};
-
 int main()
 {
     using namespace boost::numeric;
 
     using field_type = llps::grid<double, 256, 256>;
-    using state_type = std::array<field_type, 2>;
+    using model_type = coupled_modelb<6, field_type, 2>;
+    using state_type = model_type::state_type;
     using value_type = field_type::value_type;
 
     using stepper_type = odeint::runge_kutta_cash_karp54<state_type, value_type, state_type, time_type, array_of_ranges_algebra>;
     auto stepper = odeint::make_controlled<stepper_type>(1e-10, 1e-6);
 
-    std::default_random_engine rnd_eng{ 69 };
-    std::normal_distribution normal_dist{ 0., 1. };
-
     state_type phi0;
     value_type intphi0 = 0;
-    for (auto& field : phi0) {
-        std::ranges::generate(field, std::bind(normal_dist, rnd_eng));
+    for (size_t species = 0; species < phi0.size(); ++species) {
+        auto& field = phi0[species];
+        llps::utilities::fill_normal(field, { 69, species });
         
-        intphi0 = std::accumulate(field.begin(), field.end(), intphi0);
+        intphi0 += llps::utilities::summarise(field).sum;
     }
 
     //Model B paramaters
@@ -102,6 +57,8 @@ int main()
 
     std::vector<time_type> times;
     std::vector<field_type> fields[2];
+    //Range of every frame, kept up as frames are sampled rather than found afterwards
+    llps::utilities::field_summary<value_type> range;
 
     //Initialise outputs
     times.reserve(samples);
@@ -111,18 +68,20 @@ int main()
 
     //Integration:
 
-    auto model = modelb_coupled<6, field_type>(a, b, k, {xi1, xi2});
+    auto model = model_type({ a, a }, { b, b }, { k, k }, {{ { 0., xi1 }, { xi2, 0. } }}, {});
     { 
         llps::timer timer;
 
         time_type last_t = -sample_int;
-        odeint::integrate_adaptive(stepper, model, phi0, t_min, t_max, dt, [&](const state_type& phi, time_type t)
+        odeint::integrate_adaptive(stepper, std::ref(model), phi0, t_min, t_max, dt, [&](const state_type& phi, time_type t)
         {
             if (t - last_t >= sample_int) {
                 std::cout << "Progress: " << std::setprecision(2) << t << "/" << std::fixed << t_max << "\r";
 
-                for (size_t i = 0; i < std::ranges::size(fields); ++i)
+                for (size_t i = 0; i < std::ranges::size(fields); ++i) {
                     fields[i].push_back(phi[i]);
+                    range += llps::utilities::summarise(phi[i]);
+                }
 
                 times.push_back(t);
                 last_t += sample_int;
@@ -130,15 +89,8 @@ int main()
         });
     }
 
-    value_type vmin = std::numeric_limits<value_type>::max();
-    value_type vmax = std::numeric_limits<value_type>::min();
-    for (const auto& field : fields) {
-        for (const auto& frame : field) {
-            auto [frame_min, frame_max] = std::ranges::minmax(frame);
-            vmin = std::min(vmin, frame_min);
-            vmax = std::max(vmax, frame_max);
-        }
-    }
+    const value_type vmin = range.min;
+    const value_type vmax = range.max;
 
     std::string data_suffix = std::format(
         "phi0={:.2f},a={:.2f},b={:.2f},k={:.2f},xi_1={:.2f},xi_2={:.2f},t={}", intphi0, a, b, k, xi1, xi2, t_max);
@@ -0,0 +1,159 @@
+#include "gtest/gtest.h"
+
+#include <cmath>      //Access to std::cos and std::abs
+#include <numbers>    //Access to std::numbers::pi
+#include <numeric>    //Access to std::accumulate
+#include <functional> //Access to std::ref
+#include <algorithm>  //Access to std::max
+
+#include <boost/numeric/odeint.hpp>
+
+#include "_modelb_common.hpp"
+#include "calculus/stencil.hpp"
+#include "utilities/data_analytics.hpp"
+#include "utilities/random.hpp"
+#include "utilities/meta.hpp"
+#include "boundary.hpp"
+#include "grid.hpp"
+
+using namespace llps::calculus;
+
+using walls_type = llps::boundary_conditions<llps::no_flux, llps::dirichlet, llps::dirichlet, llps::no_flux>;
+
+template<class Grid>
+double interior_sum(const Grid& grid)
+{
+    double sum = 0.;
+    for (size_t row = 0; row < grid.rows(); ++row)
+        for (size_t col = 0; col < grid.cols(); ++col)
+            sum += grid(row, col);
+
+    return sum;
+}
+
+TEST(boundary_tests, test_halo_fill)
+{
+    llps::grid<double, 4, 5> phi;
+    for (size_t row = 0; row < 4; ++row)
+        for (size_t col = 0; col < 5; ++col)
+            phi(row, col) = 10. * row + col;
+
+    llps::padded_grid<double, 4, 5, 2> padded;
+
+    //Mirrored before the first column, reflected about 100 after the last
+    llps::boundary_conditions<llps::no_flux, llps::dirichlet, llps::periodic, llps::periodic>({}, { 100. }).load(phi, padded);
+    ASSERT_EQ(padded.at(1, -1), 10.);
+    ASSERT_EQ(padded.at(1, -2), 11.);
+    ASSERT_EQ(padded.at(1, 5), 200. - 14.);
+    ASSERT_EQ(padded.at(1, 6), 200. - 13.);
+
+    //Wrapped across the rows, corners included
+    ASSERT_EQ(padded.at(-1, 2), 32.);
+    ASSERT_EQ(padded.at(5, 2), 12.);
+    ASSERT_EQ(padded.at(-1, -1), 30.);
+    ASSERT_EQ(padded.at(4, 6), 200. - 3.);
+}
+
+TEST(boundary_tests, test_periodic_matches_wrapping)
+{
+    llps::grid<double, 24, 40> phi, expected, actual;
+    llps::utilities::fill_normal(phi, { 7 });
+
+    const auto laplacian = make_stencil_operator<6>(D_xx + D_yy, 0.5, 0.25);
+    laplacian(phi, expected);
+
+    llps::padded_grid<double, 24, 40, decltype(laplacian)::radius> padded;
+    llps::periodic_boundary().load(phi, padded);
+    laplacian(padded, actual);
+
+    ASSERT_LT(llps::utilities::max_abs_error(expected, actual), 1e-12);
+}
+
+TEST(boundary_tests, test_no_flux_accuracy)
+{
+    //cos(x) cos(2y) has no flux through the walls of [0, pi]^2, sampled at cell centres
+    static constexpr size_t n = 48;
+    static constexpr double h = std::numbers::pi / n;
+
+    llps::grid<double, n, n> phi, expected, actual;
+    for (size_t row = 0; row < n; ++row) {
+        for (size_t col = 0; col < n; ++col) {
+            phi(row, col) = std::cos((col + 0.5) * h) * std::cos(2. * (row + 0.5) * h);
+            expected(row, col) = -5. * phi(row, col);
+        }
+    }
+
+    const auto laplacian = make_stencil_operator<6>(D_xx + D_yy, h, h);
+
+    llps::padded_grid<double, n, n, decltype(laplacian)::radius> padded;
+    llps::no_flux_box().load(phi, padded);
+    laplacian(padded, actual);
+
+    //Even reflection continues the field smoothly, so the walls cost no accuracy
+    ASSERT_LT(llps::utilities::max_abs_error(expected, actual), 1e-7);
+}
+
+TEST(boundary_tests, test_laplacian_sums_vanish)
+{
+    llps::grid<double, 30, 50> phi, dphi;
+    llps::utilities::fill_normal(phi, { 11 });
+
+    llps::padded_grid<double, 30, 50, 4> padded;
+
+    //The flux of every order balances over the interior between no flux walls
+    llps::utilities::constexpr_for<1, 5>([&]<size_t I>(llps::utilities::size_t_constant<I>) {
+        walls_type({}, { 1. }, { -1. }).conserving().load(phi, padded);
+        make_stencil_operator<2 * I>(D_xx + D_yy, 1., 0.5)(padded, dphi);
+        ASSERT_LT(std::abs(interior_sum(dphi)), 1e-10) << "order " << 2 * I;
+
+        llps::no_flux_channel().load(phi, padded);
+        make_stencil_operator<2 * I>(D_xx + D_yy, 1., 0.5)(padded, dphi);
+        ASSERT_LT(std::abs(interior_sum(dphi)), 1e-10) << "order " << 2 * I;
+    });
+}
+
+/*
+* Model B as the drivers run it: phi under boundary, mu under its conserving
+* form, so mass may only drift by round-off.
+*/
+template<size_t order, modelb_laplacian laplacian = modelb_laplacian::central, class Boundary>
+void check_mass_conservation(Boundary boundary)
+{
+    using namespace boost::numeric;
+    using state_type = llps::grid<double, 32, 32>;
+
+    state_type phi;
+    llps::utilities::fill_normal(phi, { 3 }, 0.2, 0.1);
+
+    const double mass0 = std::accumulate(phi.begin(), phi.end(), 0.);
+
+    modelb<order, state_type, Boundary, laplacian> model(-1., 1., 1., {}, 1., 1., boundary);
+    auto stepper = odeint::make_controlled<odeint::runge_kutta_cash_karp54<state_type>>(1e-10, 1e-6);
+    odeint::integrate_adaptive(stepper, std::ref(model), phi, 0., 50., 0.1);
+
+    //Far enough to have separated
+    double max = 0.;
+    for (double value : phi)
+        max = std::max(max, std::abs(value));
+    ASSERT_GT(max, 0.5);
+
+    ASSERT_NEAR(std::accumulate(phi.begin(), phi.end(), 0.) / state_type::size(), mass0 / state_type::size(), 1e-12);
+}
+
+TEST(boundary_tests, test_no_flux_mass_conservation)
+{
+    check_mass_conservation<4>(llps::no_flux_box());
+    check_mass_conservation<4>(llps::no_flux_channel());
+}
+
+TEST(boundary_tests, test_dirichlet_mass_conservation)
+{
+    //Walls at fixed phi still let no mass through, mu being no flux there
+    check_mass_conservation<4>(walls_type({}, { 1. }, { -1. }));
+}
+
+TEST(boundary_tests, test_compact_laplacian_mass_conservation)
+{
+    check_mass_conservation<2, modelb_laplacian::isotropic>(walls_type({}, { 1. }, { -1. }));
+    check_mass_conservation<4, modelb_laplacian::mehrstellen>(llps::periodic_boundary());
+}
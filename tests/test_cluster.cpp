@@ -0,0 +1,105 @@
+#include "gtest/gtest.h"
+
+#include <vector>    //Access to std::vector
+#include <algorithm> //Access to std::ranges::equal and std::ranges::fill
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif // _OPENMP
+
+#include "utilities/clusters.hpp"
+#include "utilities/random.hpp"
+#include "grid.hpp"
+
+using grid_type  = llps::grid<double, 32, 40>;
+using label_type = llps::grid<int32_t, 32, 40>;
+
+//Fills the rectangle [row, row + height) x [col, col + width), wrapping around the edges
+static void fill_rectangle(grid_type& phi, size_t row, size_t col, size_t height, size_t width)
+{
+    for (size_t i = 0; i < height; ++i)
+        for (size_t j = 0; j < width; ++j)
+            phi((row + i) % grid_type::rows(), (col + j) % grid_type::cols()) = 1.;
+}
+
+TEST(cluster_tests, test_label_separate_and_periodic_clusters)
+{
+    grid_type phi;
+    std::ranges::fill(phi, -1.);
+
+    //Two separate droplets, one wrapping around both periodic edges, and a diagonal neighbour that is not 4-connected
+    fill_rectangle(phi, 4, 4, 3, 5);
+    fill_rectangle(phi, 30, 38, 4, 4);
+    fill_rectangle(phi, 7, 9, 1, 1);
+
+    label_type labels;
+    ASSERT_EQ(llps::utilities::label_clusters(phi, labels), 3);
+
+    //Numbered by first point in row-major order: the wrapping droplet starts at (0, 0)
+    EXPECT_EQ(labels(0, 0), 0);
+    EXPECT_EQ(labels(31, 39), 0);
+    EXPECT_EQ(labels(1, 38), 0);
+    EXPECT_EQ(labels(4, 4), 1);
+    EXPECT_EQ(labels(6, 8), 1);
+    EXPECT_EQ(labels(7, 9), 2);
+    EXPECT_EQ(labels(10, 10), -1);
+}
+
+TEST(cluster_tests, test_statistics_sizes_and_wrapped_centroids)
+{
+    grid_type phi;
+    std::ranges::fill(phi, -1.);
+
+    fill_rectangle(phi, 4, 4, 3, 5);
+    fill_rectangle(phi, 30, 38, 4, 4);
+
+    llps::utilities::cluster_statistics<double, grid_type::rows(), grid_type::cols()> statistics(0., 0.5, 2.);
+    statistics.sample(phi, 1.);
+
+    ASSERT_EQ(statistics.samples(), 1);
+
+    const auto& clusters = statistics.clusters().front();
+    ASSERT_EQ(clusters.size(), 2);
+
+    //Rows 30, 31, 0, 1 and cols 38, 39, 0, 1, centred on the corner
+    EXPECT_EQ(clusters[0].size, 16);
+    EXPECT_NEAR(clusters[0].x, 0.5 * 39.5, 1e-9);
+    EXPECT_NEAR(clusters[0].y, 2. * 31.5, 1e-9);
+
+    EXPECT_EQ(clusters[1].size, 15);
+    EXPECT_NEAR(clusters[1].x, 0.5 * 6., 1e-9);
+    EXPECT_NEAR(clusters[1].y, 2. * 5., 1e-9);
+}
+
+#ifdef _OPENMP
+TEST(cluster_tests, test_labels_thread_count_independent)
+{
+    grid_type phi;
+    llps::utilities::fill_normal(phi, { 7 });
+
+    label_type serial, parallel;
+
+    const int threads = omp_get_max_threads();
+
+    omp_set_num_threads(1);
+    const size_t serial_count = llps::utilities::label_clusters(phi, serial);
+
+    //More threads than make sense, so blocks are a row or two high
+    omp_set_num_threads(13);
+    const size_t parallel_count = llps::utilities::label_clusters(phi, parallel);
+
+    //The runtime may then grant each parallel region a different number of threads
+    label_type dynamic;
+    omp_set_dynamic(1);
+    const size_t dynamic_count = llps::utilities::label_clusters(phi, dynamic);
+    omp_set_dynamic(0);
+
+    omp_set_num_threads(threads);
+
+    ASSERT_EQ(serial_count, parallel_count);
+    ASSERT_TRUE(std::ranges::equal(serial, parallel));
+
+    ASSERT_EQ(serial_count, dynamic_count);
+    ASSERT_TRUE(std::ranges::equal(serial, dynamic));
+}
+#endif // _OPENMP
@@ -0,0 +1,129 @@
+#include "gtest/gtest.h"
+
+#include <array>     //Access to std::array
+#include <algorithm> //Access to std::max and std::ranges::equal
+#include <cmath>     //Access to std::abs
+#include <numbers>   //Access to std::numbers::pi
+
+#include "_coupled_modelb_common.hpp"
+#include "calculus/differentiate.hpp"
+#include "utilities/random.hpp"
+#include "grid.hpp"
+
+//Rectangular and odd sized, so that the tiles and the wrapped edges are all exercised
+static constexpr size_t rows = 45;
+static constexpr size_t cols = 70;
+
+using field_type = llps::grid<double, rows, cols>;
+using model_type = coupled_modelb<6, field_type, 2>;
+using state_type = model_type::state_type;
+
+/*
+* The two field right hand side the coupled drivers were written with: per
+* field, a laplacian, the pointwise chemical potential and a second laplacian,
+* then the switching terms.
+*/
+static void two_field_rhs(
+    const state_type& phi, state_type& dphi,
+    double a, double b, double k, std::array<double, 2> xi, double k01, double k10,
+    double dx, double dy)
+{
+    for (size_t i = 0, j = 1; i < 2; j = i++) {
+        field_type mu;
+        llps::calculus::laplacian_central_fd<6>(phi[i], mu, dx, dy);
+
+        for (size_t index = 0; index < field_type::size(); ++index) {
+            const double phi_i = phi[i].data()[index];
+            mu.data()[index] = phi_i * (a + b * phi_i * phi_i) - k * mu.data()[index] + xi[i] * phi[j].data()[index];
+        }
+
+        llps::calculus::laplacian_central_fd<6>(mu, dphi[i], dx, dy);
+    }
+
+    for (size_t index = 0; index < field_type::size(); ++index) {
+        const double switching = k01 * phi[1].data()[index] - k10 * phi[0].data()[index];
+        dphi[0].data()[index] += switching;
+        dphi[1].data()[index] -= switching;
+    }
+}
+
+TEST(coupled_modelb_tests, test_two_fields_match_separate_sweeps)
+{
+    constexpr double a = -1., b = 1., k = 0.7;
+    constexpr double xi1 = 2., xi2 = -1.;
+    constexpr double k01 = 3e-2, k10 = 5e-2;
+
+    const double dx = 2. * std::numbers::pi / cols;
+    const double dy = 1.5 * dx;
+
+    state_type phi;
+    for (size_t species = 0; species < phi.size(); ++species)
+        llps::utilities::fill_normal(phi[species], { 7, species });
+
+    state_type expected;
+    two_field_rhs(phi, expected, a, b, k, { xi1, xi2 }, k01, k10, dx, dy);
+
+    model_type model({ a, a }, { b, b }, { k, k }, {{ { 0., xi1 }, { xi2, 0. } }}, {{ { 0., k10 }, { k01, 0. } }}, {}, dx, dy);
+
+    state_type actual;
+    model(phi, actual, 0.);
+
+    for (size_t species = 0; species < 2; ++species) {
+        //Weights are premultiplied by the spacings rather than divided, so only agree up to rounding of the largest terms
+        double scale = 0.;
+        for (double value : expected[species])
+            scale = std::max(scale, std::abs(value));
+
+        for (size_t index = 0; index < field_type::size(); ++index)
+            ASSERT_NEAR(actual[species].data()[index], expected[species].data()[index], 1e-12 * scale) << "species " << species << ", index " << index;
+    }
+}
+
+TEST(coupled_modelb_tests, test_tiles)
+{
+    const model_type::matrix_type xi{{ { 0., 2. }, { -1., 0. } }};
+    const model_type::matrix_type rates{{ { 0., 5e-2 }, { 3e-2, 0. } }};
+
+    state_type phi;
+    for (size_t species = 0; species < phi.size(); ++species)
+        llps::utilities::fill_normal(phi[species], { 13, species });
+
+    state_type expected, actual;
+    model_type({ -1., -1. }, { 1., 1. }, { 0.7, 0.7 }, xi, rates)(phi, expected, 0.);
+
+    //Tiles only change the order points are visited in, even those not dividing the grid or wider than it
+    for (const llps::calculus::fd2D_tile tile : { llps::calculus::fd2D_tile{ 1, 1 }, llps::calculus::fd2D_tile{ 5, 7 }, llps::calculus::fd2D_tile{ 2 * rows, 2 * cols } }) {
+        model_type({ -1., -1. }, { 1., 1. }, { 0.7, 0.7 }, xi, rates, tile)(phi, actual, 0.);
+
+        for (size_t species = 0; species < 2; ++species)
+            ASSERT_TRUE(std::ranges::equal(expected[species], actual[species])) << "Failed at: tile=" << tile.rows << "x" << tile.cols << ", species " << species;
+    }
+}
+
+TEST(coupled_modelb_tests, test_mass_conservation)
+{
+    using three_field_model = coupled_modelb<4, field_type, 3>;
+
+    three_field_model model(
+        { -1., -0.5, 1. }, { 1., 2., 0. }, { 1., 0.5, 0. },
+        {{ { 0., 2., 0.5 }, { -1., 0., 0. }, { 0., 0.3, 0. } }},
+        {{ { 0., 1e-2, 2e-2 }, { 0., 0., 3e-2 }, { 4e-2, 0., 0. } }});
+
+    three_field_model::state_type phi, dphi;
+    for (size_t species = 0; species < phi.size(); ++species)
+        llps::utilities::fill_normal(phi[species], { 11, species });
+
+    model(phi, dphi, 0.);
+
+    //Switching moves mass between species, but none is lost overall
+    double total = 0.;
+    double scale = 0.;
+    for (const field_type& field : dphi) {
+        for (double value : field) {
+            total += value;
+            scale += std::abs(value);
+        }
+    }
+
+    ASSERT_LE(std::abs(total), 1e-12 * scale);
+}
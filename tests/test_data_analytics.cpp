@@ -5,6 +5,7 @@
 #include <numeric> //Access to std::iota
 
 #include "utilities/data_analytics.hpp"
+#include "utilities/reduction.hpp"
 
 TEST(analytics_tests, test_poly_fit1D)
 {
@@ -32,3 +33,34 @@ TEST(analytics_tests, test_poly_fit1D_trivial)
     ASSERT_EQ(fit.intercept, 0);
     ASSERT_EQ(fit.gradient, 1);
 }
+
+TEST(analytics_tests, test_summarise)
+{
+    //Long enough that every thread and vector lane gets some, and all negative so a min() based maximum would show
+    std::vector<double> x(10007);
+    std::iota(x.begin(), x.end(), -10007.);
+
+    auto summary = llps::utilities::summarise(x);
+    ASSERT_EQ(summary.count, x.size());
+    ASSERT_EQ(summary.min, -10007.);
+    ASSERT_EQ(summary.max, -1.);
+    ASSERT_DOUBLE_EQ(summary.sum, -10007. * 10008. / 2.);
+    ASSERT_DOUBLE_EQ(summary.square_sum, 10007. * 10008. * 20015. / 6.);
+    ASSERT_DOUBLE_EQ(summary.mean(), -5004.);
+}
+
+TEST(analytics_tests, test_summary_merge)
+{
+    const std::vector<double> x{ 1., 2., 3. };
+    const std::vector<double> y{ -4., 5. };
+
+    llps::utilities::field_summary<double> summary;
+    summary += llps::utilities::summarise(x);
+    summary += llps::utilities::summarise(y);
+
+    ASSERT_EQ(summary.count, 5);
+    ASSERT_EQ(summary.min, -4.);
+    ASSERT_EQ(summary.max, 5.);
+    ASSERT_EQ(summary.sum, 7.);
+    ASSERT_EQ(summary.square_sum, 55.);
+}
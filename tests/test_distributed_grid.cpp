@@ -0,0 +1,176 @@
+#include "gtest/gtest.h"
+
+#include <cmath>     //Access to std::exp
+#include <numbers>   //Access to std::numbers::pi
+#include <stdexcept> //Access to std::invalid_argument
+
+#include <mpi.h>
+
+#include "boost/numeric/odeint/util/state_wrapper.hpp"
+#include "boost/numeric/odeint/util/resizer.hpp"
+
+#include "distributed/slab_grid.hpp"
+#include "distributed/differentiate.hpp"
+#include "distributed/algebra.hpp"
+#include "calculus/differentiate.hpp"
+#include "distributed/fourier_spectral.hpp"
+#include "grid.hpp"
+
+//Deliberately not a multiple of common rank counts, to exercise uneven slabs
+static constexpr size_t rows = 37;
+static constexpr size_t cols = 24;
+static constexpr size_t halo = 3;
+
+using slab_t = llps::distributed::slab_grid<double, rows, cols, halo>;
+using grid_t = llps::grid<double, rows, cols>;
+
+TEST(distributed_grid_tests, test_halo_exchange)
+{
+    slab_t phi;
+
+    for (size_t row = 0; row < phi.rows(); ++row)
+        for (size_t col = 0; col < cols; ++col)
+            phi(row, col) = static_cast<double>((phi.row_offset() + row) * cols + col);
+
+    phi.exchange_halos();
+
+    for (ptrdiff_t row = -static_cast<ptrdiff_t>(halo); row < static_cast<ptrdiff_t>(phi.rows() + halo); ++row) {
+        const size_t global_row = (phi.row_offset() + rows + row) % rows;
+
+        for (size_t col = 0; col < cols; ++col)
+            ASSERT_EQ(phi.row_data(row)[col], static_cast<double>(global_row * cols + col)) << "Failed at: row=" << row << ", col=" << col;
+    }
+}
+
+TEST(distributed_grid_tests, test_laplacian_matches_serial)
+{
+    static constexpr size_t error_order = 6;
+    static constexpr double dx = 2. * std::numbers::pi / cols;
+    static constexpr double dy = 2. * std::numbers::pi / rows;
+
+    grid_t global;
+    llps::apply_equi2D(global, 0., 2. * std::numbers::pi, [](double x, double y) {
+        return std::exp(std::cos(x) + std::sin(y));
+    });
+
+    const grid_t expected = llps::calculus::laplacian_central_fd<error_order>(global, dx, dy);
+
+    slab_t phi, dphi;
+    phi.scatter(global);
+    llps::distributed::laplacian_central_fd<error_order>(phi, dphi, dx, dy);
+
+    for (size_t row = 0; row < phi.rows(); ++row)
+        for (size_t col = 0; col < cols; ++col)
+            ASSERT_NEAR(dphi(row, col), expected(phi.row_offset() + row, col), 1e-12) << "Failed at: row=" << row << ", col=" << col;
+}
+
+TEST(distributed_grid_tests, test_too_few_rows_throws)
+{
+    //On its own, a rank owns every row, so only the row count decides
+    using narrow_t = llps::distributed::slab_grid<double, halo - 1, cols, halo>;
+    using exact_t = llps::distributed::slab_grid<double, halo, cols, halo>;
+
+    ASSERT_THROW(narrow_t{ MPI_COMM_SELF }, std::invalid_argument);
+    ASSERT_NO_THROW(exact_t{ MPI_COMM_SELF });
+}
+
+TEST(distributed_grid_tests, test_norm_inf_is_global)
+{
+    slab_t phi;
+    std::ranges::fill(phi, 0.);
+
+    //Only the last rank holds the largest magnitude
+    phi(0, 0) = -static_cast<double>(phi.rank() + 1);
+
+    const double norm = llps::distributed::slab_algebra::norm_inf(phi);
+    ASSERT_EQ(norm, static_cast<double>(phi.ranks()));
+}
+
+TEST(distributed_grid_tests, test_temporaries_share_communicator)
+{
+    using namespace boost::numeric;
+
+    int world_rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &world_rank);
+
+    //Even and odd ranks each run their own grid
+    MPI_Comm half;
+    MPI_Comm_split(MPI_COMM_WORLD, world_rank % 2, world_rank, &half);
+
+    {
+        slab_t phi(half);
+
+        //As odeint sets up the temporaries of its steppers
+        odeint::state_wrapper<slab_t> temporary;
+        odeint::adjust_size_by_resizeability(temporary, phi, odeint::is_resizeable<slab_t>::type());
+
+        ASSERT_EQ(temporary.m_v.communicator(), half);
+        ASSERT_EQ(temporary.m_v.rows(), phi.rows());
+        ASSERT_EQ(temporary.m_v.row_offset(), phi.row_offset());
+
+        //Reductions over a temporary only see the ranks of its own half
+        std::ranges::fill(temporary.m_v, 0.);
+        temporary.m_v(0, 0) = -static_cast<double>(world_rank + 1);
+
+        int half_ranks;
+        MPI_Comm_size(half, &half_ranks);
+
+        //The largest world rank of the same parity as this one
+        const int last_of_half = world_rank % 2 + 2 * (half_ranks - 1);
+        ASSERT_EQ(llps::distributed::slab_algebra::norm_inf(temporary.m_v), static_cast<double>(last_of_half + 1));
+
+        const slab_t copy = phi;
+        ASSERT_EQ(copy.communicator(), half);
+    }
+
+    MPI_Comm_free(&half);
+}
+
+TEST(distributed_grid_tests, test_spectral_laplacian)
+{
+    //On the odd number of rows of the other tests, which the transforms support as the serial ones do
+    static constexpr double dx = 2. * std::numbers::pi / cols;
+    static constexpr double dy = 2. * std::numbers::pi / rows;
+
+    llps::grid<double, rows, cols> global, expected;
+    llps::apply_equi2D(global, 0., 2. * std::numbers::pi, [](double x, double y) {
+        return std::sin(2. * x) * std::cos(3. * y);
+    });
+    llps::apply_equi2D(expected, 0., 2. * std::numbers::pi, [](double x, double y) {
+        return -13. * std::sin(2. * x) * std::cos(3. * y);
+    });
+
+    slab_t phi, dphi;
+    phi.scatter(global);
+
+    llps::distributed::slab_fft<rows, cols> fft;
+    const llps::distributed::slab_spectral_tables<rows, cols> tables(fft, dx, dy);
+    llps::distributed::laplacian_spectral(fft, tables, phi, dphi);
+
+    for (size_t row = 0; row < phi.rows(); ++row)
+        for (size_t col = 0; col < cols; ++col)
+            ASSERT_NEAR(dphi(row, col), expected(phi.row_offset() + row, col), 1e-10) << "Failed at: row=" << row << ", col=" << col;
+}
+
+int main(int argc, char** argv)
+{
+    MPI_Init(&argc, &argv);
+    testing::InitGoogleTest(&argc, argv);
+
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    //Only report from the root rank
+    if (rank != 0) {
+        auto& listeners = testing::UnitTest::GetInstance()->listeners();
+        delete listeners.Release(listeners.default_result_printer());
+    }
+
+    const int result = RUN_ALL_TESTS();
+
+    int global_result;
+    MPI_Allreduce(&result, &global_result, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+
+    MPI_Finalize();
+    return global_result;
+}
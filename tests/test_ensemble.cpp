@@ -0,0 +1,134 @@
+#include "gtest/gtest.h"
+
+#include <vector>    //Access to std::vector
+#include <algorithm> //Access to std::ranges::fill and std::ranges::equal
+#include <span>      //Access to std::span
+#include <cmath>     //Access to std::cos
+#include <numbers>   //Access to std::numbers::pi
+#include <utility>   //Access to std::pair
+#include <stdexcept> //Access to std::invalid_argument
+
+#include <boost/numeric/odeint/stepper/stepper_categories.hpp>
+
+#include "stochastic/ensemble.hpp"
+#include "grid.hpp"
+
+using grid_type = llps::grid<double, 16, 32>;
+
+//Forward Euler for dx/dt = rate * x + forcing, forcing differing by member
+struct euler_stepper
+{
+    using time_type        = double;
+    using stepper_category = boost::numeric::odeint::stepper_tag;
+
+    void do_step(std::pair<double, double> system, grid_type& x, double, double dt)
+    {
+        for (double& value : x)
+            value += dt * (system.first * value + system.second);
+    }
+};
+
+TEST(ensemble_tests, test_ensemble_lockstep_matches_single_member)
+{
+    static constexpr size_t members = 3;
+
+    llps::stochastic::ensemble<euler_stepper, grid_type> ensemble(members);
+    for (size_t member = 0; member < members; ++member)
+        std::ranges::fill(ensemble[member], 1.);
+
+    std::vector<double> times;
+    const size_t steps = ensemble.integrate_const([](size_t member) { return std::pair{ -0.5, 0.1 * member }; }, 0., 1., 0.1,
+        [&](std::span<const grid_type> states, double t) {
+            ASSERT_EQ(states.size(), members);
+            times.push_back(t);
+        });
+
+    ASSERT_EQ(steps, 10);
+    ASSERT_EQ(times.size(), 11);
+    ASSERT_DOUBLE_EQ(times.back(), 1.);
+
+    for (size_t member = 0; member < members; ++member) {
+        grid_type expected;
+        std::ranges::fill(expected, 1.);
+
+        euler_stepper stepper;
+        for (size_t step = 0; step < steps; ++step)
+            stepper.do_step({ -0.5, 0.1 * member }, expected, 0., 0.1);
+
+        ASSERT_TRUE(std::ranges::equal(ensemble[member], expected)) << "member " << member;
+    }
+}
+
+TEST(ensemble_tests, test_statistics_moments)
+{
+    std::vector<grid_type> members(4);
+    for (size_t member = 0; member < members.size(); ++member)
+        std::ranges::fill(members[member], static_cast<double>(member));
+
+    llps::stochastic::ensemble_statistics<double, grid_type::rows(), grid_type::cols()> statistics;
+    statistics.sample(members, 2.);
+
+    ASSERT_EQ(statistics.samples(), 1);
+    ASSERT_EQ(statistics.times().front(), 2.);
+
+    //Of 0, 1, 2 and 3
+    for (double mean : statistics.mean())
+        ASSERT_DOUBLE_EQ(mean, 1.5);
+
+    for (double variance : statistics.variance())
+        ASSERT_DOUBLE_EQ(variance, 5. / 3.);
+
+    //A second sample replaces the first rather than adding to it
+    std::ranges::fill(members[3], 1.);
+    statistics.sample(members, 3.);
+
+    ASSERT_EQ(statistics.samples(), 2);
+    ASSERT_EQ(statistics.times().back(), 3.);
+
+    //Of 0, 1, 2 and 1
+    for (double mean : statistics.mean())
+        ASSERT_DOUBLE_EQ(mean, 1.);
+
+    for (double variance : statistics.variance())
+        ASSERT_DOUBLE_EQ(variance, 2. / 3.);
+}
+
+TEST(ensemble_tests, test_statistics_reject_empty_sample)
+{
+    llps::stochastic::ensemble_statistics<double, grid_type::rows(), grid_type::cols()> statistics;
+
+    ASSERT_THROW(statistics.sample(std::vector<grid_type>{}, 0.), std::invalid_argument);
+    ASSERT_EQ(statistics.samples(), 0);
+}
+
+TEST(ensemble_tests, test_statistics_structure_factor_of_single_mode)
+{
+    static constexpr size_t rows = grid_type::rows();
+    static constexpr size_t cols = grid_type::cols();
+
+    //Amplitudes 1 and 3 of cos(2 pi (3x / cols + 2y / rows)), so <|phi_k|^2> / N = (1 + 9) / 2 * N / 4 at +-k
+    std::vector<grid_type> members(2);
+    for (size_t member = 0; member < members.size(); ++member) {
+        const double amplitude = member == 0 ? 1. : 3.;
+
+        for (size_t row = 0; row < rows; ++row)
+            for (size_t col = 0; col < cols; ++col)
+                members[member](row, col) = amplitude * std::cos(2. * std::numbers::pi * (3. * col / cols + 2. * row / rows));
+    }
+
+    llps::stochastic::ensemble_statistics<double, rows, cols> statistics;
+
+    //Twice, as only the latest sample counts
+    statistics.sample(members, 0.);
+    statistics.sample(members, 1.);
+
+    const auto& structure_factor = statistics.structure_factor();
+    const double expected = 5. * rows * cols / 4.;
+
+    for (size_t row = 0; row < rows; ++row) {
+        for (size_t col = 0; col < cols / 2 + 1; ++col) {
+            const bool mode = row == 2 && col == 3;
+            ASSERT_NEAR(structure_factor(row, col), mode ? expected : 0., 1e-9 * expected) << row << ", " << col;
+        }
+    }
+}
@@ -0,0 +1,178 @@
+#include "gtest/gtest.h"
+
+#include <vector>     //Access to std::vector
+#include <complex>    //Access to std::complex
+#include <random>     //Access to std::mt19937_64 and std::uniform_real_distribution
+#include <numeric>    //Access to std::accumulate
+#include <functional> //Access to std::multiplies
+#include <numbers>    //Access to std::numbers::pi
+#include <cmath>      //Access to std::abs
+#include <algorithm>  //Access to std::max
+#include <cstddef>    //Access to size_t
+
+#include "fft/bundled_backend.hpp"
+
+using cplx = std::complex<double>;
+
+static size_t volume(const std::vector<size_t>& dims)
+{
+    return std::accumulate(dims.begin(), dims.end(), size_t(1), std::multiplies<>());
+}
+
+static std::vector<cplx> random_data(size_t size, bool real, unsigned seed)
+{
+    std::mt19937_64 engine(seed);
+    std::uniform_real_distribution<double> dist(-1., 1.);
+
+    std::vector<cplx> result(size);
+    for (cplx& value : result)
+        value = real ? cplx(dist(engine), 0.) : cplx(dist(engine), dist(engine));
+
+    return result;
+}
+
+/*
+* Direct O(n^2) multi-dimensional DFT of howmany contiguous row-major arrays,
+* with exponent sign * 2pi * i * (k . x / n).
+*/
+static std::vector<cplx> naive_dft(const std::vector<cplx>& in, const std::vector<size_t>& dims, size_t howmany, int sign)
+{
+    const size_t size = volume(dims);
+    std::vector<cplx> out(in.size());
+
+    for (size_t batch = 0; batch < howmany; ++batch) {
+        for (size_t k = 0; k < size; ++k) {
+            cplx sum = 0.;
+
+            for (size_t x = 0; x < size; ++x) {
+                //Phase of the pair of multi-indices, accumulated axis by axis (last axis fastest)
+                double phase = 0.;
+                size_t k_rest = k, x_rest = x;
+                for (size_t axis = dims.size(); axis-- > 0;) {
+                    phase += static_cast<double>((k_rest % dims[axis]) * (x_rest % dims[axis]) % dims[axis]) / dims[axis];
+                    k_rest /= dims[axis];
+                    x_rest /= dims[axis];
+                }
+
+                sum += in[batch * size + x] * std::polar(1., sign * 2. * std::numbers::pi * phase);
+            }
+
+            out[batch * size + k] = sum;
+        }
+    }
+
+    return out;
+}
+
+static double max_abs(const std::vector<cplx>& values)
+{
+    double result = 0.;
+    for (const cplx& value : values)
+        result = std::max(result, std::abs(value));
+
+    return result;
+}
+
+static void check_complex(const std::vector<size_t>& dims, size_t howmany = 1)
+{
+    const size_t size = howmany * volume(dims);
+    const std::vector<cplx> in = random_data(size, false, static_cast<unsigned>(size));
+
+    const llps::fft::bundled::complex_plan<double> plan(dims, howmany);
+
+    for (int sign : { -1, 1 }) {
+        std::vector<cplx> actual(size);
+
+        auto* in_data = reinterpret_cast<const llps::fft::complex<double>*>(in.data());
+        auto* out_data = reinterpret_cast<llps::fft::complex<double>*>(actual.data());
+        sign < 0 ? plan.forward(in_data, out_data) : plan.backward(in_data, out_data);
+
+        const std::vector<cplx> expected = naive_dft(in, dims, howmany, sign);
+        const double tolerance = 1e-12 * max_abs(expected);
+
+        for (size_t i = 0; i < size; ++i)
+            ASSERT_LT(std::abs(actual[i] - expected[i]), tolerance) << "Failed at: " << i << ", sign=" << sign;
+    }
+}
+
+static void check_real(const std::vector<size_t>& dims, size_t howmany = 1)
+{
+    const size_t size = volume(dims);
+    const size_t n = dims.back();
+    const size_t freq_cols = n / 2 + 1;
+    const size_t lines = howmany * size / n;
+
+    const std::vector<cplx> in = random_data(howmany * size, true, static_cast<unsigned>(size + howmany));
+
+    std::vector<double> real(howmany * size);
+    for (size_t i = 0; i < real.size(); ++i)
+        real[i] = in[i].real();
+
+    const llps::fft::bundled::real_plan<double> plan(dims, howmany);
+
+    //r2c: the first n/2 + 1 outputs of each line of the full transform
+    std::vector<cplx> half(lines * freq_cols);
+    plan.forward(real.data(), reinterpret_cast<llps::fft::complex<double>*>(half.data()));
+
+    const std::vector<cplx> expected = naive_dft(in, dims, howmany, -1);
+    const double tolerance = 1e-12 * max_abs(expected);
+
+    for (size_t line = 0; line < lines; ++line)
+        for (size_t col = 0; col < freq_cols; ++col)
+            ASSERT_LT(std::abs(half[line * freq_cols + col] - expected[line * n + col]), tolerance) << "Failed at: line=" << line << ", col=" << col;
+
+    //c2r: rebuilds the missing half of each line from the Hermitian symmetry, giving back size * in
+    std::vector<double> round_trip(howmany * size);
+    plan.backward(reinterpret_cast<llps::fft::complex<double>*>(half.data()), round_trip.data());
+
+    for (size_t i = 0; i < real.size(); ++i)
+        ASSERT_NEAR(round_trip[i], size * real[i], 1e-12 * size) << "Failed at: " << i;
+}
+
+TEST(fft_backend_tests, test_complex_radix2)
+{
+    for (size_t n : { 1, 2, 4, 8, 64, 256 })
+        check_complex({ n });
+}
+
+TEST(fft_backend_tests, test_complex_bluestein)
+{
+    //Odd, even non power of two, and prime lengths
+    for (size_t n : { 3, 9, 15, 6, 12, 100, 7, 13, 97, 101 })
+        check_complex({ n });
+}
+
+TEST(fft_backend_tests, test_complex_howmany)
+{
+    check_complex({ 8 }, 5);
+    check_complex({ 12 }, 3);
+    check_complex({ 6, 10 }, 2);
+}
+
+TEST(fft_backend_tests, test_complex3D)
+{
+    check_complex({ 3, 5, 8 });
+    check_complex({ 4, 7, 6 }, 2);
+}
+
+TEST(fft_backend_tests, test_real)
+{
+    //Even and odd last axes, whose Hermitian halves respectively have and lack a Nyquist column
+    check_real({ 16 });
+    check_real({ 15 });
+    check_real({ 7, 8 });
+    check_real({ 6, 9 });
+    check_real({ 13, 11 });
+}
+
+TEST(fft_backend_tests, test_real_howmany)
+{
+    check_real({ 10 }, 4);
+    check_real({ 5, 6 }, 3);
+}
+
+TEST(fft_backend_tests, test_real3D)
+{
+    check_real({ 3, 5, 8 });
+    check_real({ 4, 6, 7 }, 2);
+}
@@ -230,10 +230,14 @@ TYPED_TEST(fd_convergence_tests, test_convergence)
         max_abs_errs.push_back(max_abs_err);
     });
 
-    //Calculate machine imprecision point
+    //Calculate machine imprecision point, where the error stops falling at anything like the order
     size_t stop_index = 1;
     while (stop_index < samples) {
-        if (max_abs_errs[stop_index] >= max_abs_errs[stop_index - 1])
+        const value_type local_order =
+            std::log(max_abs_errs[stop_index - 1] / max_abs_errs[stop_index]) /
+            std::log(delta_xs[stop_index - 1] / delta_xs[stop_index]);
+
+        if (local_order < TestFixture::error_order / 2.)
             break;
         else
             ++stop_index;
@@ -246,4 +250,300 @@ TYPED_TEST(fd_convergence_tests, test_convergence)
         static_cast<double (*)(double)>(std::log));
 
     ASSERT_GE(fit.gradient, expected);
-}
\ No newline at end of file
+}
+TEST(finite_difference_tests, test_convergence3D)
+{
+    using value_type = double;
+    struct test_func
+    {
+        static value_type phi(value_type x, value_type y, value_type z)
+        {
+            return std::exp(std::cos(x) + std::sin(y) + std::cos(z));
+        }
+
+        static value_type dphi(value_type x, value_type y, value_type z)
+        {
+            return phi(x, y, z) * (
+                std::sin(x) * std::sin(x) - std::cos(x) +
+                std::cos(y) * std::cos(y) - std::sin(y) +
+                std::sin(z) * std::sin(z) - std::cos(z));
+        }
+    };
+
+    static constexpr size_t error_order = 4;
+    static constexpr value_type x_min = 0;
+    static constexpr value_type x_max = 2. * std::numbers::pi;
+
+    auto max_abs_err = [&]<size_t size>(llps::utilities::size_t_constant<size>)
+    {
+        static constexpr value_type dx = (x_max - x_min) / size;
+
+        using grid_t = llps::grid3D<value_type, size, size, size>;
+
+        grid_t phi, expected;
+        llps::apply_equi3D(phi, x_min, x_max, test_func::phi);
+        llps::apply_equi3D(expected, x_min, x_max, test_func::dphi);
+
+        grid_t actual = llps::calculus::laplacian_central_fd<error_order>(phi, dx, dx, dx);
+        return llps::utilities::max_abs_error(expected, actual);
+    };
+
+    const value_type coarse_err = max_abs_err(llps::utilities::size_t_constant<24>{});
+    const value_type fine_err   = max_abs_err(llps::utilities::size_t_constant<48>{});
+
+    //Halving the spacing should reduce the error by roughly 2^error_order
+    ASSERT_GE(std::log2(coarse_err / fine_err), error_order - 0.2);
+}
+
+TEST(finite_difference_tests, test_spectral3D)
+{
+    using value_type = double;
+
+    //Every side different, and odd along one of them
+    static constexpr size_t slices = 12;
+    static constexpr size_t rows = 15;
+    static constexpr size_t cols = 16;
+    static constexpr value_type dx = 2. * std::numbers::pi / cols;
+    static constexpr value_type dy = 4. * std::numbers::pi / rows;
+    static constexpr value_type dz = 2. * std::numbers::pi / slices;
+
+    using grid_t = llps::grid3D<value_type, slices, rows, cols>;
+
+    grid_t phi, expected, actual;
+    llps::apply_equi3D(phi, 0., 2. * std::numbers::pi, 0., 4. * std::numbers::pi, 0., 2. * std::numbers::pi, [](value_type x, value_type y, value_type z) {
+        return std::sin(2. * x) * std::cos(1.5 * y) * std::sin(z);
+    });
+    llps::apply_equi3D(expected, 0., 2. * std::numbers::pi, 0., 4. * std::numbers::pi, 0., 2. * std::numbers::pi, [](value_type x, value_type y, value_type z) {
+        return -7.25 * std::sin(2. * x) * std::cos(1.5 * y) * std::sin(z);
+    });
+
+    llps::calculus::laplacian_spectral(phi, actual, dx, dy, dz);
+    ASSERT_LT(llps::utilities::max_abs_error(expected, actual), 1e-10);
+}
+
+template<class Grid>
+concept takes_2D_laplacian = requires(const Grid& phi, Grid& dphi) {
+    llps::calculus::laplacian_central_fd<6>(phi, dphi, 1., 1.);
+};
+
+template<class Grid>
+concept takes_2D_divergence = requires(const Grid& fx, Grid& div) {
+    llps::calculus::divergence_central_fd<6>(fx, fx, div, 1., 1.);
+};
+
+//A 3D grid is also grid_like through its first slice, which 2D kernels must not settle for
+static_assert(takes_2D_laplacian<llps::grid<double, 8, 8>>);
+static_assert(!takes_2D_laplacian<llps::grid3D<double, 4, 8, 8>>);
+static_assert(takes_2D_divergence<llps::grid<double, 8, 8>>);
+static_assert(!takes_2D_divergence<llps::grid3D<double, 4, 8, 8>>);
+
+TEST(finite_difference_tests, test_laplacian_anisotropic)
+{
+    using value_type = double;
+
+    //Odd, non-square and with dy = 2dx * cols/rows: the y range is twice the x range
+    static constexpr size_t rows = 45;
+    static constexpr size_t cols = 128;
+    static constexpr value_type dx = 2. * std::numbers::pi / cols;
+    static constexpr value_type dy = 4. * std::numbers::pi / rows;
+
+    using grid_t = llps::grid<value_type, rows, cols>;
+
+    grid_t phi, expected;
+    llps::apply_equi2D(phi, 0., 2. * std::numbers::pi, 0., 4. * std::numbers::pi, [](value_type x, value_type y) {
+        return std::sin(3. * x) * std::cos(y / 2.);
+    });
+    llps::apply_equi2D(expected, 0., 2. * std::numbers::pi, 0., 4. * std::numbers::pi, [](value_type x, value_type y) {
+        return -9.25 * std::sin(3. * x) * std::cos(y / 2.);
+    });
+
+    const grid_t actual = llps::calculus::laplacian_central_fd<6>(phi, dx, dy);
+    ASSERT_LT(llps::utilities::max_abs_error(expected, actual), 1e-6);
+}
+
+TEST(finite_difference_tests, test_divergence_anisotropic)
+{
+    using value_type = double;
+
+    //Same grid as test_laplacian_anisotropic, where dy is over 5 times dx
+    static constexpr size_t rows = 45;
+    static constexpr size_t cols = 128;
+    static constexpr value_type dx = 2. * std::numbers::pi / cols;
+    static constexpr value_type dy = 4. * std::numbers::pi / rows;
+
+    using grid_t = llps::grid<value_type, rows, cols>;
+
+    grid_t fx, fy, expected;
+    llps::apply_equi2D(fx, 0., 2. * std::numbers::pi, 0., 4. * std::numbers::pi, [](value_type x, value_type y) {
+        return std::sin(3. * x) * std::cos(y / 2.);
+    });
+    llps::apply_equi2D(fy, 0., 2. * std::numbers::pi, 0., 4. * std::numbers::pi, [](value_type x, value_type y) {
+        return std::cos(x) * std::sin(y / 2.);
+    });
+    llps::apply_equi2D(expected, 0., 2. * std::numbers::pi, 0., 4. * std::numbers::pi, [](value_type x, value_type y) {
+        return 3. * std::cos(3. * x) * std::cos(y / 2.) + 0.5 * std::cos(x) * std::cos(y / 2.);
+    });
+
+    grid_t actual;
+
+    llps::calculus::divergence_central_fd<6>(fx, fy, actual, dx, dy);
+    ASSERT_LT(llps::utilities::max_abs_error(expected, actual), 1e-6);
+
+    //Second order is dominated by the x term, 27 dx^2 / 6
+    llps::calculus::divergence_central_fd<2>(fx, fy, actual, dx, dy);
+    ASSERT_LT(llps::utilities::max_abs_error(expected, actual), 2e-2);
+}
+
+TEST(finite_difference_tests, test_laplacian_narrow_grids)
+{
+    //Wrapping by indices modulo the size, as the stencil is defined
+    auto reference = []<size_t rows, size_t cols>(const llps::grid<double, rows, cols>& phi, double dx, double dy) {
+        static constexpr size_t error_order = 6;
+        static constexpr auto stencil = llps::calculus::central_fd_stencil<error_order>(2);
+
+        llps::grid<double, rows, cols> result;
+        for (size_t row = 0; row < rows; ++row) {
+            for (size_t col = 0; col < cols; ++col) {
+                double sum = 0.;
+                for (size_t i = 0; i <= error_order; ++i) {
+                    const size_t stencil_row = (row + 100 * rows + i - error_order / 2) % rows;
+                    const size_t stencil_col = (col + 100 * cols + i - error_order / 2) % cols;
+
+                    sum += (phi(row, stencil_col) / (dx * dx) + phi(stencil_row, col) / (dy * dy)) * stencil[i];
+                }
+                result(row, col) = sum;
+            }
+        }
+
+        return result;
+    };
+
+    auto check = [&]<size_t rows, size_t cols>(llps::grid<double, rows, cols> phi) {
+        for (size_t i = 0; i < phi.size(); ++i)
+            phi.data()[i] = std::sin(0.37 * i * i);
+
+        const auto expected = reference(phi, 0.5, 1.5);
+        const auto actual = llps::calculus::laplacian_central_fd<6>(phi, 0.5, 1.5);
+
+        ASSERT_LT(llps::utilities::max_abs_error(expected, actual), 1e-12) << rows << "x" << cols;
+    };
+
+    //Fewer rows than the stencil reaches, rows wider than a block of columns, and both odd
+    check(llps::grid<double, 2, 3000>{});
+    check(llps::grid<double, 67, 5>{});
+    check(llps::grid<double, 33, 1021>{});
+}
+
+TEST(finite_difference_tests, test_laplacian3D_narrow_grids)
+{
+    //Reaching 5 points either way, so that a 3 point axis is wrapped more than once
+    static constexpr size_t error_order = 10;
+
+    //Wrapping by indices modulo the size, as the stencil is defined
+    auto reference = []<size_t slices, size_t rows, size_t cols>(const llps::grid3D<double, slices, rows, cols>& phi, double dx, double dy, double dz) {
+        static constexpr auto stencil = llps::calculus::central_fd_stencil<error_order>(2);
+
+        llps::grid3D<double, slices, rows, cols> result;
+        for (size_t slice = 0; slice < slices; ++slice) {
+            for (size_t row = 0; row < rows; ++row) {
+                for (size_t col = 0; col < cols; ++col) {
+                    double sum = 0.;
+                    for (size_t i = 0; i <= error_order; ++i) {
+                        const size_t stencil_slice = (slice + 100 * slices + i - error_order / 2) % slices;
+                        const size_t stencil_row = (row + 100 * rows + i - error_order / 2) % rows;
+                        const size_t stencil_col = (col + 100 * cols + i - error_order / 2) % cols;
+
+                        sum += (
+                            phi(slice, row, stencil_col) / (dx * dx) +
+                            phi(slice, stencil_row, col) / (dy * dy) +
+                            phi(stencil_slice, row, col) / (dz * dz)) * stencil[i];
+                    }
+                    result(slice, row, col) = sum;
+                }
+            }
+        }
+
+        return result;
+    };
+
+    auto check = [&]<size_t slices, size_t rows, size_t cols>(llps::grid3D<double, slices, rows, cols> phi) {
+        for (size_t i = 0; i < phi.size(); ++i)
+            phi.data()[i] = std::sin(0.37 * i * i);
+
+        const auto expected = reference(phi, 0.5, 1.5, 0.75);
+        const auto actual = llps::calculus::laplacian_central_fd<error_order>(phi, 0.5, 1.5, 0.75);
+
+        ASSERT_LT(llps::utilities::max_abs_error(expected, actual), 1e-12) << slices << "x" << rows << "x" << cols;
+    };
+
+    //Fewer slices, rows or columns than the stencil reaches, and all of them at once
+    check(llps::grid3D<double, 3, 13, 40>{});
+    check(llps::grid3D<double, 13, 3, 40>{});
+    check(llps::grid3D<double, 13, 11, 3>{});
+    check(llps::grid3D<double, 1, 3, 7>{});
+}
+
+TEST(finite_difference_tests, test_apply_equi3D_minimum)
+{
+    llps::grid3D<double, 3, 4, 5> grid;
+    llps::apply_equi3D(grid, 1., 6., -2., 2., 10., 13., [](double x, double y, double z) {
+        return x + 100. * y + 10000. * z;
+    });
+
+    //Points start at the minimum of each axis, one spacing apart
+    for (size_t slice = 0; slice < 3; ++slice)
+        for (size_t row = 0; row < 4; ++row)
+            for (size_t col = 0; col < 5; ++col)
+                ASSERT_DOUBLE_EQ(grid(slice, row, col), (1. + col) + 100. * (-2. + row) + 10000. * (10. + slice)) << "Failed at: " << slice << ", " << row << ", " << col;
+}
+
+TEST(finite_difference_tests, test_apply_equi2D_minimum)
+{
+    llps::grid<double, 4, 5> grid;
+    llps::apply_equi2D(grid, 1., 6., -2., 2., [](double x, double y) {
+        return x + 100. * y;
+    });
+
+    //Points start at the minimum of each axis, one spacing apart
+    for (size_t row = 0; row < 4; ++row)
+        for (size_t col = 0; col < 5; ++col)
+            ASSERT_DOUBLE_EQ(grid(row, col), (1. + col) + 100. * (-2. + row)) << "Failed at: " << row << ", " << col;
+}
+
+TEST(finite_difference_tests, test_spectral_odd_sizes)
+{
+    using value_type = double;
+
+    static constexpr size_t rows = 45;
+    static constexpr size_t cols = 63;
+    static constexpr value_type dx = 2. * std::numbers::pi / cols;
+    static constexpr value_type dy = 2. * std::numbers::pi / rows;
+
+    using grid_t = llps::grid<value_type, rows, cols>;
+
+    grid_t phi, expected, actual;
+    llps::apply_equi2D(phi, 0., 2. * std::numbers::pi, [](value_type x, value_type y) {
+        return std::sin(2. * x) * std::cos(3. * y);
+    });
+    llps::apply_equi2D(expected, 0., 2. * std::numbers::pi, [](value_type x, value_type y) {
+        return -13. * std::sin(2. * x) * std::cos(3. * y);
+    });
+
+    llps::calculus::laplacian_spectral(phi, actual, dx, dy);
+    ASSERT_LT(llps::utilities::max_abs_error(expected, actual), 1e-10);
+
+    //Padding is exact for the square of a resolved field, here with no Nyquist row or column to drop
+    llps::calculus::spectral_operator<value_type, rows, cols> op(dx, dy, llps::calculus::dealiasing::padding);
+    op.forward_nonlinear(phi, [](value_type value) { return value * value; });
+
+    std::vector<value_type> padded(reinterpret_cast<const value_type*>(op.nonlinear_spectrum()), reinterpret_cast<const value_type*>(op.nonlinear_spectrum()) + 2 * op.tables().size);
+
+    grid_t square;
+    for (size_t i = 0; i < phi.size(); ++i)
+        square.data()[i] = phi.data()[i] * phi.data()[i];
+    op.forward(square);
+
+    const value_type* direct = reinterpret_cast<const value_type*>(op.spectrum());
+    for (size_t i = 0; i < padded.size(); ++i)
+        ASSERT_NEAR(padded[i], direct[i], 1e-9) << "Failed at: " << i;
+}
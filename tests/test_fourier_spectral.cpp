@@ -0,0 +1,244 @@
+#include "gtest/gtest.h"
+
+#include <cmath>   //Access to std::sin, std::cos, std::pow and std::hypot
+#include <cstdlib> //Access to std::abs
+#include <numbers> //Access to std::numbers::pi
+#include <utility> //Access to std::pair
+#include <cstdint> //Access to int64_t
+
+#include "calculus/fourier_spectral.hpp"
+#include "calculus/differentiate.hpp"
+#include "utilities/data_analytics.hpp"
+#include "grid.hpp"
+
+using namespace llps::calculus;
+
+//Odd rows, even columns, and unequal spacings over the (2pi)^2 square
+static constexpr size_t rows = 45;
+static constexpr size_t cols = 64;
+static constexpr double dx = 2. * std::numbers::pi / cols;
+static constexpr double dy = 2. * std::numbers::pi / rows;
+
+using grid_t = llps::grid<double, rows, cols>;
+using tables_t = spectral_tables<double, rows, cols>;
+
+//sin(2x)cos(3y), an eigenfunction of the laplacian with eigenvalue -13
+static grid_t make_mode(double scale = 1.)
+{
+    grid_t result;
+    llps::apply_equi2D(result, 0., 2. * std::numbers::pi, [=](double x, double y) {
+        return scale * std::sin(2. * x) * std::cos(3. * y);
+    });
+
+    return result;
+}
+
+TEST(fourier_spectral_tests, test_tables)
+{
+    const tables_t tables(dx, dy);
+    static constexpr double normalisation = 1. / (rows * cols);
+
+    ASSERT_EQ(tables.spacings()[0], dx);
+    ASSERT_EQ(tables.spacings()[1], dy);
+
+    //Row frequencies wrap around to negative values
+    for (auto [row, row_freq] : { std::pair{ 0, 0 }, std::pair{ 3, 3 }, std::pair{ 22, 22 }, std::pair{ 23, -22 }, std::pair{ 42, -3 } }) {
+        for (size_t col : { 0, 2, 21, 32 }) {
+            const size_t i = row * tables_t::freq_cols + col;
+            const double kappa_sq = static_cast<double>(col * col + row_freq * row_freq);
+
+            ASSERT_NEAR(tables.laplacian()[i], -kappa_sq * normalisation, 1e-12) << "Failed at: row=" << row << ", col=" << col;
+            ASSERT_NEAR(tables.biharmonic()[i], kappa_sq * kappa_sq * normalisation, 1e-9) << "Failed at: row=" << row << ", col=" << col;
+
+            const bool resolved = 3 * std::abs(row_freq) < static_cast<int>(rows) && 3 * col < cols;
+            ASSERT_EQ(tables.dealias_mask()[i], resolved ? 1. : 0.) << "Failed at: row=" << row << ", col=" << col;
+        }
+    }
+
+    //For cubic terms, the 1/2 rule
+    const tables_t cubic_tables(dx, dy, 3);
+    ASSERT_EQ(cubic_tables.degree(), 3);
+
+    for (auto [row, row_freq] : { std::pair{ 0, 0 }, std::pair{ 11, 11 }, std::pair{ 12, 12 }, std::pair{ 33, -12 }, std::pair{ 34, -11 } }) {
+        for (size_t col : { 0, 15, 16, 21 }) {
+            const size_t i = row * tables_t::freq_cols + col;
+
+            const bool resolved = 4 * std::abs(row_freq) < static_cast<int>(rows) && 4 * col < cols;
+            ASSERT_EQ(cubic_tables.dealias_mask()[i], resolved ? 1. : 0.) << "Failed at: row=" << row << ", col=" << col;
+        }
+    }
+}
+
+TEST(fourier_spectral_tests, test_operator)
+{
+    spectral_operator<double, rows, cols> op(dx, dy);
+
+    const grid_t phi = make_mode();
+    grid_t actual;
+
+    //Repeated use of the same operator must not be disturbed by the previous transforms
+    for (int repeat = 0; repeat < 2; ++repeat) {
+        op.laplacian(phi, actual);
+        ASSERT_LT(llps::utilities::max_abs_error(make_mode(-13.), actual), 1e-10);
+
+        op.biharmonic(phi, actual);
+        ASSERT_LT(llps::utilities::max_abs_error(make_mode(169.), actual), 1e-9);
+    }
+}
+
+TEST(fourier_spectral_tests, test_imex_step)
+{
+    static constexpr double a = -1.;
+    static constexpr double k = 0.5;
+
+    spectral_operator<double, rows, cols> op(dx, dy);
+
+    //With a linear chemical potential each mode is scaled by (1 + 13*dt*|a|)/(1 + 169*dt*k) per step
+    grid_t phi = make_mode();
+    double amplitude = 1.;
+
+    for (double dt : { 0.01, 0.01, 0.1, 1., 10. }) {
+        op.imex_step(phi, dt, k, [](double value) { return a * value; });
+        amplitude *= (1. - 13. * dt * a) / (1. + 169. * dt * k);
+
+        ASSERT_LT(llps::utilities::max_abs_error(make_mode(amplitude), phi), 1e-12) << "Failed at: dt=" << dt;
+    }
+}
+
+TEST(fourier_spectral_tests, test_laplacian_spacing_change)
+{
+    const grid_t phi = make_mode();
+    grid_t actual;
+
+    laplacian_spectral(phi, actual, dx, dy);
+    ASSERT_LT(llps::utilities::max_abs_error(make_mode(-13.), actual), 1e-10);
+
+    //Doubling the spacings must not reuse the tables of the previous call
+    laplacian_spectral(phi, actual, 2. * dx, 2. * dy);
+    ASSERT_LT(llps::utilities::max_abs_error(make_mode(-13. / 4.), actual), 1e-10);
+}
+
+//A resolved mode plus one above a third of the grid size in each direction
+static double unresolved_field(double x, double y)
+{
+    return std::sin(2. * x) * std::cos(3. * y) + 0.5 * std::cos(25. * x) * std::sin(17. * y);
+}
+
+TEST(fourier_spectral_tests, test_truncation)
+{
+    static constexpr auto cube = [](double value) { return value * value * value; };
+
+    grid_t phi, resolved_cube;
+    llps::apply_equi2D(phi, 0., 2. * std::numbers::pi, unresolved_field);
+    //The 2/3 rule drops the unresolved mode before the product, and the cube of what is left, of modes up to (6, 9), fits in the grid
+    llps::apply_equi2D(resolved_cube, 0., 2. * std::numbers::pi, [](double x, double y) {
+        return std::pow(std::sin(2. * x) * std::cos(3. * y), 3);
+    });
+
+    spectral_operator<double, rows, cols> aliased(dx, dy, dealiasing::none);
+    spectral_operator<double, rows, cols> truncated(dx, dy, dealiasing::truncation);
+
+    aliased.forward_nonlinear(phi, cube);
+    truncated.forward_nonlinear(phi, cube);
+
+    const double* aliased_hat = reinterpret_cast<const double*>(aliased.nonlinear_spectrum());
+    const double* truncated_hat = reinterpret_cast<const double*>(truncated.nonlinear_spectrum());
+    const auto& mask = truncated.tables().dealias_mask();
+
+    //Without dealiasing, the mode (75, 51) of the cube aliases onto (75 - 64, 51 - 45) = (11, 6), which is resolved
+    const size_t aliased_mode = 6 * tables_t::freq_cols + 11;
+    ASSERT_EQ(mask[aliased_mode], 1.);
+    ASSERT_GT(std::hypot(aliased_hat[2 * aliased_mode], aliased_hat[2 * aliased_mode + 1]), 1.);
+
+    for (size_t i = 0; i < tables_t::size; ++i) {
+        if (mask[i] == 0.) {
+            ASSERT_EQ(truncated_hat[2 * i], 0.) << "Failed at: " << i;
+            ASSERT_EQ(truncated_hat[2 * i + 1], 0.) << "Failed at: " << i;
+        }
+    }
+
+    truncated.forward(resolved_cube);
+    const double* expected = reinterpret_cast<const double*>(truncated.spectrum());
+
+    for (size_t i = 0; i < 2 * tables_t::size; ++i)
+        ASSERT_NEAR(truncated_hat[i], expected[i], 1e-10) << "Failed at: " << i;
+}
+
+TEST(fourier_spectral_tests, test_truncation_of_cubic_terms)
+{
+    static constexpr auto cube = [](double value) { return value * value * value; };
+
+    //cos(21x) is kept by the 2/3 rule at 64 columns, and its cube, (3 cos(21x) + cos(63x)) / 4, has a part which wraps onto cos(-x)
+    grid_t phi;
+    llps::apply_equi2D(phi, 0., 2. * std::numbers::pi, [](double x, double) {
+        return std::cos(21. * x);
+    });
+
+    spectral_operator<double, rows, cols> quadratic(dx, dy, dealiasing::truncation);
+    spectral_operator<double, rows, cols> cubic(dx, dy, dealiasing::truncation, 3);
+    spectral_operator<double, rows, cols> padded(dx, dy, dealiasing::padding);
+
+    for (auto* op : { &quadratic, &cubic, &padded })
+        op->forward_nonlinear(phi, cube);
+
+    //Unnormalised coefficient of cos of a single mode of unit amplitude, along row 0
+    static constexpr double unit = rows * cols / 2.;
+    static constexpr size_t kept = 21, wrapped = 1;
+
+    //The 2/3 rule leaves the wrapped quarter on the kept mode 1
+    ASSERT_EQ(quadratic.tables().dealias_mask()[kept], 1.);
+    ASSERT_EQ(quadratic.tables().dealias_mask()[wrapped], 1.);
+    ASSERT_NEAR(quadratic.nonlinear_spectrum()[wrapped][0], unit / 4., 1e-9);
+
+    //Which the 1/2 rule removes by dropping mode 21 before the product
+    ASSERT_EQ(cubic.tables().dealias_mask()[kept], 0.);
+    for (size_t i = 0; i < tables_t::size; ++i) {
+        ASSERT_NEAR(cubic.nonlinear_spectrum()[i][0], 0., 1e-9) << "Failed at: " << i;
+        ASSERT_NEAR(cubic.nonlinear_spectrum()[i][1], 0., 1e-9) << "Failed at: " << i;
+    }
+
+    //And padding keeps it, and only the resolved part of its cube
+    ASSERT_NEAR(padded.nonlinear_spectrum()[kept][0], 3. * unit / 4., 1e-9);
+    ASSERT_NEAR(padded.nonlinear_spectrum()[wrapped][0], 0., 1e-9);
+}
+
+TEST(fourier_spectral_tests, test_padding_exact)
+{
+    //Fine enough that the cube, with modes up to (75, 51), is sampled without aliasing
+    static constexpr size_t refinement = 4;
+    static constexpr size_t fine_rows = refinement * rows;
+    static constexpr size_t fine_cols = refinement * cols;
+    static constexpr size_t fine_freq_cols = fine_cols / 2 + 1;
+
+    grid_t phi;
+    llps::apply_equi2D(phi, 0., 2. * std::numbers::pi, unresolved_field);
+
+    llps::grid<double, fine_rows, fine_cols> fine_cube;
+    llps::apply_equi2D(fine_cube, 0., 2. * std::numbers::pi, [](double x, double y) {
+        return std::pow(unresolved_field(x, y), 3);
+    });
+
+    auto* fine_hat = llps::fft::allocate<llps::fft::complex<double>>(fine_rows * fine_freq_cols);
+    llps::fft::real_plan<double>({ fine_rows, fine_cols }).forward(fine_cube.data(), fine_hat);
+
+    spectral_operator<double, rows, cols> padded(dx, dy, dealiasing::padding);
+    padded.forward_nonlinear(phi, [](double value) { return value * value * value; });
+
+    //Coarse modes of the exact cube, rescaled to the coarse transform, with the dropped Nyquist column zeroed
+    static constexpr double scale = 1. / (refinement * refinement);
+    for (size_t row = 0; row < rows; ++row) {
+        const int64_t freq = freq_index(row, rows);
+        const size_t fine_row = freq < 0 ? fine_rows + freq : freq;
+
+        for (size_t col = 0; col < tables_t::freq_cols; ++col) {
+            const auto& actual = padded.nonlinear_spectrum()[row * tables_t::freq_cols + col];
+            const auto& expected = fine_hat[fine_row * fine_freq_cols + col];
+            const bool dropped = 2 * col == cols;
+
+            ASSERT_NEAR(actual[0], dropped ? 0. : expected[0] * scale, 1e-9) << "Failed at: row=" << row << ", col=" << col;
+            ASSERT_NEAR(actual[1], dropped ? 0. : expected[1] * scale, 1e-9) << "Failed at: row=" << row << ", col=" << col;
+        }
+    }
+
+    llps::fft::deallocate(fine_hat);
+}
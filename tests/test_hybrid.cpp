@@ -0,0 +1,118 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>  //Access to std::ranges::fill and std::ranges::equal
+#include <functional> //Access to std::ref and std::reference_wrapper
+#include <utility>    //Access to std::pair
+
+#include "calculus/hybrid.hpp"
+#include "grid.hpp"
+
+using grid_type = llps::grid<double, 8, 8>;
+
+/*
+* dphi/dt = -(phi + error) - stiffness * c s, with s the checkerboard and c
+* the projection of phi on it: a jacobian of spectral radius 1 + stiffness,
+* which leaves smooth fields alone, and an error standing in for a less
+* accurate discretisation.
+*/
+struct test_model
+{
+    double stiffness;
+    double error = 0.;
+
+    void operator()(const grid_type& phi, grid_type& dphi, double) const
+    {
+        double projection = 0.;
+        for (size_t row = 0; row < grid_type::rows(); ++row)
+            for (size_t col = 0; col < grid_type::cols(); ++col)
+                projection += _checkerboard(row, col) * phi(row, col) / grid_type::size();
+
+        for (size_t row = 0; row < grid_type::rows(); ++row)
+            for (size_t col = 0; col < grid_type::cols(); ++col)
+                dphi(row, col) = -(phi(row, col) + error) - stiffness * projection * _checkerboard(row, col);
+    }
+
+    static double _checkerboard(size_t row, size_t col) { return (row + col) % 2 == 0 ? 1. : -1.; }
+};
+
+using hybrid_type = llps::calculus::hybrid_rhs<grid_type, std::reference_wrapper<test_model>, test_model>;
+
+TEST(hybrid_tests, test_spectral_radius)
+{
+    grid_type phi0;
+    std::ranges::fill(phi0, 1.);
+
+    test_model finite_difference{ 2. };
+    hybrid_type model(std::ref(finite_difference), { 4999. }, phi0);
+
+    ASSERT_NEAR(model.spectral_radius(llps::calculus::hybrid_method::finite_difference), 3., 1e-5);
+    ASSERT_NEAR(model.spectral_radius(llps::calculus::hybrid_method::spectral), 5000., 5000. * 1e-5);
+}
+
+TEST(hybrid_tests, test_cheaper_while_accurate)
+{
+    grid_type phi, dphi, expected;
+    std::ranges::fill(phi, 1.);
+
+    //Far less stiff, so far cheaper per unit time, and within tolerance of the reference on a smooth field
+    test_model finite_difference{ 0., 1e-4 };
+    hybrid_type model(std::ref(finite_difference), { 1000. }, phi, 1e-3, 1.);
+    ASSERT_EQ(model.method(), llps::calculus::hybrid_method::finite_difference);
+
+    model.check(phi, 0.);
+    ASSERT_EQ(model.method(), llps::calculus::hybrid_method::finite_difference);
+    ASSERT_NEAR(model.difference(), 1e-4 / 1., 1e-12);
+    ASSERT_TRUE(model.switches().empty());
+
+    model(phi, dphi, 0.);
+    finite_difference(phi, expected, 0.);
+    ASSERT_TRUE(std::ranges::equal(dphi, expected));
+}
+
+TEST(hybrid_tests, test_switches_with_hysteresis)
+{
+    grid_type phi, dphi, expected;
+    std::ranges::fill(phi, 1.);
+
+    test_model finite_difference{ 0. };
+    hybrid_type model(std::ref(finite_difference), { 1000. }, phi, 1e-3, 1.);
+
+    //Evaluations alone, such as the stages of a rejected step, never change the model
+    finite_difference.error = 2e-3;
+    model(phi, dphi, 0.);
+    ASSERT_EQ(model.method(), llps::calculus::hybrid_method::finite_difference);
+
+    //Too inaccurate: the spectral model is used, and its result returned
+    model.check(phi, 0.);
+    ASSERT_EQ(model.method(), llps::calculus::hybrid_method::spectral);
+
+    model(phi, dphi, 0.);
+    test_model{ 1000. }(phi, expected, 0.);
+    ASSERT_TRUE(std::ranges::equal(dphi, expected));
+
+    //Not checked again within the check interval
+    finite_difference.error = 0.;
+    model.check(phi, 0.5);
+    ASSERT_EQ(model.method(), llps::calculus::hybrid_method::spectral);
+
+    //Back to finite differences only below half the tolerance, and away from them only above the tolerance
+    const std::pair<double, llps::calculus::hybrid_method> checks[] = {
+        { 8e-4, llps::calculus::hybrid_method::spectral },
+        { 4e-4, llps::calculus::hybrid_method::finite_difference },
+        { 8e-4, llps::calculus::hybrid_method::finite_difference },
+        { 2e-3, llps::calculus::hybrid_method::spectral },
+    };
+
+    double t = 1.;
+    for (auto [error, method] : checks) {
+        finite_difference.error = error;
+        model.check(phi, t);
+        ASSERT_EQ(model.method(), method) << "t=" << t;
+
+        t += 1.;
+    }
+
+    ASSERT_EQ(model.switches().size(), 3);
+    ASSERT_EQ(model.switches()[1].t, 2.);
+    ASSERT_EQ(model.switches()[1].method, llps::calculus::hybrid_method::finite_difference);
+}
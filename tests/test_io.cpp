@@ -0,0 +1,103 @@
+#include "gtest/gtest.h"
+
+#include <fstream>    //Access to std::ifstream
+#include <filesystem> //Access to std::filesystem::temp_directory_path
+#include <string>     //Access to std::string
+#include <vector>     //Access to std::vector
+#include <cstdint>    //Access to fixed size types
+#include <stdexcept>  //Access to std::runtime_error
+
+#include "utilities/io.hpp"
+#include "grid.hpp"
+
+namespace {
+
+    template<typename Type>
+    Type read_binary(std::ifstream& stream)
+    {
+        Type value;
+        stream.read(reinterpret_cast<char*>(&value), sizeof(Type));
+        return value;
+    }
+
+    std::string read_string(std::ifstream& stream)
+    {
+        std::string result(read_binary<uint64_t>(stream), '\0');
+        stream.read(result.data(), static_cast<std::streamsize>(result.size()));
+        return result;
+    }
+
+}
+
+TEST(io_tests, test_video_stream_round_trip)
+{
+    static constexpr size_t rows = 3;
+    static constexpr size_t cols = 4;
+
+    using grid_t = llps::grid<double, rows, cols>;
+
+    const std::string file_name = (std::filesystem::temp_directory_path() / "llps_test_video_stream.dat").string();
+    const std::vector<double> times = { 0.5, 1.25, 10. };
+
+    std::vector<grid_t> frames(times.size());
+    for (size_t frame = 0; frame < frames.size(); ++frame)
+        for (size_t i = 0; i < grid_t::size(); ++i)
+            frames[frame].data()[i] = static_cast<double>(frame) - static_cast<double>(i) / 4.;
+
+    {
+        llps::utilities::video_stream<double> video(file_name, cols, rows, { .title = "Round trip" }, { .sub_title = "frames", .dx = 0.5, .dy = 2. });
+        for (size_t frame = 0; frame < frames.size(); ++frame)
+            video.write(frames[frame], times[frame]);
+    }
+
+    std::ifstream file(file_name, std::ios::binary);
+    ASSERT_TRUE(file.is_open());
+
+    //Plot header
+    ASSERT_EQ(read_binary<uint64_t>(file), 1u);
+    ASSERT_EQ(read_string(file), "Round trip");
+    for (int label = 0; label < 4; ++label)
+        read_string(file);
+
+    //Meta data, patched on close: extremes over every frame
+    ASSERT_EQ(read_binary<size_t>(file), 2u);
+
+    ASSERT_EQ(read_string(file), "vmin");
+    ASSERT_EQ(read_binary<uint8_t>(file), sizeof(double));
+    ASSERT_EQ(read_binary<double>(file), -11. / 4.);
+
+    ASSERT_EQ(read_string(file), "vmax");
+    ASSERT_EQ(read_binary<uint8_t>(file), sizeof(double));
+    ASSERT_EQ(read_binary<double>(file), 2.);
+
+    //Video header, with the frame count patched on close
+    ASSERT_EQ(read_binary<uint8_t>(file), sizeof(double));
+    ASSERT_EQ(read_binary<uint8_t>(file), sizeof(double));
+    ASSERT_EQ(read_string(file), "frames");
+    ASSERT_EQ(read_binary<double>(file), 0.5);
+    ASSERT_EQ(read_binary<double>(file), 2.);
+    ASSERT_EQ(read_binary<uint64_t>(file), rows);
+    ASSERT_EQ(read_binary<uint64_t>(file), cols);
+    read_binary<uint32_t>(file);
+    ASSERT_EQ(read_binary<uint64_t>(file), frames.size());
+
+    for (size_t frame = 0; frame < frames.size(); ++frame)
+        for (size_t i = 0; i < grid_t::size(); ++i)
+            ASSERT_EQ(read_binary<double>(file), frames[frame].data()[i]) << "Failed at: frame=" << frame << ", i=" << i;
+
+    //Sample times trail the frames
+    for (double t : times)
+        ASSERT_EQ(read_binary<double>(file), t);
+
+    file.peek();
+    ASSERT_TRUE(file.eof());
+
+    file.close();
+    std::filesystem::remove(file_name);
+}
+
+TEST(io_tests, test_video_stream_open_failure)
+{
+    const auto file_name = std::filesystem::temp_directory_path() / "llps_missing_directory" / "video.dat";
+    ASSERT_THROW((llps::utilities::video_stream<double>(file_name.string(), 4, 3)), std::runtime_error);
+}
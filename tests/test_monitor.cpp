@@ -0,0 +1,181 @@
+#include "gtest/gtest.h"
+
+#include <cmath>     //Access to std::cos, std::sin, std::exp, std::pow and std::abs
+#include <numbers>   //Access to std::numbers::pi
+#include <algorithm> //Access to std::ranges::fill
+
+#include "_modelb_common.hpp"
+#include "calculus/differentiate.hpp"
+#include "utilities/monitor.hpp"
+#include "grid.hpp"
+
+using grid_type = llps::grid<double, 32, 16>;
+using monitor_type = llps::utilities::conservation_monitor<double, grid_type::rows(), grid_type::cols()>;
+using model_type = modelb<2, grid_type>;
+
+TEST(monitor_tests, test_energy_of_uniform_field)
+{
+    grid_type phi, mu;
+    std::ranges::fill(phi, 0.5);
+
+    //No gradient term, so mu = a phi + b phi^3, and dx dy = 0.5 * 2
+    std::ranges::fill(mu, -0.5 + 0.125);
+
+    monitor_type monitor(1., 1e-10, 1e-6, llps::utilities::monitor_policy::log, 0.5, 2.);
+    monitor.sample(phi, mu, 0.);
+
+    ASSERT_DOUBLE_EQ(monitor.masses().front(), 0.5 * grid_type::size());
+    ASSERT_DOUBLE_EQ(monitor.energies().front(), (-0.5 * 0.25 + 0.25 * 0.0625) * grid_type::size());
+}
+
+TEST(monitor_tests, test_gradient_energy_of_single_mode)
+{
+    static constexpr size_t rows = grid_type::rows();
+    static constexpr size_t cols = grid_type::cols();
+
+    //cos(2 pi 3x / cols), on which the second order laplacian has eigenvalue -4 sin^2(pi 3 / cols)
+    grid_type phi;
+    for (size_t row = 0; row < rows; ++row)
+        for (size_t col = 0; col < cols; ++col)
+            phi(row, col) = std::cos(2. * std::numbers::pi * 3. * col / cols);
+
+    const double eigenvalue = 4. * std::pow(std::sin(std::numbers::pi * 3. / cols), 2);
+
+    model_type model(0., 0., 2.);
+    monitor_type monitor(0.);
+    monitor.sample(phi, model.chemical_potential(phi), 0.);
+
+    ASSERT_NEAR(monitor.masses().front(), 0., 1e-12);
+    ASSERT_NEAR(monitor.energies().front(), eigenvalue * rows * cols / 2., 1e-10);
+}
+
+TEST(monitor_tests, test_energy_matches_gradient_form)
+{
+    static constexpr size_t order = 6;
+    static constexpr double a = -1., b = 1., k = 0.7;
+    static constexpr double dx = 2. * std::numbers::pi / grid_type::cols();
+    static constexpr double dy = 2. * std::numbers::pi / grid_type::rows();
+
+    grid_type phi;
+    llps::apply_equi2D(phi, 0., 2. * std::numbers::pi, [](double x, double y) {
+        return std::exp(std::cos(x) + std::sin(y)) - 1.5;
+    });
+
+    //F summed by parts directly, from a laplacian of its own
+    const grid_type laplacian = llps::calculus::laplacian_central_fd<order>(phi, dx, dy);
+
+    double expected = 0.;
+    for (size_t i = 0; i < grid_type::size(); ++i) {
+        const double phi_i = phi.data()[i];
+        expected += a / 2 * phi_i * phi_i + b / 4 * std::pow(phi_i, 4) - k / 2 * phi_i * laplacian.data()[i];
+    }
+    expected *= dx * dy;
+
+    modelb<order, grid_type> model(a, b, k, {}, dx, dy);
+    monitor_type monitor(b, 1e-10, 1e-6, llps::utilities::monitor_policy::log, dx, dy);
+    monitor.sample(phi, model.chemical_potential(phi), 0.);
+
+    ASSERT_NEAR(monitor.energies().front(), expected, 1e-12 * std::abs(expected));
+}
+
+TEST(monitor_tests, test_policies)
+{
+    grid_type phi;
+    std::ranges::fill(phi, 0.);
+
+    model_type model(-1., 1., 1.);
+    monitor_type logged(1., 1e-10, 1e-6, llps::utilities::monitor_policy::log);
+    monitor_type flagged(1., 1e-10, 1e-6, llps::utilities::monitor_policy::flag);
+    monitor_type aborted(1., 1e-10, 1e-6, llps::utilities::monitor_policy::abort);
+
+    for (monitor_type* monitor : { &logged, &flagged, &aborted })
+        monitor->sample(phi, model.chemical_potential(phi), 0.);
+
+    //Mass is added, which the first sample fixes
+    phi(3, 4) = 1e-6;
+
+    logged.sample(phi, model.chemical_potential(phi), 1.);
+    flagged.sample(phi, model.chemical_potential(phi), 1.);
+    ASSERT_THROW(aborted.sample(phi, model.chemical_potential(phi), 1.), llps::utilities::monitor_error);
+
+    for (monitor_type* monitor : { &logged, &flagged, &aborted }) {
+        ASSERT_EQ(monitor->samples(), 2);
+        ASSERT_EQ(monitor->violations().size(), 1);
+        ASSERT_EQ(monitor->violations().front(), 1.);
+        ASSERT_DOUBLE_EQ(monitor->mass_drift(), 1e-6);
+    }
+
+    ASSERT_FALSE(logged.flagged());
+    ASSERT_TRUE(flagged.flagged());
+}
+
+//A checkerboard of +-0.5, which has mass 0 and mostly gradient energy
+static void fill_checkerboard(grid_type& phi)
+{
+    for (size_t row = 0; row < grid_type::rows(); ++row)
+        for (size_t col = 0; col < grid_type::cols(); ++col)
+            phi(row, col) = (row + col) % 2 == 0 ? 0.5 : -0.5;
+}
+
+TEST(monitor_tests, test_mass_tolerance_scales_with_field)
+{
+    grid_type phi;
+    model_type model(-1., 1., 1.);
+
+    //A drift of 1e-9 is rounding on a field of 100, whose int |phi| is 51200
+    std::ranges::fill(phi, 100.);
+
+    monitor_type large(1., 1e-10, 1e-6, llps::utilities::monitor_policy::flag);
+    large.sample(phi, model.chemical_potential(phi), 0.);
+
+    phi(3, 4) += 1e-9;
+    large.sample(phi, model.chemical_potential(phi), 1.);
+    ASSERT_FALSE(large.flagged());
+
+    //A mixture of mean zero is still held to its int |phi| of 256, rather than to |M| = 0 or to a fixed tolerance
+    fill_checkerboard(phi);
+
+    monitor_type balanced(1., 1e-10, 1e-6, llps::utilities::monitor_policy::flag);
+    balanced.sample(phi, model.chemical_potential(phi), 0.);
+
+    phi(3, 4) += 1e-9;
+    balanced.sample(phi, model.chemical_potential(phi), 1.);
+    ASSERT_FALSE(balanced.flagged());
+
+    phi(3, 4) += 1e-7;
+    balanced.sample(phi, model.chemical_potential(phi), 2.);
+    ASSERT_TRUE(balanced.flagged());
+}
+
+TEST(monitor_tests, test_energy_rise_fails)
+{
+    grid_type phi;
+    fill_checkerboard(phi);
+
+    model_type model(-1., 1., 1.);
+    monitor_type monitor(1., 1e-10, 1e-6, llps::utilities::monitor_policy::abort, 1., 1., 1.);
+    monitor(phi, 0., model);
+
+    //Same mass and a lower energy passes, within the sample interval it is not even sampled
+    std::ranges::fill(phi, 0.);
+    monitor(phi, 0.5, model);
+    ASSERT_EQ(monitor.samples(), 1);
+
+    monitor(phi, 1., model);
+    ASSERT_EQ(monitor.samples(), 2);
+    ASSERT_LT(monitor.energies().back(), monitor.energies().front());
+    ASSERT_FALSE(monitor.flagged());
+
+    //Same mass and a higher energy fails
+    fill_checkerboard(phi);
+
+    try {
+        monitor(phi, 2., model);
+        FAIL() << "Expected monitor_error";
+    }
+    catch (const llps::utilities::monitor_error& error) {
+        ASSERT_EQ(error.t(), 2.);
+    }
+
+    ASSERT_TRUE(monitor.flagged());
+}
@@ -0,0 +1,333 @@
+#include "gtest/gtest.h"
+
+#include <vector>    //Access to std::vector
+#include <algorithm> //Access to std::ranges::equal, std::equal and std::max
+#include <cmath>     //Access to std::sqrt, std::log, std::sin, std::cos, std::ldexp and std::nextafter
+#include <random>    //Access to std::mt19937_64
+#include <limits>    //Access to std::numeric_limits
+#include <numbers>   //Access to std::numbers::pi_v and sqrt2
+#include <cstdint>   //Access to uint32_t and uint64_t
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif // _OPENMP
+
+#include "utilities/random.hpp"
+#include "grid.hpp"
+
+TEST(random_tests, test_philox4x32_known_answers)
+{
+    //Known answer vectors from the Random123 distribution (kat_vectors, philox4x32_10)
+    using llps::utilities::philox4x32;
+
+    EXPECT_EQ(philox4x32::generate({ 0, 0, 0, 0 }, { 0, 0 }),
+        (philox4x32::counter_type{ 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 }));
+
+    EXPECT_EQ(philox4x32::generate({ 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff }, { 0xffffffff, 0xffffffff }),
+        (philox4x32::counter_type{ 0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd }));
+
+    EXPECT_EQ(philox4x32::generate({ 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344 }, { 0xa4093822, 0x299f31d0 }),
+        (philox4x32::counter_type{ 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 }));
+}
+
+TEST(random_tests, test_xoshiro128plus_known_answers)
+{
+    //Outputs 0 to 3 and 996 to 999 from state { 1, 2, 3, 4 }, as the authors' reference implementation gives them
+    uint32_t s0 = 1, s1 = 2, s2 = 3, s3 = 4;
+
+    std::vector<uint32_t> outputs(1000);
+    for (uint32_t& output : outputs)
+        output = llps::utilities::xoshiro128plus::next(s0, s1, s2, s3);
+
+    EXPECT_EQ(outputs[0], 0x00000005u);
+    EXPECT_EQ(outputs[1], 0x00003007u);
+    EXPECT_EQ(outputs[2], 0x01803007u);
+    EXPECT_EQ(outputs[3], 0x01a05c0eu);
+
+    EXPECT_EQ(outputs[996], 0xbbe6a62cu);
+    EXPECT_EQ(outputs[997], 0x664f5db9u);
+    EXPECT_EQ(outputs[998], 0x442d3daau);
+    EXPECT_EQ(outputs[999], 0xf7fe4da8u);
+}
+
+#ifdef _OPENMP
+TEST(random_tests, test_fill_normal_thread_count_independent)
+{
+    llps::grid<double, 256, 250> serial, parallel;
+
+    const int threads = omp_get_max_threads();
+
+    omp_set_num_threads(1);
+    llps::utilities::fill_normal(serial, { 69 });
+
+    //An odd team size, so block boundaries fall differently
+    omp_set_num_threads(3);
+    llps::utilities::fill_normal(parallel, { 69 });
+
+    omp_set_num_threads(threads);
+
+    ASSERT_TRUE(std::ranges::equal(serial, parallel));
+}
+#endif // _OPENMP
+
+TEST(random_tests, test_fill_normal_offset_matches_whole)
+{
+    std::vector<double> whole(1001);
+    llps::utilities::fill_normal(whole, { 42, 3 });
+
+    //Odd offsets start half way through a Box-Muller pair
+    for (size_t offset : { 0, 1, 127, 128, 500 }) {
+        std::vector<double> part(whole.size() - offset);
+        llps::utilities::fill_normal(part, { 42, 3 }, 0., 1., offset);
+
+        ASSERT_TRUE(std::ranges::equal(part, std::vector<double>(whole.begin() + offset, whole.end()))) << "offset " << offset;
+    }
+}
+
+TEST(random_tests, test_fill_normal_moments_and_substreams)
+{
+    static constexpr size_t size = 1 << 20;
+
+    std::vector<double> member0(size), member1(size);
+    llps::utilities::fill_normal(member0, { 69, 0 }, 0.5, 2.);
+    llps::utilities::fill_normal(member1, { 69, 1 }, 0.5, 2.);
+
+    double mean = 0, square = 0, cross = 0;
+    for (size_t i = 0; i < size; ++i) {
+        mean += member0[i];
+        square += member0[i] * member0[i];
+        cross += (member0[i] - 0.5) * (member1[i] - 0.5);
+    }
+    mean /= size;
+    const double variance = square / size - mean * mean;
+
+    //Several standard errors of margin
+    EXPECT_NEAR(mean, 0.5, 5 * 2. / std::sqrt(size));
+    EXPECT_NEAR(variance, 4., 5 * 4. * std::sqrt(2. / size));
+
+    //Substreams are uncorrelated
+    EXPECT_NEAR(cross / size, 0., 5 * 4. / std::sqrt(size));
+}
+
+TEST(random_tests, test_fill_normal_pairs_moments_and_rows)
+{
+    static constexpr size_t rows = 512;
+    static constexpr size_t cols = 1000;
+    static constexpr double size = rows * cols;
+
+    std::vector<double> x(cols), y(cols), other(cols), unused(cols);
+
+    double mean_x = 0, mean_y = 0, square_x = 0, square_y = 0, cross = 0, cross_rows = 0;
+    for (size_t row = 0; row < rows; ++row) {
+        llps::utilities::fill_normal_pairs(x.data(), y.data(), cols, { 69, 0 }, row);
+
+        //The row of the same index in another substream
+        llps::utilities::fill_normal_pairs(other.data(), unused.data(), cols, { 69, 1 }, row);
+
+        for (size_t col = 0; col < cols; ++col) {
+            mean_x += x[col];
+            mean_y += y[col];
+            square_x += x[col] * x[col];
+            square_y += y[col] * y[col];
+            cross += x[col] * y[col];
+            cross_rows += x[col] * other[col];
+        }
+    }
+
+    //Several standard errors of margin
+    EXPECT_NEAR(mean_x / size, 0., 5. / std::sqrt(size));
+    EXPECT_NEAR(mean_y / size, 0., 5. / std::sqrt(size));
+    EXPECT_NEAR(square_x / size, 1., 5. * std::sqrt(2. / size));
+    EXPECT_NEAR(square_y / size, 1., 5. * std::sqrt(2. / size));
+
+    //The two normals of a pair, and substreams, are uncorrelated
+    EXPECT_NEAR(cross / size, 0., 5. / std::sqrt(size));
+    EXPECT_NEAR(cross_rows / size, 0., 5. / std::sqrt(size));
+
+    //Neighbouring rows are not shifted copies of each other
+    std::vector<double> next(cols);
+    llps::utilities::fill_normal_pairs(next.data(), unused.data(), cols, { 69, 0 }, rows);
+    llps::utilities::fill_normal_pairs(x.data(), y.data(), cols, { 69, 0 }, rows - 1);
+
+    for (size_t shift = 0; shift <= 2 * llps::utilities::_normal_lanes; ++shift)
+        ASSERT_FALSE(std::equal(next.begin() + shift, next.end(), x.begin())) << "shift " << shift;
+}
+
+TEST(random_tests, test_fill_normal_pairs_prefix_of_longer_row)
+{
+    std::vector<float> x(1001), y(1001);
+    llps::utilities::fill_normal_pairs(x.data(), y.data(), x.size(), { 42, 3 }, 7);
+
+    //Counts which end mid block, on a block and inside the first block
+    for (size_t count : { 1, 5, 8, 13, 64, 1000 }) {
+        std::vector<float> x_part(count), y_part(count);
+        llps::utilities::fill_normal_pairs(x_part.data(), y_part.data(), count, { 42, 3 }, 7);
+
+        ASSERT_TRUE(std::equal(x_part.begin(), x_part.end(), x.begin())) << "count " << count;
+        ASSERT_TRUE(std::equal(y_part.begin(), y_part.end(), y.begin())) << "count " << count;
+    }
+
+    //The precision of the output only rounds the same single precision normals
+    std::vector<double> x_double(1001), y_double(1001);
+    llps::utilities::fill_normal_pairs(x_double.data(), y_double.data(), x_double.size(), { 42, 3 }, 7);
+
+    for (size_t i = 0; i < x.size(); ++i) {
+        ASSERT_EQ(static_cast<float>(x_double[i]), x[i]) << "Failed at: " << i;
+        ASSERT_EQ(static_cast<float>(y_double[i]), y[i]) << "Failed at: " << i;
+    }
+}
+
+TEST(random_tests, test_uniform_open_float_range)
+{
+    using llps::utilities::_uniform_open;
+
+    //31 bits: the smallest gives 2^-32 and the largest rounds to 1, both ends finite radii
+    EXPECT_EQ(_uniform_open(uint32_t(0)), 0x1p-32f);
+    EXPECT_EQ(_uniform_open(uint32_t(0x7fffffff)), 1.f);
+    EXPECT_GT(_uniform_open(uint32_t(1) << 23), 0.f);
+    EXPECT_LT(_uniform_open(uint32_t(1) << 23), 1.f);
+}
+
+//Distance from expected to actual, in units of the spacing of Type at expected
+template<class Type>
+static double ulp_error(Type actual, long double expected)
+{
+    const Type rounded = static_cast<Type>(expected);
+    const Type ulp = std::nextafter(std::abs(rounded), std::numeric_limits<Type>::infinity()) - std::abs(rounded);
+
+    return static_cast<double>(std::abs(actual - expected) / ulp);
+}
+
+TEST(random_tests, test_log_positive_ulp)
+{
+    std::mt19937_64 engine(12);
+
+    double max_error = 0.;
+    auto check = [&](double u) {
+        max_error = std::max(max_error, ulp_error(llps::utilities::_log_positive(u), std::log(static_cast<long double>(u))));
+    };
+
+    //Every binade of the normal doubles, with random mantissas
+    for (int exponent = std::numeric_limits<double>::min_exponent - 1; exponent < std::numeric_limits<double>::max_exponent; ++exponent)
+        for (int sample = 0; sample < 64; ++sample)
+            check(std::ldexp(1. + static_cast<double>(engine() >> 12) * 0x1p-52, exponent));
+
+    //Edges: the smallest and largest normals, and either side of 1 and of the sqrt(2) split
+    for (double u : { std::numeric_limits<double>::min(), std::numeric_limits<double>::max(), 1., std::numbers::sqrt2, 0.5 * std::numbers::sqrt2 }) {
+        double below = u, above = u;
+        for (int step = 0; step < 16; ++step) {
+            check(below);
+            check(above);
+            below = std::nextafter(below, 0.);
+            above = std::nextafter(above, std::numeric_limits<double>::infinity());
+        }
+    }
+
+    EXPECT_LE(max_error, 2.) << "Worst case of " << max_error << " ulp";
+}
+
+TEST(random_tests, test_sincos_turns_ulp)
+{
+    static constexpr uint64_t range = uint64_t(1) << 52;
+    static constexpr long double two_pi = 2.l * std::numbers::pi_v<long double>;
+
+    std::mt19937_64 engine(13);
+
+    double max_error = 0.;
+    auto check = [&](uint64_t k) {
+        double sin, cos;
+        llps::utilities::_sincos_turns(k, sin, cos);
+
+        //Reference reduced exactly to the nearest quarter turn, as 2pi (k + 1/2) / 2^52 can not be rounded near the zeros
+        const uint64_t quadrant = (k + range / 8) / (range / 4);
+        const int64_t remainder = 2 * (static_cast<int64_t>(k) - static_cast<int64_t>(quadrant * (range / 4))) + 1;
+
+        const long double x = two_pi * static_cast<long double>(remainder) * 0x1p-53l;
+        const long double sin_x = std::sin(x), cos_x = std::cos(x);
+
+        //Rotation by the quarter turns
+        const long double expected_sin[4] = { sin_x, cos_x, -sin_x, -cos_x };
+        const long double expected_cos[4] = { cos_x, -sin_x, -cos_x, sin_x };
+
+        max_error = std::max({ max_error, ulp_error(sin, expected_sin[quadrant % 4]), ulp_error(cos, expected_cos[quadrant % 4]) });
+    };
+
+    for (int sample = 0; sample < (1 << 16); ++sample)
+        check(engine() >> 12);
+
+    //Both ends of the range, and either side of every quarter turn where the reduction switches quadrant
+    for (uint64_t quadrant = 0; quadrant <= 4; ++quadrant) {
+        for (uint64_t offset = 0; offset < 16; ++offset) {
+            const uint64_t boundary = quadrant * (range / 4) + (range / 8);
+
+            if (quadrant * (range / 4) + offset < range)
+                check(quadrant * (range / 4) + offset);
+            if (quadrant * (range / 4) >= offset + 1)
+                check(quadrant * (range / 4) - offset - 1);
+            if (boundary + offset < range)
+                check(boundary + offset);
+            if (boundary >= offset + 1 && boundary - offset - 1 < range)
+                check(boundary - offset - 1);
+        }
+    }
+
+    EXPECT_LE(max_error, 3.) << "Worst case of " << max_error << " ulp";
+}
+
+TEST(random_tests, test_log_positive_float_ulp)
+{
+    std::mt19937_64 engine(14);
+
+    double max_error = 0.;
+    auto check = [&](float u) {
+        max_error = std::max(max_error, ulp_error(llps::utilities::_log_positive(u), std::log(static_cast<long double>(u))));
+    };
+
+    //Every binade of the normal floats, with random mantissas
+    for (int exponent = std::numeric_limits<float>::min_exponent - 1; exponent < std::numeric_limits<float>::max_exponent; ++exponent)
+        for (int sample = 0; sample < 1024; ++sample)
+            check(std::ldexp(1.f + static_cast<float>(engine() >> 41) * 0x1p-23f, exponent));
+
+    //Edges: the smallest and largest normals, and either side of 1 and of the sqrt(2) split
+    for (float u : { std::numeric_limits<float>::min(), std::numeric_limits<float>::max(), 1.f, std::numbers::sqrt2_v<float>, 0.5f * std::numbers::sqrt2_v<float> }) {
+        float below = u, above = u;
+        for (int step = 0; step < 16; ++step) {
+            check(below);
+            check(above);
+            below = std::nextafter(below, 0.f);
+            above = std::nextafter(above, std::numeric_limits<float>::infinity());
+        }
+    }
+
+    EXPECT_LE(max_error, 3.) << "Worst case of " << max_error << " ulp";
+}
+
+TEST(random_tests, test_sincos_turns_float_ulp)
+{
+    static constexpr uint32_t range = uint32_t(1) << 25;
+    static constexpr long double two_pi = 2.l * std::numbers::pi_v<long double>;
+
+    double max_error = 0.;
+    auto check = [&](uint32_t k) {
+        float sin, cos;
+        llps::utilities::_sincos_turns(k, sin, cos);
+
+        //Reference reduced exactly to the nearest quarter turn, as in the double precision test
+        const uint32_t quadrant = (k + range / 8) / (range / 4);
+        const int64_t remainder = 2 * (static_cast<int64_t>(k) - static_cast<int64_t>(quadrant) * (range / 4)) + 1;
+
+        const long double x = two_pi * static_cast<long double>(remainder) * 0x1p-26l;
+        const long double sin_x = std::sin(x), cos_x = std::cos(x);
+
+        const long double expected_sin[4] = { sin_x, cos_x, -sin_x, -cos_x };
+        const long double expected_cos[4] = { cos_x, -sin_x, -cos_x, sin_x };
+
+        max_error = std::max({ max_error, ulp_error(sin, expected_sin[quadrant % 4]), ulp_error(cos, expected_cos[quadrant % 4]) });
+    };
+
+    //Few enough inputs to try every one
+    for (uint32_t k = 0; k < range; ++k)
+        check(k);
+
+    EXPECT_LE(max_error, 3.) << "Worst case of " << max_error << " ulp";
+}
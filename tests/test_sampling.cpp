@@ -0,0 +1,60 @@
+#include "gtest/gtest.h"
+
+#include <array>     //Access to std::array
+#include <vector>    //Access to std::vector
+#include <cmath>     //Access to std::sqrt
+#include <algorithm> //Access to std::ranges::fill
+
+#include "utilities/sampling.hpp"
+
+TEST(sampling_tests, test_log_time_sampler)
+{
+    //1, 10, 100 and 1000
+    llps::utilities::log_time_sampler sampler(1., 1000., 4);
+
+    std::vector<double> sampled;
+    for (double t = 0.; t <= 1000.; t += 0.5)
+        if (sampler(t))
+            sampled.push_back(t);
+
+    ASSERT_EQ(sampled, (std::vector<double>{ 1., 10., 100., 1000. }));
+    ASSERT_EQ(sampler.remaining(), 0);
+}
+
+TEST(sampling_tests, test_log_time_sampler_skips_passed_times)
+{
+    llps::utilities::log_time_sampler sampler(1., 1000., 4);
+
+    //A single step past 10 and 100 samples once
+    ASSERT_TRUE(sampler(1.5));
+    ASSERT_TRUE(sampler(150.));
+    ASSERT_EQ(sampler.remaining(), 1);
+
+    ASSERT_FALSE(sampler(999.));
+    ASSERT_TRUE(sampler(1001.));
+    ASSERT_FALSE(sampler(2000.));
+}
+
+TEST(sampling_tests, test_change_sampler)
+{
+    std::array<std::vector<double>, 2> phi{ std::vector<double>(50, 1.), std::vector<double>(50, 1.) };
+
+    llps::utilities::change_sampler<double> sampler(0.1, 0.5, 10.);
+
+    //Always the first
+    ASSERT_TRUE(sampler(phi, 0.));
+
+    //5% of the norm of both fields
+    std::ranges::fill(phi[1], 1. + 0.1 * std::sqrt(2.) / 2.);
+    ASSERT_FALSE(sampler(phi, 1.));
+    ASSERT_NEAR(sampler.last_change(), 0.05, 1e-12);
+
+    //15%, but within min_interval of the last sample
+    std::ranges::fill(phi[1], 1. + 0.3 * std::sqrt(2.) / 2.);
+    ASSERT_FALSE(sampler(phi, 0.25));
+    ASSERT_TRUE(sampler(phi, 2.));
+
+    //No change, until max_interval has passed
+    ASSERT_FALSE(sampler(phi, 11.));
+    ASSERT_TRUE(sampler(phi, 12.));
+}
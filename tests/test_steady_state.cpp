@@ -0,0 +1,87 @@
+#include "gtest/gtest.h"
+
+#include <vector>    //Access to std::vector
+#include <cmath>     //Access to std::exp and std::isnan
+#include <algorithm> //Access to std::ranges::fill
+
+#include <boost/numeric/odeint.hpp>
+
+#include "utilities/steady_state.hpp"
+#include "integrate.hpp"
+
+TEST(steady_state_tests, test_hysteresis)
+{
+    llps::utilities::steady_state_detector<double> detector(1e-3, 1e-2, 3);
+    ASSERT_TRUE(std::isnan(detector.stationary_since()));
+
+    //Two samples below are not enough, and one above the enter tolerance starts the count again
+    ASSERT_FALSE(detector.update(1e-4, 0.));
+    ASSERT_FALSE(detector.update(1e-4, 1.));
+    ASSERT_FALSE(detector.update(5e-3, 2.));
+    ASSERT_FALSE(detector.update(1e-4, 3.));
+    ASSERT_FALSE(detector.update(1e-4, 4.));
+    ASSERT_TRUE(detector.update(1e-4, 5.));
+    ASSERT_EQ(detector.stationary_since(), 5.);
+
+    //Between the two tolerances stays stationary, only above the exit tolerance leaves
+    ASSERT_TRUE(detector.update(5e-3, 6.));
+    ASSERT_FALSE(detector.update(2e-2, 7.));
+    ASSERT_FALSE(detector.update(1e-4, 8.));
+
+    ASSERT_EQ(detector.samples(), 9);
+}
+
+TEST(steady_state_tests, test_rate_from_states)
+{
+    //phi = 2t at every point has dphi/dt = 2 everywhere
+    std::vector<double> phi(100);
+
+    llps::utilities::steady_state_detector<double> detector(1e-3, 1e-2, 1, 0.5);
+    for (double t : { 0., 0.25, 0.5, 1.5 }) {
+        std::ranges::fill(phi, 2. * t);
+        detector(phi, t);
+    }
+
+    //The first call only keeps the state, and 0.25 falls within the sample interval
+    ASSERT_EQ(detector.samples(), 2);
+    ASSERT_DOUBLE_EQ(detector.rates()[0], 2.);
+    ASSERT_DOUBLE_EQ(detector.rates()[1], 2.);
+    ASSERT_EQ(detector.times()[1], 1.5);
+}
+
+TEST(steady_state_tests, test_integrate_until_stationary)
+{
+    using namespace boost::numeric;
+
+    using state_type = std::vector<double>;
+    using stepper_type = odeint::runge_kutta_cash_karp54<state_type>;
+
+    //dx/dt = -x, whose rate |x| falls below 1e-3 at t = ln(1000) = 6.9
+    auto system = [](const state_type& x, state_type& dxdt, double) { dxdt[0] = -x[0]; };
+    auto stepper = odeint::make_controlled<stepper_type>(1e-10, 1e-8);
+
+    llps::utilities::steady_state_detector<double> detector(1e-3, 1e-2, 1);
+    state_type x{ 1. };
+
+    double last_t = 0.;
+    const size_t steps = llps::integrate_adaptive_until(stepper, system, x, 0., 100., 0.1,
+        [&](const state_type& x, double t) {
+            detector.update(std::abs(x[0]), t);
+            last_t = t;
+        },
+        [&](const state_type&, double) { return detector.stationary(); });
+
+    ASSERT_GT(steps, 0);
+    ASSERT_GT(last_t, std::log(1000.));
+    ASSERT_LT(last_t, 10.);
+    ASSERT_NEAR(x[0], std::exp(-last_t), 1e-7);
+
+    //Without stopping it lands exactly on t_end
+    x = { 1. };
+    llps::integrate_adaptive_until(stepper, system, x, 0., 3., 0.7,
+        [&](const state_type&, double t) { last_t = t; },
+        [](const state_type&, double) { return false; });
+
+    ASSERT_DOUBLE_EQ(last_t, 3.);
+    ASSERT_NEAR(x[0], std::exp(-3.), 1e-7);
+}
@@ -0,0 +1,232 @@
+#include "gtest/gtest.h"
+
+#include <cmath>     //Access to std::sin and std::cos
+#include <numbers>   //Access to std::numbers::pi
+#include <utility>   //Access to std::pair
+#include <algorithm> //Access to std::ranges::equal, fill and all_of
+
+#include "calculus/stencil.hpp"
+#include "calculus/differentiate.hpp"
+#include "utilities/data_analytics.hpp"
+#include "utilities/meta.hpp"
+#include "grid.hpp"
+
+using namespace llps::calculus;
+
+static constexpr size_t rows = 48;
+static constexpr size_t cols = 64;
+static constexpr double dx = 2. * std::numbers::pi / cols;
+static constexpr double dy = 2. * std::numbers::pi / rows;
+
+using grid_t = llps::grid<double, rows, cols>;
+
+template<class Func>
+grid_t sampled(Func func)
+{
+    grid_t grid;
+    llps::apply_equi2D(grid, 0., 2. * std::numbers::pi, func);
+
+    return grid;
+}
+
+template<class Grid>
+concept takes_stencil = requires(const Grid& phi, Grid& dphi) {
+    make_stencil_operator<2>(D_xx + D_yy, 1., 1.)(phi, dphi);
+};
+
+//Only the first slice of a 3D grid would be read, so it is rejected instead
+static_assert(takes_stencil<grid_t>);
+static_assert(!takes_stencil<llps::grid3D<double, 4, rows, cols>>);
+
+TEST(stencil_tests, test_merged_points)
+{
+    //The centres of D_xx and D_yy coincide
+    using laplacian_t = decltype(make_stencil_operator<2>(D_xx + D_yy, 1., 1.));
+    ASSERT_EQ(laplacian_t::points, 5);
+    ASSERT_EQ(decltype(make_stencil_operator<6>(D_xx + D_yy, 1., 1.))::points, 13);
+
+    //D_xy adds the four corners, and has no weight in the centre row or column
+    ASSERT_EQ(decltype(make_stencil_operator<2>(D_xx + D_yy + D_xy, 1., 1.))::points, 9);
+
+    //Weights merge into one coefficient per point
+    const auto op = make_stencil_operator<2>(2. * D_xx + D_xx, 0.5, 1.);
+    ASSERT_EQ(op.points, 3);
+    for (size_t point = 0; point < op.points; ++point)
+        ASSERT_DOUBLE_EQ(op.coefficient(point), 3. * (op.col_offset(point) == 0 ? -2. : 1.) / 0.25);
+}
+
+TEST(stencil_tests, test_laplacian_matches_kernel)
+{
+    const grid_t phi = sampled([](double x, double y) { return std::exp(std::cos(x) + std::sin(y)); });
+
+    grid_t expected, actual;
+    laplacian_central_fd<6>(phi, expected, dx, dy);
+    make_stencil_operator<6>(D_xx + D_yy, dx, dy)(phi, actual);
+
+    ASSERT_LT(llps::utilities::max_abs_error(expected, actual), 1e-10);
+}
+
+TEST(stencil_tests, test_tiles)
+{
+    const grid_t phi = sampled([](double x, double y) { return std::exp(std::cos(x) + std::sin(y)); });
+
+    grid_t expected_kernel, expected_stencil, actual;
+    laplacian_central_fd<6>(phi, expected_kernel, dx, dy);
+    make_stencil_operator<6>(D_xx + D_yy, dx, dy)(phi, expected_stencil);
+
+    //Tiles only change the order points are visited in, even those not dividing the grid or wider than it
+    for (const fd2D_tile tile : { fd2D_tile{ 1, 1 }, fd2D_tile{ 5, 7 }, fd2D_tile{ 0, 16 }, fd2D_tile{ 8, 0 }, fd2D_tile{ 2 * rows, 2 * cols } }) {
+        laplacian_central_fd<6>(phi, actual, dx, dy, tile);
+        ASSERT_TRUE(std::ranges::equal(expected_kernel, actual)) << "Failed at: tile=" << tile.rows << "x" << tile.cols;
+
+        make_stencil_operator<6>(D_xx + D_yy, dx, dy, tile)(phi, actual);
+        ASSERT_TRUE(std::ranges::equal(expected_stencil, actual)) << "Failed at: tile=" << tile.rows << "x" << tile.cols;
+    }
+}
+
+TEST(stencil_tests, test_operators)
+{
+    const grid_t phi = sampled([](double x, double y) { return std::sin(2. * x) * std::cos(3. * y); });
+    grid_t actual;
+
+    //Anisotropic: (-4a - 9b) phi
+    make_stencil_operator<8>(0.5 * D_xx + 2. * D_yy, dx, dy)(phi, actual);
+    ASSERT_LT(llps::utilities::max_abs_error(sampled([](double x, double y) { return -20. * std::sin(2. * x) * std::cos(3. * y); }), actual), 1e-5);
+
+    //Direct biharmonic: (4 + 9)^2 phi
+    make_stencil_operator<8>(D_xxxx + 2 * D_xxyy + D_yyyy, dx, dy)(phi, actual);
+    ASSERT_LT(llps::utilities::max_abs_error(sampled([](double x, double y) { return 169. * std::sin(2. * x) * std::cos(3. * y); }), actual), 1e-3);
+
+    //Mixed and first derivatives, and subtraction
+    make_stencil_operator<8>(D_xy - D_x, dx, dy)(phi, actual);
+    ASSERT_LT(llps::utilities::max_abs_error(sampled([](double x, double y) {
+        return -6. * std::cos(2. * x) * std::sin(3. * y) - 2. * std::cos(2. * x) * std::cos(3. * y);
+    }), actual), 1e-5);
+}
+
+TEST(stencil_tests, test_narrow_grid)
+{
+    //Fewer rows and columns than the biharmonic reaches still wrap periodically
+    llps::grid<double, 3, 5> phi, actual;
+    for (size_t row = 0; row < 3; ++row)
+        for (size_t col = 0; col < 5; ++col)
+            phi(row, col) = std::cos(2. * std::numbers::pi * col / 5.);
+
+    make_stencil_operator<2>(D_xxxx + D_yyyy, 1., 1.)(phi, actual);
+
+    //Symbol of the 5 point fourth difference, (2 - 2 cos(theta))^2
+    const double symbol = std::pow(2. - 2. * std::cos(2. * std::numbers::pi / 5.), 2);
+    for (size_t row = 0; row < 3; ++row)
+        for (size_t col = 0; col < 5; ++col)
+            ASSERT_NEAR(actual(row, col), symbol * phi(row, col), 1e-12);
+}
+
+TEST(stencil_tests, test_compact_laplacians_order)
+{
+    const auto phi = [](double x, double y) { return std::exp(std::cos(x) + std::sin(y)); };
+    const auto expected = [&](double x, double y) { return phi(x, y) * (std::cos(y) * std::cos(y) + std::sin(x) * std::sin(x) - std::sin(y) - std::cos(x)); };
+
+    //Max absolute errors at 32 and 64 points per side, halving dx and dy
+    auto errors = [&]<size_t n>(llps::utilities::size_t_constant<n>) {
+        using square_t = llps::grid<double, n, n>;
+        static constexpr double h = 2. * std::numbers::pi / n;
+
+        square_t sampled_phi, sampled_expected, actual;
+        llps::apply_equi2D(sampled_phi, 0., 2. * std::numbers::pi, phi);
+        llps::apply_equi2D(sampled_expected, 0., 2. * std::numbers::pi, expected);
+
+        laplacian_isotropic(sampled_phi, actual, h, h);
+        const double isotropic = llps::utilities::max_abs_error(sampled_expected, actual);
+
+        laplacian_mehrstellen(sampled_phi, actual, h, h);
+        const double mehrstellen = llps::utilities::max_abs_error(sampled_expected, actual);
+
+        return std::pair{ isotropic, mehrstellen };
+    };
+
+    const auto [isotropic_coarse, mehrstellen_coarse] = errors(llps::utilities::size_t_constant<32>{});
+    const auto [isotropic_fine, mehrstellen_fine] = errors(llps::utilities::size_t_constant<64>{});
+
+    ASSERT_NEAR(std::log2(isotropic_coarse / isotropic_fine), 2., 0.1);
+    ASSERT_NEAR(std::log2(mehrstellen_coarse / mehrstellen_fine), 4., 0.2);
+}
+
+TEST(stencil_tests, test_isotropy)
+{
+    //Modes (5, 0) and (3, 4) have the same wavenumber, so the same exact laplacian -25 phi
+    using square_t = llps::grid<double, 64, 64>;
+    static constexpr double h = 2. * std::numbers::pi / 64;
+
+    auto relative_error = [](auto& laplacian, double kx, double ky) {
+        square_t phi, actual;
+        llps::apply_equi2D(phi, 0., 2. * std::numbers::pi, [=](double x, double y) { return std::cos(kx * x + ky * y); });
+        laplacian(phi, actual);
+
+        return std::abs(actual(0, 0) / phi(0, 0) + 25.) / 25.;
+    };
+
+    const auto axes = make_stencil_operator<2>(D_xx + D_yy, h, h);
+    const auto isotropic = make_isotropic_laplacian(h, h);
+    mehrstellen_laplacian<square_t> mehrstellen(h, h);
+
+    //The 5 point error differs by direction to leading order, 5^4 / (3^4 + 4^4) = 1.85 times larger along an axis
+    ASSERT_GT(std::abs(relative_error(axes, 5., 0.) / relative_error(axes, 3., 4.) - 1.), 0.4);
+
+    //The compact ones are isotropic to leading order
+    ASSERT_LT(std::abs(relative_error(isotropic, 5., 0.) / relative_error(isotropic, 3., 4.) - 1.), 0.05);
+    ASSERT_LT(relative_error(mehrstellen, 5., 0.), relative_error(isotropic, 5., 0.) / 10.);
+}
+
+TEST(stencil_tests, test_epilogue)
+{
+    const grid_t phi = sampled([](double x, double y) { return std::sin(2. * x) * std::cos(3. * y); });
+
+    grid_t expected, actual;
+    llps::grid<int, rows, cols> visits;
+    std::ranges::fill(visits, 0);
+
+    const auto laplacian = make_stencil_operator<4>(D_xx + D_yy, dx, dy, { 5, 24 });
+    laplacian(phi, expected);
+
+    //Every segment once, after it is written
+    bool written = true;
+    laplacian(phi, actual, [&](size_t row, size_t col_begin, size_t col_end) {
+        for (size_t col = col_begin; col < col_end; ++col) {
+            written = written && actual(row, col) == expected(row, col);
+            ++visits(row, col);
+            actual(row, col) *= 2.;
+        }
+    });
+
+    ASSERT_TRUE(written);
+    ASSERT_TRUE(std::ranges::all_of(visits, [](int count) { return count == 1; }));
+
+    for (size_t i = 0; i < grid_t::size(); ++i)
+        ASSERT_EQ(actual.data()[i], 2. * expected.data()[i]) << "Failed at: " << i;
+}
+
+TEST(stencil_tests, test_mehrstellen_scratch)
+{
+    const grid_t phi = sampled([](double x, double y) { return std::exp(std::cos(x) + std::sin(y)); });
+    const grid_t other = sampled([](double x, double y) { return std::sin(2. * x) * std::cos(3. * y); });
+
+    mehrstellen_laplacian<grid_t> mehrstellen(dx, dy);
+
+    //The two passes, by hand
+    grid_t isotropic, expected, actual;
+    make_isotropic_laplacian(dx, dy)(phi, isotropic);
+    make_stencil_operator<2>(partial<0, 0>{} - dx * dx / 12. * D_xx - dy * dy / 12. * D_yy, dx, dy)(isotropic, expected);
+
+    //The scratch left by a call on another field has no effect on the next
+    mehrstellen(other, actual);
+    mehrstellen(phi, actual);
+    ASSERT_TRUE(std::ranges::equal(expected, actual));
+
+    laplacian_mehrstellen(phi, actual, dx, dy);
+    ASSERT_TRUE(std::ranges::equal(expected, actual));
+
+    //Doubling the spacings must not reuse the operator of the previous call
+    laplacian_mehrstellen(phi, actual, 2. * dx, 2. * dy);
+    mehrstellen_laplacian<grid_t>(2. * dx, 2. * dy)(phi, expected);
+    ASSERT_TRUE(std::ranges::equal(expected, actual));
+}
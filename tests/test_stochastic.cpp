@@ -0,0 +1,173 @@
+#include "gtest/gtest.h"
+
+#include <vector>    //Access to std::vector
+#include <cmath>     //Access to std::sqrt and std::log2
+#include <random>    //Access to std::mt19937_64 and std::normal_distribution
+#include <algorithm> //Access to std::ranges::equal and std::ranges::fill
+#include <utility>   //Access to std::pair
+#include <cstddef>   //Access to size_t
+
+#include "stochastic/conserved_noise.hpp"
+#include "stochastic/stochastic_heun.hpp"
+#include "calculus/finite_difference.hpp"
+#include "grid.hpp"
+
+TEST(stochastic_tests, test_conserved_noise_moments)
+{
+    static constexpr size_t rows = 128;
+    static constexpr size_t cols = 96;
+    static constexpr double dx = 0.5;
+    static constexpr double dy = 0.8;
+    static constexpr double temperature = 0.05;
+    static constexpr double dt = 0.01;
+    static constexpr size_t steps = 4;
+
+    using grid_t = llps::grid<double, rows, cols>;
+
+    llps::stochastic::conserved_noise<6, grid_t> noise(temperature, dx, dy, { 7 });
+    llps::stochastic::conserved_noise<6, grid_t> replay(temperature, dx, dy, { 7 });
+    llps::stochastic::conserved_noise<6, grid_t> other(temperature, dx, dy, { 7, 1 });
+
+    //Each component of xi has variance 2 T dt / (dx dy), and enters the divergence through the stencil
+    double stencil_square = 0.;
+    for (double weight : llps::calculus::central_fd_stencil<6, double>(1))
+        stencil_square += weight * weight;
+
+    const double xi_variance = 2. * temperature * dt / (dx * dy);
+    const double expected_variance = xi_variance * stencil_square * (1. / (dx * dx) + 1. / (dy * dy));
+
+    double variance = 0.;
+    grid_t increment, replayed, independent;
+    for (size_t step = 0; step < steps; ++step) {
+        noise(increment, 0., dt);
+        replay(replayed, 0., dt);
+        other(independent, 0., dt);
+
+        double sum = 0., square = 0.;
+        for (double value : increment) {
+            sum += value;
+            square += value * value;
+        }
+
+        //A divergence of a periodic field, so the increment moves mass without creating any
+        ASSERT_NEAR(sum, 0., 1e-10 * std::sqrt(expected_variance * grid_t::size())) << "Failed at step: " << step;
+        variance += square / grid_t::size() / steps;
+
+        ASSERT_TRUE(std::ranges::equal(increment, replayed)) << "Failed at step: " << step;
+        ASSERT_FALSE(std::ranges::equal(increment, independent)) << "Failed at step: " << step;
+    }
+
+    ASSERT_EQ(noise.steps(), steps);
+
+    //Neighbouring increments share draws, so leave a margin of several standard errors of the independent case
+    EXPECT_NEAR(variance, expected_variance, 0.05 * expected_variance);
+}
+
+namespace {
+
+    //Each point holds an independent path
+    using path_grid_t = llps::grid<double, 16, 32>;
+
+    static constexpr double theta = 1.;
+    static constexpr double sigma = 0.5;
+
+    //dx = -theta x dt + sigma dW
+    void ornstein_uhlenbeck(const path_grid_t& x, path_grid_t& dxdt, double)
+    {
+        for (size_t i = 0; i < x.size(); ++i)
+            dxdt.data()[i] = -theta * x.data()[i];
+    }
+
+    //Brownian increments over steps of ratio fine steps, so every step size sees the same paths
+    struct brownian_path
+    {
+        const std::vector<path_grid_t>* fine;
+        size_t ratio;
+        size_t step = 0;
+
+        void operator()(path_grid_t& dW, double, double)
+        {
+            std::ranges::fill(dW, 0.);
+            for (size_t i = 0; i < ratio; ++i, ++step)
+                for (size_t point = 0; point < dW.size(); ++point)
+                    dW.data()[point] += (*fine)[step].data()[point];
+        }
+    };
+
+    //x(1) on every path, integrated with steps of ratio fine steps
+    path_grid_t integrate(const std::vector<path_grid_t>& fine, size_t ratio)
+    {
+        const size_t steps = fine.size() / ratio;
+        const double dt = 1. / static_cast<double>(steps);
+
+        llps::stochastic::stochastic_heun<path_grid_t> stepper;
+        auto system = std::make_pair(&ornstein_uhlenbeck, brownian_path{ &fine, ratio });
+
+        path_grid_t x;
+        std::ranges::fill(x, 1.);
+
+        for (size_t step = 0; step < steps; ++step)
+            stepper.do_step(system, x, step * dt, dt);
+
+        return x;
+    }
+
+    double rms_difference(const path_grid_t& lhs, const path_grid_t& rhs)
+    {
+        double square = 0.;
+        for (size_t i = 0; i < lhs.size(); ++i)
+            square += (lhs.data()[i] - rhs.data()[i]) * (lhs.data()[i] - rhs.data()[i]);
+
+        return std::sqrt(square / lhs.size());
+    }
+
+    std::vector<path_grid_t> brownian_increments(size_t steps, double amplitude)
+    {
+        std::vector<path_grid_t> result(steps);
+        if (amplitude == 0.)
+            return result;
+
+        std::mt19937_64 engine(21);
+        std::normal_distribution<double> normal(0., amplitude / std::sqrt(static_cast<double>(steps)));
+
+        for (path_grid_t& increment : result)
+            for (double& value : increment)
+                value = normal(engine);
+
+        return result;
+    }
+
+    //Slopes of log2(error) against log2(dt), between consecutive halvings of dt, against a run 8 times finer than the finest
+    std::vector<double> convergence_orders(double amplitude)
+    {
+        static constexpr size_t fine_steps = 1 << 10;
+        const std::vector<path_grid_t> fine = brownian_increments(fine_steps, amplitude);
+
+        const path_grid_t reference = integrate(fine, 1);
+
+        std::vector<double> errors;
+        for (size_t ratio : { 64, 32, 16, 8 })
+            errors.push_back(rms_difference(integrate(fine, ratio), reference));
+
+        std::vector<double> orders;
+        for (size_t i = 1; i < errors.size(); ++i)
+            orders.push_back(std::log2(errors[i - 1] / errors[i]));
+
+        return orders;
+    }
+
+}
+
+TEST(stochastic_tests, test_heun_strong_order_ornstein_uhlenbeck)
+{
+    //Additive noise: strong order 1
+    for (double order : convergence_orders(sigma))
+        EXPECT_NEAR(order, 1., 0.25);
+}
+
+TEST(stochastic_tests, test_heun_deterministic_order)
+{
+    //Without noise Heun is the explicit trapezoidal rule, of second order
+    for (double order : convergence_orders(0.))
+        EXPECT_NEAR(order, 2., 0.25);
+}
@@ -0,0 +1,81 @@
+#include "gtest/gtest.h"
+
+#include <vector>  //Access to std::vector
+#include <cmath>   //Access to std::cos and std::sqrt
+#include <numbers> //Access to std::numbers::pi
+
+#include "utilities/structure_factor.hpp"
+#include "grid.hpp"
+
+static constexpr size_t rows = 64;
+static constexpr size_t cols = 64;
+
+using grid_type = llps::grid<double, rows, cols>;
+
+TEST(structure_factor_tests, test_shells_cover_the_disc)
+{
+    llps::utilities::radial_structure_factor<double, rows, cols> analysis;
+
+    //Shells of width 2 pi / 64 up to the Nyquist wavenumber pi
+    ASSERT_EQ(analysis.bins(), cols / 2 + 1);
+    ASSERT_EQ(analysis.wavenumbers().front(), 0.);
+
+    const double bin_width = 2. * std::numbers::pi / cols;
+    for (size_t bin = 1; bin < analysis.bins(); ++bin)
+        EXPECT_NEAR(analysis.wavenumbers()[bin], bin * bin_width, 0.5 * bin_width) << "bin " << bin;
+}
+
+TEST(structure_factor_tests, test_single_mode)
+{
+    //cos(k.r) with k = 2 pi (3, 4) / 64, |k| = 5 fundamentals: |phi_k|^2 / N = N / 4 at +-k, and nothing elsewhere
+    grid_type phi;
+    for (size_t row = 0; row < rows; ++row)
+        for (size_t col = 0; col < cols; ++col)
+            phi(row, col) = std::cos(2. * std::numbers::pi * (3. * col + 4. * row) / cols);
+
+    llps::utilities::radial_structure_factor<double, rows, cols> analysis;
+    analysis.sample(phi, 0.);
+
+    ASSERT_EQ(analysis.samples(), 1);
+
+    const std::vector<double>& values = analysis.values().front();
+
+    //Everything in shell 5
+    double total = 0.;
+    for (double value : values)
+        total += value;
+
+    EXPECT_GT(values[5], 0.);
+    EXPECT_NEAR(values[5], total, 1e-12 * total);
+
+    //All of the power at |k|, and so L = 2 pi / |k|
+    const double k = 2. * std::numbers::pi * 5. / cols;
+    EXPECT_NEAR(analysis.lengths().front(), 2. * std::numbers::pi / analysis.wavenumbers()[5], 1e-12);
+    EXPECT_NEAR(analysis.wavenumbers()[5], k, 0.5 * 2. * std::numbers::pi / cols);
+}
+
+TEST(structure_factor_tests, test_observer_interval_and_ensemble_average)
+{
+    grid_type small, large;
+    for (size_t row = 0; row < rows; ++row) {
+        for (size_t col = 0; col < cols; ++col) {
+            small(row, col) = std::cos(2. * std::numbers::pi * 2. * col / cols);
+            large(row, col) = 3. * small(row, col);
+        }
+    }
+
+    llps::utilities::radial_structure_factor<double, rows, cols> analysis(1., 1., 10.);
+
+    //Only t = 0, 10 and 20 are sampled
+    for (double t = 0.; t <= 25.; t += 2.5)
+        analysis(std::vector<grid_type>{ small, large }, t);
+
+    ASSERT_EQ(analysis.samples(), 3);
+    EXPECT_DOUBLE_EQ(analysis.times()[1], 10.);
+
+    //Mean of the two members' S, 1 and 9 times that of small
+    llps::utilities::radial_structure_factor<double, rows, cols> single;
+    single.sample(small, 0.);
+
+    EXPECT_NEAR(analysis.values().front()[2], 5. * single.values().front()[2], 1e-12 * single.values().front()[2]);
+}
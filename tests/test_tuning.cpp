@@ -0,0 +1,89 @@
+#include "gtest/gtest.h"
+
+#include <string>     //Access to std::string
+#include <cstdio>     //Access to std::remove
+#include <cmath>      //Access to std::pow
+#include <numbers>    //Access to std::numbers::pi
+#include <stdexcept>  //Access to std::invalid_argument
+
+#include "tuning.hpp"
+
+TEST(tuning_tests, test_dispatch_fd_order)
+{
+    size_t dispatched = 0;
+    llps::dispatch_fd_order(8, [&]<size_t order>(llps::utilities::size_t_constant<order>) { dispatched = order; });
+    ASSERT_EQ(dispatched, 8);
+
+    ASSERT_THROW(llps::dispatch_fd_order(5, [](auto) {}), std::invalid_argument);
+    ASSERT_THROW(llps::dispatch_fd_order(16, [](auto) {}), std::invalid_argument);
+}
+
+TEST(tuning_tests, test_fd_laplacian_error)
+{
+    //The second order stencil's symbol is 2 cos(theta) - 2 = -theta^2 (1 - theta^2 / 12 + ...)
+    const double points = 64.;
+    const double theta = 2. * std::numbers::pi / points;
+    ASSERT_NEAR(llps::fd_laplacian_error(2, points), theta * theta / 12., 1e-3 * theta * theta / 12.);
+
+    //Higher orders are more accurate
+    for (size_t order = 2; order < 14; order += 2)
+        ASSERT_LT(llps::fd_laplacian_error(order + 2, 8.), llps::fd_laplacian_error(order, 8.));
+
+    //And converge as dx^order, while the leading term still dominates
+    for (size_t order = 2; order <= 8; order += 2)
+        ASSERT_NEAR(llps::fd_laplacian_error(order, 32.) / llps::fd_laplacian_error(order, 16.), std::pow(0.5, order), 0.1 * std::pow(0.5, order));
+}
+
+TEST(tuning_tests, test_profile_round_trip)
+{
+    const std::string path = "test_tuning_profile.txt";
+
+    llps::tuning_profile profile;
+    profile.set({ 1, 256, 256, 4, 0, 0, 2, 1e-8 });
+    profile.set({ 128, 128, 128, 8, 16, 0, 8, 2e-9 });
+    profile.set({ 1, 256, 256, 6, 16, 128, 1, 1e-8 });
+    profile.save(path);
+
+    const llps::tuning_profile loaded = llps::tuning_profile::load(path);
+    std::remove(path.c_str());
+
+    ASSERT_EQ(loaded.entries().size(), 2);
+
+    const llps::tuning_entry entry = loaded.find(256, 256);
+    ASSERT_EQ(entry.fd_order, 6);
+    ASSERT_EQ(entry.block_rows, 16);
+    ASSERT_EQ(entry.block_cols, 128);
+    ASSERT_EQ(entry.threads, 1);
+
+    const llps::tuning_entry entry3D = loaded.find(128, 128, 128);
+    ASSERT_EQ(entry3D.fd_order, 8);
+    ASSERT_EQ(entry3D.block_rows, 16);
+    ASSERT_EQ(entry3D.threads, 8);
+}
+
+TEST(tuning_tests, test_profile_find)
+{
+    llps::tuning_profile profile;
+    profile.set({ 1, 128, 128, 4 });
+    profile.set({ 1, 1024, 1024, 8 });
+
+    //Nearest in number of points, with the size asked for
+    const llps::tuning_entry entry = profile.find(256, 256);
+    ASSERT_EQ(entry.fd_order, 4);
+    ASSERT_EQ(entry.rows, 256);
+
+    ASSERT_EQ(profile.find(512, 1024).fd_order, 8);
+
+    //No 3D entries, and no profile at all, give the defaults
+    ASSERT_EQ(profile.find(64, 64, 64).fd_order, llps::default_fd_order);
+    ASSERT_EQ(llps::tuning_profile::load("no_such_profile.txt").find(256, 256).fd_order, llps::default_fd_order);
+
+    //Threads only where the environment chose none
+    llps::execution_config config;
+    llps::tuning_entry{ 1, 128, 128, 4, 0, 0, 3 }.apply(config);
+    ASSERT_EQ(config.threads, 3);
+
+    config.threads = 5;
+    llps::tuning_entry{ 1, 128, 128, 4, 0, 0, 3 }.apply(config);
+    ASSERT_EQ(config.threads, 5);
+}